@@ -0,0 +1,451 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "../Cabana_BenchmarkUtils.hpp"
+
+#include <Cabana_Core.hpp>
+#include <Cajita.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <mpi.h>
+
+using namespace Cajita;
+
+//---------------------------------------------------------------------------//
+// Write the iteration counts of a solver on rank 0 along with the average
+// solve time per iteration. This function does collective communication.
+void outputIterations( std::ostream& stream, const std::string& name,
+                       const std::vector<int>& grid_sizes_per_dim,
+                       const std::vector<int>& num_iter,
+                       const Cabana::Benchmark::Timer& solve_timer,
+                       MPI_Comm comm )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    if ( 0 == comm_rank )
+    {
+        stream << "\n";
+        stream << name << "\n";
+        stream << "num_rank grid_size_per_dim iterations ave_per_iteration"
+               << "\n";
+    }
+
+    for ( std::size_t n = 0; n < grid_sizes_per_dim.size(); ++n )
+    {
+        double local_sum = std::accumulate( solve_timer._data[n].begin(),
+                                            solve_timer._data[n].end(), 0.0 );
+        double average = 0.0;
+        MPI_Reduce( &local_sum, &average, 1, MPI_DOUBLE, MPI_SUM, 0, comm );
+        average /= solve_timer._data[n].size() * comm_size;
+
+        if ( 0 == comm_rank )
+            stream << comm_size << " " << grid_sizes_per_dim[n] << " "
+                   << num_iter[n] << " "
+                   << average / std::max( num_iter[n], 1 ) << "\n";
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Create the global grid of the Poisson problem with the given number of
+// cells per dimension.
+auto createProblemGrid( const int global_cells_per_dim, MPI_Comm comm )
+{
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    std::array<int, 3> global_num_cell = {
+        global_cells_per_dim, global_cells_per_dim, global_cells_per_dim };
+    std::array<double, 3> global_low_corner = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 1.0 };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid =
+        createGlobalGrid( comm, global_mesh, is_dim_periodic, partitioner );
+    return createLocalGrid( global_grid, 1 );
+}
+
+//---------------------------------------------------------------------------//
+// 7-point Laplacian stencil.
+std::vector<std::array<int, 3>> laplacianStencil()
+{
+    return { { 0, 0, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 },
+             { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+}
+
+//---------------------------------------------------------------------------//
+// Reference preconditioned conjugate gradient. Communication in the solver
+// is not instrumented so the cost of the halo gather and the scalar
+// allreduce it performs on every iteration are measured separately on the
+// same grid.
+template <class Device>
+void referenceTest( std::ostream& stream,
+                    const std::vector<int>& grid_sizes_per_dim, MPI_Comm comm,
+                    const std::string& test_prefix )
+{
+    using exec_space = typename Device::execution_space;
+
+    int num_grid_size_per_dim = grid_sizes_per_dim.size();
+
+    // number of runs in test loops
+    int num_runs = 5;
+
+    // create timers
+    std::string prefix = test_prefix + "reference_pcg_";
+    Cabana::Benchmark::Timer setup_timer( prefix + "setup",
+                                          num_grid_size_per_dim );
+    Cabana::Benchmark::Timer solve_timer( prefix + "solve",
+                                          num_grid_size_per_dim );
+    Cabana::Benchmark::Timer gather_timer( prefix + "halo_gather",
+                                           num_grid_size_per_dim );
+    Cabana::Benchmark::Timer allreduce_timer( prefix + "allreduce",
+                                              num_grid_size_per_dim );
+    std::vector<int> num_iter( num_grid_size_per_dim, 0 );
+
+    // loop over the grid sizes
+    for ( int p = 0; p < num_grid_size_per_dim; ++p )
+    {
+        auto local_grid = createProblemGrid( grid_sizes_per_dim[p], comm );
+        const auto& global_grid = local_grid->globalGrid();
+        auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+        auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+        int ncell_i = global_grid.globalNumEntity( Cell(), Dim::I );
+        int ncell_j = global_grid.globalNumEntity( Cell(), Dim::J );
+        int ncell_k = global_grid.globalNumEntity( Cell(), Dim::K );
+
+        auto vector_layout = createArrayLayout( local_grid, 1, Cell() );
+        auto rhs = createArray<double, Device>( "rhs", vector_layout );
+        ArrayOp::assign( *rhs, 1.0, Own() );
+        auto lhs = createArray<double, Device>( "lhs", vector_layout );
+
+        for ( int t = 0; t < num_runs; ++t )
+        {
+            setup_timer.start( p );
+
+            auto solver = createReferenceConjugateGradient<double, Device>(
+                *vector_layout );
+            solver->setMatrixStencil( laplacianStencil() );
+            auto matrix_view = solver->getMatrixValues().view();
+            Kokkos::parallel_for(
+                "fill_matrix_entries",
+                createExecutionPolicy( owned_space, exec_space() ),
+                KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                    int gi = i + global_space.min( Dim::I ) -
+                             owned_space.min( Dim::I );
+                    int gj = j + global_space.min( Dim::J ) -
+                             owned_space.min( Dim::J );
+                    int gk = k + global_space.min( Dim::K ) -
+                             owned_space.min( Dim::K );
+                    matrix_view( i, j, k, 0 ) = 6.0;
+                    matrix_view( i, j, k, 1 ) = ( gi > 0 ) ? -1.0 : 0.0;
+                    matrix_view( i, j, k, 2 ) =
+                        ( gi + 1 < ncell_i ) ? -1.0 : 0.0;
+                    matrix_view( i, j, k, 3 ) = ( gj > 0 ) ? -1.0 : 0.0;
+                    matrix_view( i, j, k, 4 ) =
+                        ( gj + 1 < ncell_j ) ? -1.0 : 0.0;
+                    matrix_view( i, j, k, 5 ) = ( gk > 0 ) ? -1.0 : 0.0;
+                    matrix_view( i, j, k, 6 ) =
+                        ( gk + 1 < ncell_k ) ? -1.0 : 0.0;
+                } );
+
+            std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+            solver->setPreconditionerStencil( diag_stencil );
+            auto preconditioner_view =
+                solver->getPreconditionerValues().view();
+            Kokkos::parallel_for(
+                "fill_preconditioner_entries",
+                createExecutionPolicy( owned_space, exec_space() ),
+                KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                    preconditioner_view( i, j, k, 0 ) = 1.0 / 6.0;
+                } );
+
+            solver->setTolerance( 1.0e-8 );
+            solver->setMaxIter( 10000 );
+            solver->setup();
+            Kokkos::fence();
+
+            setup_timer.stop( p );
+
+            ArrayOp::assign( *lhs, 0.0, Ghost() );
+
+            solve_timer.start( p );
+            solver->solve( *rhs, *lhs );
+            solve_timer.stop( p );
+
+            num_iter[p] = solver->getNumIter();
+        }
+
+        // Measure the communication performed on each iteration.
+        auto halo = createHalo( NodeHaloPattern<3>(), 1, *lhs );
+        double dot = 1.0;
+        for ( int t = 0; t < num_runs; ++t )
+        {
+            gather_timer.start( p );
+            halo->gather( exec_space(), *lhs );
+            gather_timer.stop( p );
+
+            allreduce_timer.start( p );
+            MPI_Allreduce( MPI_IN_PLACE, &dot, 1, MPI_DOUBLE, MPI_SUM, comm );
+            allreduce_timer.stop( p );
+        }
+    }
+
+    outputResults( stream, "grid_size_per_dim", grid_sizes_per_dim, setup_timer,
+                   comm );
+    outputResults( stream, "grid_size_per_dim", grid_sizes_per_dim, solve_timer,
+                   comm );
+    outputIterations( stream, prefix + "iterations", grid_sizes_per_dim,
+                      num_iter, solve_timer, comm );
+    outputResults( stream, "grid_size_per_dim", grid_sizes_per_dim,
+                   gather_timer, comm );
+    outputResults( stream, "grid_size_per_dim", grid_sizes_per_dim,
+                   allreduce_timer, comm );
+
+    stream << std::flush;
+}
+
+//---------------------------------------------------------------------------//
+// HYPRE preconditioned conjugate gradient with a multigrid preconditioner.
+#ifdef Cabana_ENABLE_HYPRE
+// Only run if HYPRE is compatible with the memory space.
+template <class Device>
+std::enable_if_t<
+    !HypreIsCompatibleWithMemorySpace<typename Device::memory_space>::value,
+    void>
+hypreTest( std::ostream&, const std::vector<int>&, MPI_Comm,
+           const std::string&, const std::string& )
+{
+}
+
+template <class Device>
+std::enable_if_t<
+    HypreIsCompatibleWithMemorySpace<typename Device::memory_space>::value,
+    void>
+hypreTest( std::ostream& stream, const std::vector<int>& grid_sizes_per_dim,
+           MPI_Comm comm, const std::string& test_prefix,
+           const std::string& precond_type )
+{
+    using exec_space = typename Device::execution_space;
+    using memory_space = typename Device::memory_space;
+
+    int num_grid_size_per_dim = grid_sizes_per_dim.size();
+
+    // number of runs in test loops
+    int num_runs = 5;
+
+    // create timers
+    std::string prefix = test_prefix + "hypre_pcg_" + precond_type + "_";
+    Cabana::Benchmark::Timer setup_timer( prefix + "setup",
+                                          num_grid_size_per_dim );
+    Cabana::Benchmark::Timer solve_timer( prefix + "solve",
+                                          num_grid_size_per_dim );
+    std::vector<int> num_iter( num_grid_size_per_dim, 0 );
+
+    // loop over the grid sizes
+    for ( int p = 0; p < num_grid_size_per_dim; ++p )
+    {
+        auto local_grid = createProblemGrid( grid_sizes_per_dim[p], comm );
+        auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+
+        auto vector_layout = createArrayLayout( local_grid, 1, Cell() );
+        auto rhs = createArray<double, Device>( "rhs", vector_layout );
+        ArrayOp::assign( *rhs, 1.0, Own() );
+        auto lhs = createArray<double, Device>( "lhs", vector_layout );
+
+        // HYPRE drops the entries that couple to cells outside the domain.
+        auto matrix_entry_layout = createArrayLayout( local_grid, 7, Cell() );
+        auto matrix_entries = createArray<double, Device>(
+            "matrix_entries", matrix_entry_layout );
+        auto entry_view = matrix_entries->view();
+        Kokkos::parallel_for(
+            "fill_matrix_entries",
+            createExecutionPolicy( owned_space, exec_space() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                entry_view( i, j, k, 0 ) = 6.0;
+                for ( int n = 1; n < 7; ++n )
+                    entry_view( i, j, k, n ) = -1.0;
+            } );
+
+        for ( int t = 0; t < num_runs; ++t )
+        {
+            setup_timer.start( p );
+
+            auto solver = createHypreStructuredSolver<double, memory_space>(
+                "PCG", *vector_layout );
+            solver->setMatrixStencil( laplacianStencil() );
+            solver->setMatrixValues( *matrix_entries );
+            solver->setTolerance( 1.0e-8 );
+            solver->setMaxIter( 10000 );
+            auto preconditioner =
+                createHypreStructuredSolver<double, memory_space>(
+                    precond_type, *vector_layout, true );
+            solver->setPreconditioner( preconditioner );
+            solver->setup();
+
+            setup_timer.stop( p );
+
+            ArrayOp::assign( *lhs, 0.0, Ghost() );
+
+            solve_timer.start( p );
+            solver->solve( *rhs, *lhs );
+            solve_timer.stop( p );
+
+            num_iter[p] = solver->getNumIter();
+        }
+    }
+
+    outputResults( stream, "grid_size_per_dim", grid_sizes_per_dim, setup_timer,
+                   comm );
+    outputResults( stream, "grid_size_per_dim", grid_sizes_per_dim, solve_timer,
+                   comm );
+    outputIterations( stream, prefix + "iterations", grid_sizes_per_dim,
+                      num_iter, solve_timer, comm );
+
+    stream << std::flush;
+}
+#endif
+
+//---------------------------------------------------------------------------//
+// Performance test.
+template <class Device>
+void performanceTest( std::ostream& stream,
+                      const std::vector<int>& grid_sizes_per_dim,
+                      MPI_Comm comm, const std::string& test_prefix )
+{
+    referenceTest<Device>( stream, grid_sizes_per_dim, comm, test_prefix );
+#ifdef Cabana_ENABLE_HYPRE
+    hypreTest<Device>( stream, grid_sizes_per_dim, comm, test_prefix, "PFMG" );
+    hypreTest<Device>( stream, grid_sizes_per_dim, comm, test_prefix, "SMG" );
+#endif
+}
+
+//---------------------------------------------------------------------------//
+// main
+int main( int argc, char* argv[] )
+{
+    // Initialize environment
+    MPI_Init( &argc, &argv );
+    Kokkos::initialize( argc, argv );
+
+    // Check arguments.
+    if ( argc < 2 )
+        throw std::runtime_error( "Incorrect number of arguments. \n \
+             First argument - file name for output \n \
+             Optional second argument - problem size (small or large) \n \
+             \n \
+             Example: \n \
+             $/: ./StructuredSolverPerformance test_results.txt\n" );
+
+    // Define run sizes.
+    std::string run_type = "";
+    if ( argc > 2 )
+    {
+        run_type = argv[2];
+    }
+
+    // Declare the grid size per dimension
+    std::vector<int> grid_sizes_per_dim = { 16, 32 };
+    if ( run_type == "large" )
+    {
+        grid_sizes_per_dim = { 16, 32, 64, 128 };
+    }
+
+    // Get the name of the output file.
+    std::string filename = argv[1];
+
+    // Barrier before continuing
+    MPI_Barrier( MPI_COMM_WORLD );
+
+    // Get comm rank and size;
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+
+    // Sweep the number of ranks in powers of two up to the full
+    // communicator.
+    std::vector<int> num_ranks;
+    for ( int n = 1; n < comm_size; n *= 2 )
+        num_ranks.push_back( n );
+    num_ranks.push_back( comm_size );
+
+    // Open the output file on rank 0.
+    std::fstream file;
+    if ( 0 == comm_rank )
+        file.open( filename, std::fstream::out );
+
+    // Output file header
+    if ( 0 == comm_rank )
+    {
+        file << "\n";
+        file << "Cajita Structured Solver Performance Benchmark"
+             << "\n";
+        file << "----------------------------------------------"
+             << "\n";
+        file << "MPI Ranks: " << comm_size << "\n";
+        file << "Reference PCG: one halo_gather of each of the matrix and "
+             << "preconditioner halos and two allreduce per iteration\n";
+        file << "----------------------------------------------"
+             << "\n";
+        file << std::flush;
+    }
+
+    // Do everything on the default CPU.
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_device_type = host_exec_space::device_type;
+    // Do everything on the default device with default memory.
+    using exec_space = Kokkos::DefaultExecutionSpace;
+    using device_type = exec_space::device_type;
+
+    for ( auto n : num_ranks )
+    {
+        // Run on the first n ranks.
+        MPI_Comm comm;
+        MPI_Comm_split( MPI_COMM_WORLD, ( comm_rank < n ) ? 0 : MPI_UNDEFINED,
+                        comm_rank, &comm );
+        if ( MPI_COMM_NULL != comm )
+        {
+            // Don't run twice on the CPU if only host enabled.
+            if ( !std::is_same<device_type, host_device_type>{} )
+            {
+                performanceTest<device_type>( file, grid_sizes_per_dim, comm,
+                                              "device_" );
+            }
+            performanceTest<host_device_type>( file, grid_sizes_per_dim, comm,
+                                               "host_" );
+            MPI_Comm_free( &comm );
+        }
+        MPI_Barrier( MPI_COMM_WORLD );
+    }
+
+    // Close the output file on rank 0.
+    file.close();
+
+    // Finalize
+    Kokkos::finalize();
+    MPI_Finalize();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
@@ -20,6 +20,7 @@
 
 #include <Cajita_Array.hpp>
 #include <Cajita_BovWriter.hpp>
+#include <Cajita_GeometricMultigrid.hpp>
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
 #include <Cajita_Halo.hpp>
@@ -29,16 +30,20 @@
 #include <Cajita_LocalGrid.hpp>
 #include <Cajita_LocalMesh.hpp>
 #include <Cajita_ManualPartitioner.hpp>
+#include <Cajita_MixedPrecisionRefinement.hpp>
 #include <Cajita_MpiTraits.hpp>
 #include <Cajita_Parallel.hpp>
 #include <Cajita_ParticleGridDistributor.hpp>
+#include <Cajita_ParticleGridHalo.hpp>
 #include <Cajita_ParticleList.hpp>
 #include <Cajita_Partitioner.hpp>
 #include <Cajita_ReferenceStructuredSolver.hpp>
 #ifndef KOKKOS_ENABLE_SYCL // FIXME_SYCL
 #include <Cajita_SparseArray.hpp>
 #include <Cajita_SparseDimPartitioner.hpp>
+#include <Cajita_SparseHalo.hpp>
 #include <Cajita_SparseIndexSpace.hpp>
+#include <Cajita_SparseInterpolation.hpp>
 #include <Cajita_SparseLocalGrid.hpp>
 #endif
 #include <Cajita_Splines.hpp>
@@ -50,6 +55,7 @@
 #endif
 
 #ifdef Cabana_ENABLE_HEFFTE
+#include <Cajita_FFTPoissonSolver.hpp>
 #include <Cajita_FastFourierTransform.hpp>
 #endif
 
@@ -0,0 +1,313 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_FFTPoissonSolver.hpp
+  \brief Spectral Poisson solver
+*/
+#ifndef CAJITA_FFTPOISSONSOLVER_HPP
+#define CAJITA_FFTPOISSONSOLVER_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_FastFourierTransform.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_Parallel.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Cajita
+{
+namespace Experimental
+{
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Compute the inverse symbol of the negative Laplacian at each entity of
+// the half-spectrum owned by a rank. The zero mode is set to zero.
+template <class SymbolView, std::size_t NumSpaceDim>
+struct FFTPoissonSymbol
+{
+    using value_type = typename SymbolView::value_type;
+
+    SymbolView symbol;
+    Kokkos::Array<long, NumSpaceDim> spectral_min;
+    Kokkos::Array<long, NumSpaceDim> num_entity;
+    Kokkos::Array<value_type, NumSpaceDim> cell_size;
+    bool finite_difference;
+    value_type scale;
+
+    // Squared wavenumber of a global spectral index in a dimension. The
+    // finite difference variant gives the eigenvalues of the second-order
+    // central difference Laplacian.
+    KOKKOS_INLINE_FUNCTION value_type wavenumberSquared( const int d,
+                                                         const long m ) const
+    {
+        const value_type pi = 3.14159265358979323846;
+        const long n = num_entity[d];
+        value_type k;
+        if ( finite_difference )
+            k = 2.0 * sin( pi * m / n ) / cell_size[d];
+        else
+            k = 2.0 * pi * ( ( 2 * m > n ) ? m - n : m ) /
+                ( n * cell_size[d] );
+        return k * k;
+    }
+
+    KOKKOS_INLINE_FUNCTION value_type inverse( const value_type k2 ) const
+    {
+        return ( k2 > 0.0 ) ? scale / k2 : 0.0;
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k ) const
+    {
+        symbol( i, j, k ) =
+            inverse( wavenumberSquared( Dim::I, i + spectral_min[Dim::I] ) +
+                     wavenumberSquared( Dim::J, j + spectral_min[Dim::J] ) +
+                     wavenumberSquared( Dim::K, k + spectral_min[Dim::K] ) );
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j ) const
+    {
+        symbol( i, j ) =
+            inverse( wavenumberSquared( Dim::I, i + spectral_min[Dim::I] ) +
+                     wavenumberSquared( Dim::J, j + spectral_min[Dim::J] ) );
+    }
+};
+
+// Scale the half-spectrum by the inverse symbol.
+template <class SpectralView, class SymbolView>
+struct FFTPoissonScale
+{
+    SpectralView spectrum;
+    SymbolView symbol;
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k ) const
+    {
+        auto s = symbol( i, j, k );
+        spectrum( i, j, k, 0 ) *= s;
+        spectrum( i, j, k, 1 ) *= s;
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j ) const
+    {
+        auto s = symbol( i, j );
+        spectrum( i, j, 0 ) *= s;
+        spectrum( i, j, 1 ) *= s;
+    }
+};
+//! \endcond
+} // namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Spectral Poisson solver on periodic uniform grids.
+
+  Solves -Laplacian(x) = b with a real-to-complex transform of b, a single
+  kernel scaling the half-spectrum by the inverse symbol of the Laplacian,
+  and a complex-to-real transform back to x. The inverse symbol, including
+  the normalization of the transforms, is computed once at construction.
+  The mean of b is projected out and x has zero mean.
+
+  By default the symbol of the continuous Laplacian is used (spectral
+  accuracy). The symbol of the second-order central difference Laplacian
+  may be used instead to match finite difference discretizations.
+*/
+template <class EntityType, class MeshType, class Scalar, class DeviceType,
+          class BackendType>
+class FFTPoissonSolver
+{
+  public:
+    //! Array entity type.
+    using entity_type = EntityType;
+    //! Mesh type.
+    using mesh_type = MeshType;
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Kokkos execution space.
+    using exec_space = typename device_type::execution_space;
+    //! Real-to-complex transform type.
+    using fft_type = HeffteRealFastFourierTransform<EntityType, MeshType,
+                                                    Scalar, DeviceType,
+                                                    BackendType>;
+
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = mesh_type::num_space_dim;
+
+    static_assert( isUniformMesh<MeshType>::value,
+                   "FFT Poisson solver requires a uniform mesh" );
+
+    /*!
+      \brief Constructor
+      \param layout The array layout of the scalar fields of the problem.
+      \param params Parameters for the FFT.
+    */
+    FFTPoissonSolver( const ArrayLayout<EntityType, MeshType>& layout,
+                      const FastFourierTransformParams& params )
+        : _finite_difference( false )
+    {
+        const auto& global_grid = layout.localGrid()->globalGrid();
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            if ( !global_grid.isPeriodic( d ) )
+                throw std::logic_error(
+                    "FFT Poisson solver requires periodic boundaries" );
+            _num_entity[d] = global_grid.globalNumEntity( EntityType(), d );
+            _cell_size[d] = global_grid.globalMesh().cellSize( d );
+        }
+
+        _fft = std::make_shared<fft_type>( layout, params );
+        _spectrum = _fft->createSpectralView( "poisson_spectrum" );
+        _symbol = createView<Scalar, Kokkos::LayoutRight, DeviceType>(
+            "poisson_symbol", _fft->spectralIndexSpace( Local() ) );
+        computeSymbol();
+    }
+
+    /*!
+      \brief Use the symbol of the second-order central difference
+      Laplacian.
+      \param finite_difference If true use the finite difference symbol
+      instead of the continuous symbol.
+    */
+    void setFiniteDifferenceLaplacian( const bool finite_difference )
+    {
+        _finite_difference = finite_difference;
+        computeSymbol();
+    }
+
+    /*!
+      \brief Solve the problem -Laplacian(x) = b for x.
+      \param b The forcing term.
+      \param x The solution.
+    */
+    template <class Array_t>
+    void solve( const Array_t& b, Array_t& x )
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::FFTPoissonSolver::solve" );
+
+        _fft->forward( b, _spectrum, FFTScaleNone() );
+        grid_parallel_for(
+            "fft_poisson_scale", exec_space(),
+            _fft->spectralIndexSpace( Local() ),
+            Impl::FFTPoissonScale<typename fft_type::spectral_view_type,
+                                  decltype( _symbol )>{ _spectrum,
+                                                        _symbol } );
+        _fft->reverse( _spectrum, x, FFTScaleNone() );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    //! Get the real-to-complex transform of the solver.
+    std::shared_ptr<fft_type> fft() const { return _fft; }
+
+  private:
+    // Compute the inverse symbol of the half-spectrum owned by this rank.
+    // The unnormalized forward and reverse transforms scale by the total
+    // number of entities which is folded into the symbol.
+    void computeSymbol()
+    {
+        using symbol_type =
+            Impl::FFTPoissonSymbol<decltype( _symbol ), num_space_dim>;
+        symbol_type functor;
+        functor.symbol = _symbol;
+        auto spectral_space = _fft->spectralIndexSpace( Global() );
+        Scalar num_total = 1.0;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            functor.spectral_min[d] = spectral_space.min( d );
+            functor.num_entity[d] = _num_entity[d];
+            functor.cell_size[d] = _cell_size[d];
+            num_total *= _num_entity[d];
+        }
+        functor.finite_difference = _finite_difference;
+        functor.scale = 1.0 / num_total;
+        grid_parallel_for( "fft_poisson_symbol", exec_space(),
+                           _fft->spectralIndexSpace( Local() ), functor );
+    }
+
+  private:
+    std::shared_ptr<fft_type> _fft;
+    bool _finite_difference;
+    std::array<long, num_space_dim> _num_entity;
+    std::array<Scalar, num_space_dim> _cell_size;
+    typename fft_type::spectral_view_type _spectrum;
+    std::conditional_t<
+        3 == num_space_dim,
+        Kokkos::View<Scalar***, Kokkos::LayoutRight, DeviceType>,
+        Kokkos::View<Scalar**, Kokkos::LayoutRight, DeviceType>>
+        _symbol;
+};
+
+//---------------------------------------------------------------------------//
+// Creation functions
+//---------------------------------------------------------------------------//
+//! Creation function for the FFT Poisson solver with explicit FFT backend.
+//! \param layout Array layout of the scalar fields of the problem
+//! \param params FFT parameters
+template <class Scalar, class DeviceType, class BackendType, class EntityType,
+          class MeshType>
+auto createFFTPoissonSolver( const ArrayLayout<EntityType, MeshType>& layout,
+                             const FastFourierTransformParams& params )
+{
+    return std::make_shared<FFTPoissonSolver<EntityType, MeshType, Scalar,
+                                             DeviceType, BackendType>>(
+        layout, params );
+}
+
+//! Creation function for the FFT Poisson solver with default FFT backend.
+//! \param layout Array layout of the scalar fields of the problem
+//! \param params FFT parameters
+template <class Scalar, class DeviceType, class EntityType, class MeshType>
+auto createFFTPoissonSolver( const ArrayLayout<EntityType, MeshType>& layout,
+                             const FastFourierTransformParams& params )
+{
+    return createFFTPoissonSolver<Scalar, DeviceType, Impl::FFTBackendDefault,
+                                  EntityType, MeshType>( layout, params );
+}
+
+//! Creation function for the FFT Poisson solver with default FFT backend
+//! and default parameters.
+//! \param layout Array layout of the scalar fields of the problem
+template <class Scalar, class DeviceType, class EntityType, class MeshType>
+auto createFFTPoissonSolver( const ArrayLayout<EntityType, MeshType>& layout )
+{
+    using exec_space = typename DeviceType::execution_space;
+    using heffte_backend_type = typename Impl::HeffteBackendTraits<
+        exec_space, Impl::FFTBackendDefault>::backend_type;
+
+    // use default heFFTe params for this backend
+    const heffte::plan_options heffte_params =
+        heffte::default_options<heffte_backend_type>();
+    FastFourierTransformParams params;
+    params.setAllToAll( heffte_params.use_alltoall );
+    params.setPencils( heffte_params.use_pencils );
+    params.setReorder( heffte_params.use_reorder );
+
+    return createFFTPoissonSolver<Scalar, DeviceType>( layout, params );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Experimental
+} // end namespace Cajita
+
+#endif // end CAJITA_FFTPOISSONSOLVER_HPP
@@ -25,7 +25,9 @@
 
 #include <array>
 #include <memory>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 namespace Cajita
 {
@@ -251,6 +253,62 @@ class FastFourierTransform
         Kokkos::Profiling::popRegion();
     }
 
+    /*!
+      \brief Do a batched forward FFT of several arrays.
+
+      All arrays are transformed together which amortizes the communication
+      of the transform over the batch.
+
+      \param x The arrays on which to perform the forward transform.
+      \param scaling Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void forward(
+        const std::vector<std::shared_ptr<Array_t>>& x,
+        const ScaleType scaling,
+        typename std::enable_if<
+            ( is_array<Array_t>::value &&
+              is_matching_array<
+                  typename Array_t::entity_type, typename Array_t::mesh_type,
+                  typename Array_t::device_type, typename Array_t::value_type,
+                  entity_type, mesh_type, device_type, value_type>::value ),
+            int>::type* = 0 )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::FFT::forward" );
+
+        for ( const auto& a : x )
+            checkArrayDofs( a->layout()->dofsPerEntity() );
+        static_cast<Derived*>( this )->forwardImpl( x, scaling );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Do a batched reverse FFT of several arrays.
+      \param x The arrays on which to perform the reverse transform.
+      \param scaling Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void reverse(
+        const std::vector<std::shared_ptr<Array_t>>& x,
+        const ScaleType scaling,
+        typename std::enable_if<
+            ( is_array<Array_t>::value &&
+              is_matching_array<
+                  typename Array_t::entity_type, typename Array_t::mesh_type,
+                  typename Array_t::device_type, typename Array_t::value_type,
+                  entity_type, mesh_type, device_type, value_type>::value ),
+            int>::type* = 0 )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::FFT::reverse" );
+
+        for ( const auto& a : x )
+            checkArrayDofs( a->layout()->dofsPerEntity() );
+        static_cast<Derived*>( this )->reverseImpl( x, scaling );
+
+        Kokkos::Profiling::popRegion();
+    }
+
     /*!
       \brief Copy owned data for FFT.
     */
@@ -470,21 +528,19 @@ class HeffteFastFourierTransform
             inbox, outbox, layout.localGrid()->globalGrid().comm(),
             heffte_params );
 
-        int fftsize = std::max( _fft->size_outbox(), _fft->size_inbox() );
+        _fft_size = std::max( _fft->size_outbox(), _fft->size_inbox() );
 
         // Check the size.
         auto entity_space =
             layout.localGrid()->indexSpace( Own(), EntityType(), Local() );
-        if ( fftsize < (int)entity_space.size() )
+        if ( _fft_size < (int)entity_space.size() )
             throw std::logic_error( "Expected FFT allocation size smaller "
                                     "than local grid size" );
 
-        _fft_work = Kokkos::View<Scalar*, DeviceType>(
-            Kokkos::ViewAllocateWithoutInitializing( "fft_work" ),
-            2 * fftsize );
-        _workspace = Kokkos::View<Scalar* [2], DeviceType>(
-            Kokkos::ViewAllocateWithoutInitializing( "workspace" ),
-            4 * fftsize );
+        // The work buffers persist over transforms and grow with the batch
+        // size.
+        _batch_capacity = 0;
+        reserveBatch( 1 );
     }
 
     /*!
@@ -509,6 +565,30 @@ class HeffteFastFourierTransform
         compute( x, -1, Impl::HeffteScalingTraits<ScaleType>().scaling_type );
     }
 
+    /*!
+      \brief Do a batched forward FFT.
+      \param x The arrays on which to perform the forward transform.
+      \param ScaleType Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void forwardImpl( const std::vector<std::shared_ptr<Array_t>>& x,
+                      const ScaleType )
+    {
+        compute( x, 1, Impl::HeffteScalingTraits<ScaleType>().scaling_type );
+    }
+
+    /*!
+     \brief Do a batched reverse FFT.
+     \param x The arrays on which to perform the reverse transform
+     \param ScaleType Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void reverseImpl( const std::vector<std::shared_ptr<Array_t>>& x,
+                      const ScaleType )
+    {
+        compute( x, -1, Impl::HeffteScalingTraits<ScaleType>().scaling_type );
+    }
+
     /*!
      \brief Do the FFT.
      \param x The array on which to perform the transform.
@@ -518,6 +598,16 @@ class HeffteFastFourierTransform
     template <class Array_t>
     void compute( const Array_t& x, const int flag, const heffte::scale scale )
     {
+        // If the owned data is already in the heFFTe layout (e.g. an array
+        // without halo) transform it in place.
+        auto owned_view =
+            createSubview( x.view(), x.layout()->indexSpace( Own(), Local() ) );
+        if ( isContiguousLayoutRight( owned_view ) )
+        {
+            execute( owned_view.data(), 1, flag, scale );
+            return;
+        }
+
         // Create a subview of the work array to write the local data into.
         auto own_space =
             x.layout()->localGrid()->indexSpace( Own(), EntityType(), Local() );
@@ -525,41 +615,116 @@ class HeffteFastFourierTransform
         auto local_view = createView<Scalar, Kokkos::LayoutRight, DeviceType>(
             local_view_space, _fft_work.data() );
 
-        // TODO: pull this out to template function
         // Copy to the work array. The work array only contains owned data.
         auto localghost_view = x.view();
-
         this->copyToLocal( own_space, local_view, localghost_view );
 
-        if ( flag == 1 )
+        execute( _fft_work.data(), 1, flag, scale );
+
+        // Copy back to output array.
+        this->copyFromLocal( own_space, local_view, localghost_view );
+    }
+
+    /*!
+     \brief Do a batched FFT.
+     \param x The arrays on which to perform the transform.
+     \param flag Flag for forward or reverse.
+     \param scale Method of scaling data.
+    */
+    template <class Array_t>
+    void compute( const std::vector<std::shared_ptr<Array_t>>& x,
+                  const int flag, const heffte::scale scale )
+    {
+        const int batch_size = x.size();
+        if ( 0 == batch_size )
+            return;
+        reserveBatch( batch_size );
+
+        // Copy each array into its own block of the work array. The blocks
+        // are spaced by the size of the transform.
+        auto own_space = x[0]->layout()->localGrid()->indexSpace(
+            Own(), EntityType(), Local() );
+        auto local_view_space = appendDimension( own_space, 2 );
+        for ( int b = 0; b < batch_size; ++b )
         {
-            _fft->forward(
-                reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
-                reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
-                reinterpret_cast<std::complex<Scalar>*>( _workspace.data() ),
-                scale );
+            auto local_view =
+                createView<Scalar, Kokkos::LayoutRight, DeviceType>(
+                    local_view_space, _fft_work.data() + 2 * b * _fft_size );
+            auto localghost_view = x[b]->view();
+            this->copyToLocal( own_space, local_view, localghost_view );
         }
-        else if ( flag == -1 )
+
+        execute( _fft_work.data(), batch_size, flag, scale );
+
+        // Copy back to the output arrays.
+        for ( int b = 0; b < batch_size; ++b )
         {
-            _fft->backward(
-                reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
-                reinterpret_cast<std::complex<Scalar>*>( _fft_work.data() ),
-                reinterpret_cast<std::complex<Scalar>*>( _workspace.data() ),
-                scale );
+            auto local_view =
+                createView<Scalar, Kokkos::LayoutRight, DeviceType>(
+                    local_view_space, _fft_work.data() + 2 * b * _fft_size );
+            auto localghost_view = x[b]->view();
+            this->copyFromLocal( own_space, local_view, localghost_view );
         }
-        else
-        {
+    }
+
+  private:
+    // Grow the work buffers to hold a batch of transforms.
+    void reserveBatch( const int batch_size )
+    {
+        if ( batch_size <= _batch_capacity )
+            return;
+        _fft_work = Kokkos::View<Scalar*, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "fft_work" ),
+            2 * _fft_size * batch_size );
+        _workspace = Kokkos::View<Scalar* [2], DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "workspace" ),
+            4 * _fft_size * batch_size );
+        _batch_capacity = batch_size;
+    }
+
+    // Transform data in place. A batch of transforms is stored one after
+    // another spaced by the size of the transform.
+    void execute( Scalar* data, const int batch_size, const int flag,
+                  const heffte::scale scale )
+    {
+        if ( flag != 1 && flag != -1 )
             throw std::logic_error(
                 "Only 1:forward and -1:backward are allowed as compute flag" );
+
+        auto values = reinterpret_cast<std::complex<Scalar>*>( data );
+        auto workspace =
+            reinterpret_cast<std::complex<Scalar>*>( _workspace.data() );
+
+#if Heffte_VERSION_MAJOR > 2 ||                                               \
+    ( Heffte_VERSION_MAJOR == 2 && Heffte_VERSION_MINOR >= 2 )
+        if ( batch_size > 1 )
+        {
+            if ( flag == 1 )
+                _fft->forward( batch_size, values, values, workspace, scale );
+            else
+                _fft->backward( batch_size, values, values, workspace,
+                                scale );
+            return;
         }
+#endif
 
-        // Copy back to output array.
-        this->copyFromLocal( own_space, local_view, localghost_view );
+        // Transform each member of the batch in turn. heFFTe versions before
+        // 2.2 do not provide batched transforms.
+        for ( int b = 0; b < batch_size; ++b )
+        {
+            auto batch_values = values + b * _fft_size;
+            if ( flag == 1 )
+                _fft->forward( batch_values, batch_values, workspace, scale );
+            else
+                _fft->backward( batch_values, batch_values, workspace, scale );
+        }
     }
 
   private:
     // heFFTe correctly handles 2D or 3D FFTs within "fft3d"
     std::shared_ptr<heffte::fft3d<heffte_backend_type>> _fft;
+    int _fft_size;
+    int _batch_capacity;
     Kokkos::View<Scalar*, DeviceType> _fft_work;
     Kokkos::View<Scalar* [2], DeviceType> _workspace;
 };
@@ -634,6 +799,350 @@ auto createHeffteFastFourierTransform(
         layout );
 }
 
+//---------------------------------------------------------------------------//
+// heFFTe real-to-complex
+//---------------------------------------------------------------------------//
+/*!
+  \brief Real-to-complex interface to the heFFTe fast Fourier transform
+  library.
+
+  The forward transform of a real field is stored as the half-spectrum of
+  the last dimension (k in 3D, j in 2D) which has n/2+1 of its n complex
+  entries. The other half follows from conjugate symmetry. Compared to a
+  complex transform of the same field this halves the memory, work, and
+  communication.
+
+  The half-spectrum is partitioned over the same ranks as the real field.
+  Each rank owns a spectral index space given by spectralIndexSpace() and
+  stores it in a spectral view with the complex real and imaginary parts in
+  the last dimension (see createSpectralView()).
+*/
+template <class EntityType, class MeshType, class Scalar, class DeviceType,
+          class BackendType>
+class HeffteRealFastFourierTransform
+{
+  public:
+    //! Array entity type.
+    using entity_type = EntityType;
+    //! Mesh type.
+    using mesh_type = MeshType;
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! FFT backend type.
+    using backend_type = BackendType;
+    //! Kokkos execution space.
+    using exec_space = typename device_type::execution_space;
+
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = mesh_type::num_space_dim;
+
+    //! heFFTe backend type.
+    using heffte_backend_type =
+        typename Impl::HeffteBackendTraits<exec_space,
+                                           backend_type>::backend_type;
+
+    //! Spectral view type.
+    using spectral_view_type = std::conditional_t<
+        3 == num_space_dim,
+        Kokkos::View<Scalar****, Kokkos::LayoutRight, DeviceType>,
+        Kokkos::View<Scalar***, Kokkos::LayoutRight, DeviceType>>;
+
+    /*!
+      \brief Constructor
+      \param layout The array layout defining the real vector space of the
+      transform.
+      \param params Parameters for the FFT.
+    */
+    HeffteRealFastFourierTransform(
+        const ArrayLayout<EntityType, MeshType>& layout,
+        const FastFourierTransformParams& params )
+    {
+        if ( 1 != layout.dofsPerEntity() )
+            throw std::logic_error(
+                "Only 1 real value per entity allowed in real FFT" );
+
+        // Get the local dimensions of the problem.
+        auto entity_space =
+            layout.localGrid()->indexSpace( Own(), EntityType(), Local() );
+        const auto& global_grid = layout.localGrid()->globalGrid();
+
+        // Compose the real and spectral boxes of this rank. heFFTe orders
+        // the dimensions fastest first. The last dimension is halved in the
+        // spectrum by partitioning the n/2+1 spectral entries proportionally
+        // to the n real entries so the boxes of all ranks tile the spectrum.
+        std::array<int, num_space_dim> in_low;
+        std::array<int, num_space_dim> in_high;
+        std::array<int, num_space_dim> out_low;
+        std::array<int, num_space_dim> out_high;
+        std::array<long, num_space_dim> spectral_min;
+        std::array<long, num_space_dim> spectral_max;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            int offset = global_grid.globalOffset( d );
+            int count = entity_space.extent( d );
+            spectral_min[d] = offset;
+            spectral_max[d] = offset + count;
+            if ( num_space_dim - 1 == d )
+            {
+                long n = global_grid.globalNumEntity( EntityType(), d );
+                long m = n / 2 + 1;
+                spectral_min[d] = offset * m / n;
+                spectral_max[d] = ( offset + count ) * m / n;
+            }
+
+            std::size_t hd = num_space_dim - d - 1;
+            in_low[hd] = offset;
+            in_high[hd] = offset + count - 1;
+            out_low[hd] = spectral_min[d];
+            out_high[hd] = spectral_max[d] - 1;
+        }
+        _spectral_space =
+            IndexSpace<num_space_dim>( spectral_min, spectral_max );
+
+        // heFFTe correctly handles 2D or 3D domains within "box3d"
+        heffte::box3d<> inbox = { in_low, in_high };
+        heffte::box3d<> outbox = { out_low, out_high };
+
+        heffte::plan_options heffte_params =
+            heffte::default_options<heffte_backend_type>();
+        heffte_params.use_alltoall = params.getAllToAll();
+        heffte_params.use_pencils = params.getPencils();
+        heffte_params.use_reorder = params.getReorder();
+
+        // The real-to-complex direction is the fastest heFFTe dimension.
+        _fft = std::make_shared<heffte::fft3d_r2c<heffte_backend_type>>(
+            inbox, outbox, 0, global_grid.comm(), heffte_params );
+
+        _real_work = Kokkos::View<Scalar*, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "fft_real_work" ),
+            _fft->size_inbox() );
+        _workspace = Kokkos::View<Scalar* [2], DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "workspace" ),
+            _fft->size_workspace() );
+    }
+
+    /*!
+      \brief Get the spectral index space owned by this rank.
+      \return The index space of the half-spectrum owned by this rank in
+      global spectral indices.
+    */
+    IndexSpace<num_space_dim> spectralIndexSpace( Global ) const
+    {
+        return _spectral_space;
+    }
+
+    /*!
+      \brief Get the spectral index space owned by this rank.
+      \return The index space of the half-spectrum owned by this rank in
+      local indices of a spectral view.
+    */
+    IndexSpace<num_space_dim> spectralIndexSpace( Local ) const
+    {
+        std::array<long, num_space_dim> size;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            size[d] = _spectral_space.extent( d );
+        return IndexSpace<num_space_dim>( size );
+    }
+
+    /*!
+      \brief Create a view of the half-spectrum owned by this rank.
+      \param label The label of the view.
+      \return A view over the local spectral index space with the real and
+      imaginary parts in the last dimension.
+    */
+    spectral_view_type createSpectralView( const std::string& label ) const
+    {
+        return createView<Scalar, Kokkos::LayoutRight, DeviceType>(
+            label, appendDimension( spectralIndexSpace( Local() ), 2 ) );
+    }
+
+    /*!
+      \brief Do a forward real-to-complex FFT.
+      \param x The real array to transform.
+      \param spectrum The spectral view in which to store the half-spectrum.
+      \param ScaleType Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void forward(
+        const Array_t& x, const spectral_view_type& spectrum, const ScaleType,
+        typename std::enable_if<
+            ( is_array<Array_t>::value &&
+              is_matching_array<
+                  typename Array_t::entity_type, typename Array_t::mesh_type,
+                  typename Array_t::device_type, typename Array_t::value_type,
+                  entity_type, mesh_type, device_type, value_type>::value ),
+            int>::type* = 0 )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::FFT::forward" );
+
+        checkSpectrum( spectrum );
+        Scalar* real_data = stageReal( x, true );
+        _fft->forward(
+            real_data,
+            reinterpret_cast<std::complex<Scalar>*>( spectrum.data() ),
+            reinterpret_cast<std::complex<Scalar>*>( _workspace.data() ),
+            Impl::HeffteScalingTraits<ScaleType>().scaling_type );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Do a reverse complex-to-real FFT.
+      \param spectrum The spectral view holding the half-spectrum.
+      \param x The real array in which to store the result.
+      \param ScaleType Method of scaling data.
+    */
+    template <class Array_t, class ScaleType>
+    void reverse(
+        const spectral_view_type& spectrum, const Array_t& x, const ScaleType,
+        typename std::enable_if<
+            ( is_array<Array_t>::value &&
+              is_matching_array<
+                  typename Array_t::entity_type, typename Array_t::mesh_type,
+                  typename Array_t::device_type, typename Array_t::value_type,
+                  entity_type, mesh_type, device_type, value_type>::value ),
+            int>::type* = 0 )
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::FFT::reverse" );
+
+        checkSpectrum( spectrum );
+        Scalar* real_data = stageReal( x, false );
+        _fft->backward(
+            reinterpret_cast<std::complex<Scalar>*>( spectrum.data() ),
+            real_data,
+            reinterpret_cast<std::complex<Scalar>*>( _workspace.data() ),
+            Impl::HeffteScalingTraits<ScaleType>().scaling_type );
+
+        // Copy back to the output array if it was staged.
+        if ( real_data == _real_work.data() )
+            Kokkos::deep_copy( ownedView( x ), workView( x ) );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+  private:
+    // Check the size of a spectral view.
+    void checkSpectrum( const spectral_view_type& spectrum ) const
+    {
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            if ( spectrum.extent( d ) !=
+                 static_cast<std::size_t>( _spectral_space.extent( d ) ) )
+                throw std::logic_error(
+                    "Spectral view does not match FFT spectral space" );
+    }
+
+    // Get the owned values of an array.
+    template <class Array_t>
+    auto ownedView( const Array_t& x ) const
+    {
+        if ( 1 != x.layout()->dofsPerEntity() )
+            throw std::logic_error(
+                "Only 1 real value per entity allowed in real FFT" );
+        return createSubview( x.view(),
+                              x.layout()->indexSpace( Own(), Local() ) );
+    }
+
+    // Get a view of the real work array with the owned shape of an array.
+    template <class Array_t>
+    auto workView( const Array_t& x ) const
+    {
+        auto own_space =
+            x.layout()->localGrid()->indexSpace( Own(), EntityType(), Local() );
+        return createView<Scalar, Kokkos::LayoutRight, DeviceType>(
+            appendDimension( own_space, 1 ), _real_work.data() );
+    }
+
+    // Get the real data of an array in the heFFTe layout. If the owned data
+    // is already contiguous it is used in place. Otherwise it is staged in
+    // the work array, copying the values in if requested.
+    template <class Array_t>
+    Scalar* stageReal( const Array_t& x, const bool copy_in )
+    {
+        auto owned_view = ownedView( x );
+        if ( isContiguousLayoutRight( owned_view ) )
+            return owned_view.data();
+        if ( copy_in )
+            Kokkos::deep_copy( workView( x ), owned_view );
+        return _real_work.data();
+    }
+
+  private:
+    std::shared_ptr<heffte::fft3d_r2c<heffte_backend_type>> _fft;
+    IndexSpace<num_space_dim> _spectral_space;
+    Kokkos::View<Scalar*, DeviceType> _real_work;
+    Kokkos::View<Scalar* [2], DeviceType> _workspace;
+};
+
+//---------------------------------------------------------------------------//
+// heFFTe real-to-complex creation
+//---------------------------------------------------------------------------//
+//! Creation function for real-to-complex heFFTe FFT with explict FFT backend.
+//! \param layout FFT real entity array
+//! \param params FFT parameters
+template <class Scalar, class DeviceType, class BackendType, class EntityType,
+          class MeshType>
+auto createHeffteRealFastFourierTransform(
+    const ArrayLayout<EntityType, MeshType>& layout,
+    const FastFourierTransformParams& params )
+{
+    return std::make_shared<HeffteRealFastFourierTransform<
+        EntityType, MeshType, Scalar, DeviceType, BackendType>>( layout,
+                                                                 params );
+}
+
+//! Creation function for real-to-complex heFFTe FFT with default FFT
+//! backend.
+//! \param layout FFT real entity array
+//! \param params FFT parameters
+template <class Scalar, class DeviceType, class EntityType, class MeshType>
+auto createHeffteRealFastFourierTransform(
+    const ArrayLayout<EntityType, MeshType>& layout,
+    const FastFourierTransformParams& params )
+{
+    return createHeffteRealFastFourierTransform<
+        Scalar, DeviceType, Impl::FFTBackendDefault, EntityType, MeshType>(
+        layout, params );
+}
+
+//! Creation function for real-to-complex heFFTe FFT with explict FFT backend
+//! and default parameters.
+//! \param layout FFT real entity array
+template <class Scalar, class DeviceType, class BackendType, class EntityType,
+          class MeshType>
+auto createHeffteRealFastFourierTransform(
+    const ArrayLayout<EntityType, MeshType>& layout )
+{
+    using exec_space = typename DeviceType::execution_space;
+    using heffte_backend_type =
+        typename Impl::HeffteBackendTraits<exec_space,
+                                           BackendType>::backend_type;
+
+    // use default heFFTe params for this backend
+    const heffte::plan_options heffte_params =
+        heffte::default_options<heffte_backend_type>();
+    FastFourierTransformParams params;
+    params.setAllToAll( heffte_params.use_alltoall );
+    params.setPencils( heffte_params.use_pencils );
+    params.setReorder( heffte_params.use_reorder );
+
+    return createHeffteRealFastFourierTransform<Scalar, DeviceType,
+                                                BackendType>( layout, params );
+}
+
+//! Creation function for real-to-complex heFFTe FFT with default FFT backend
+//! and default parameters.
+//! \param layout FFT real entity array
+template <class Scalar, class DeviceType, class EntityType, class MeshType>
+auto createHeffteRealFastFourierTransform(
+    const ArrayLayout<EntityType, MeshType>& layout )
+{
+    return createHeffteRealFastFourierTransform<
+        Scalar, DeviceType, Impl::FFTBackendDefault, EntityType, MeshType>(
+        layout );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Experimental
@@ -0,0 +1,780 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_GeometricMultigrid.hpp
+  \brief Geometric multigrid preconditioner
+*/
+#ifndef CAJITA_GEOMETRICMULTIGRID_HPP
+#define CAJITA_GEOMETRICMULTIGRID_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_Halo.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_MpiTraits.hpp>
+#include <Cajita_Parallel.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_ReferenceStructuredSolver.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace Cajita
+{
+//! \cond Impl
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Multigrid kernels.
+//---------------------------------------------------------------------------//
+// Compute the residual r = b - Ax.
+template <class OperatorType, class ViewType>
+struct MultigridResidual
+{
+    OperatorType A;
+    ViewType x_view;
+    ViewType b_view;
+    ViewType r_view;
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k ) const
+    {
+        r_view( i, j, k, 0 ) =
+            b_view( i, j, k, 0 ) - A( createVectorAccessor( x_view ), i, j, k );
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j ) const
+    {
+        r_view( i, j, 0 ) =
+            b_view( i, j, 0 ) - A( createVectorAccessor( x_view ), i, j );
+    }
+};
+
+// Damped Jacobi update x += w D^-1 r.
+template <class ViewType, class Scalar>
+struct MultigridJacobiUpdate
+{
+    ViewType x_view;
+    ViewType r_view;
+    Scalar scale;
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k ) const
+    {
+        x_view( i, j, k, 0 ) += scale * r_view( i, j, k, 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j ) const
+    {
+        x_view( i, j, 0 ) += scale * r_view( i, j, 0 );
+    }
+};
+
+// Restrict a fine vector to a coarse vector by averaging the children of
+// each coarse cell.
+template <class ViewType, std::size_t NumSpaceDim>
+struct MultigridRestriction
+{
+    ViewType fine_view;
+    ViewType coarse_view;
+    Kokkos::Array<int, NumSpaceDim> fine_min;
+    Kokkos::Array<int, NumSpaceDim> coarse_min;
+
+    using value_type = typename ViewType::value_type;
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k ) const
+    {
+        int fi = fine_min[0] + 2 * ( i - coarse_min[0] );
+        int fj = fine_min[1] + 2 * ( j - coarse_min[1] );
+        int fk = fine_min[2] + 2 * ( k - coarse_min[2] );
+        value_type sum = 0.0;
+        for ( int ci = 0; ci < 2; ++ci )
+            for ( int cj = 0; cj < 2; ++cj )
+                for ( int ck = 0; ck < 2; ++ck )
+                    sum += fine_view( fi + ci, fj + cj, fk + ck, 0 );
+        coarse_view( i, j, k, 0 ) = 0.125 * sum;
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j ) const
+    {
+        int fi = fine_min[0] + 2 * ( i - coarse_min[0] );
+        int fj = fine_min[1] + 2 * ( j - coarse_min[1] );
+        value_type sum = 0.0;
+        for ( int ci = 0; ci < 2; ++ci )
+            for ( int cj = 0; cj < 2; ++cj )
+                sum += fine_view( fi + ci, fj + cj, 0 );
+        coarse_view( i, j, 0 ) = 0.25 * sum;
+    }
+};
+
+// Add the coarse correction of the parent of each fine cell.
+template <class ViewType, std::size_t NumSpaceDim>
+struct MultigridProlongation
+{
+    ViewType coarse_view;
+    ViewType fine_view;
+    Kokkos::Array<int, NumSpaceDim> coarse_min;
+    Kokkos::Array<int, NumSpaceDim> fine_min;
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k ) const
+    {
+        fine_view( i, j, k, 0 ) +=
+            coarse_view( coarse_min[0] + ( i - fine_min[0] ) / 2,
+                         coarse_min[1] + ( j - fine_min[1] ) / 2,
+                         coarse_min[2] + ( k - fine_min[2] ) / 2, 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j ) const
+    {
+        fine_view( i, j, 0 ) +=
+            coarse_view( coarse_min[0] + ( i - fine_min[0] ) / 2,
+                         coarse_min[1] + ( j - fine_min[1] ) / 2, 0 );
+    }
+};
+
+// Add the correction of an agglomerated vector at a shifted index.
+template <class ViewType, std::size_t NumSpaceDim>
+struct MultigridShiftAdd
+{
+    ViewType agglomerated_view;
+    ViewType view;
+    Kokkos::Array<int, NumSpaceDim> shift;
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k ) const
+    {
+        view( i, j, k, 0 ) += agglomerated_view( i + shift[0], j + shift[1],
+                                                 k + shift[2], 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j ) const
+    {
+        view( i, j, 0 ) += agglomerated_view( i + shift[0], j + shift[1], 0 );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Host access to the first component of a vector.
+template <class ViewType>
+typename ViewType::reference_type hostValue( const ViewType& view,
+                                             const std::array<long, 3>& ijk )
+{
+    return view( ijk[0], ijk[1], ijk[2], 0 );
+}
+
+template <class ViewType>
+typename ViewType::reference_type hostValue( const ViewType& view,
+                                             const std::array<long, 2>& ij )
+{
+    return view( ij[0], ij[1], 0 );
+}
+
+// Visit the indices of a block in lexicographic order with the last
+// dimension fastest.
+template <std::size_t N, class Function>
+void forEachBlockIndex( const std::array<long, N>& min,
+                        const std::array<long, N>& extent,
+                        const Function& function )
+{
+    long size = 1;
+    for ( std::size_t d = 0; d < N; ++d )
+        size *= extent[d];
+    std::array<long, N> ijk = min;
+    for ( long n = 0; n < size; ++n )
+    {
+        function( ijk );
+        for ( int d = N - 1; d >= 0; --d )
+        {
+            if ( ++ijk[d] < min[d] + extent[d] )
+                break;
+            ijk[d] = min[d];
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Compute the Galerkin coarse operator R A P of a constant stencil where P
+// injects each coarse cell into its children and R averages them.
+template <class Scalar, std::size_t NumSpaceDim>
+void galerkinCoarsen( const std::vector<std::array<int, NumSpaceDim>>& stencil,
+                      const std::vector<Scalar>& coefficients,
+                      std::vector<std::array<int, NumSpaceDim>>& coarse_stencil,
+                      std::vector<Scalar>& coarse_coefficients )
+{
+    const int num_child = 1 << NumSpaceDim;
+    std::map<std::array<int, NumSpaceDim>, Scalar> coarse_entries;
+    for ( int c = 0; c < num_child; ++c )
+    {
+        for ( std::size_t s = 0; s < stencil.size(); ++s )
+        {
+            // Find the coarse cell containing the fine neighbor of the child.
+            std::array<int, NumSpaceDim> offset;
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                int f = ( ( c >> d ) & 1 ) + stencil[s][d];
+                offset[d] = ( f >= 0 ) ? f / 2 : -( ( 1 - f ) / 2 );
+            }
+            coarse_entries[offset] += coefficients[s] / num_child;
+        }
+    }
+
+    coarse_stencil.clear();
+    coarse_coefficients.clear();
+    for ( auto& e : coarse_entries )
+    {
+        if ( e.second != 0.0 )
+        {
+            coarse_stencil.push_back( e.first );
+            coarse_coefficients.push_back( e.second );
+        }
+    }
+}
+
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Geometric multigrid preconditioner for cell-centered structured
+  grids.
+
+  Applies one V-cycle with damped Jacobi smoothing as a preconditioner for
+  ReferenceConjugateGradient. The operator is a constant coefficient stencil
+  with homogeneous Dirichlet conditions on non-periodic boundaries. Coarse
+  operators are computed by Galerkin coarsening with piecewise constant
+  prolongation and averaging restriction, so the cycle is symmetric.
+
+  Grids are coarsened by two in each dimension on the same ranks while every
+  rank owns an even number of cells. Once the global grid has at most the
+  agglomeration size number of cells it is gathered onto every rank and
+  coarsened further without communication.
+
+  \tparam Scalar Scalar value type.
+  \tparam MeshType Mesh type. Must be a uniform mesh.
+  \tparam DeviceType Kokkos device type.
+*/
+template <class Scalar, class MeshType, class DeviceType>
+class GeometricMultigrid
+    : public ReferenceStructuredPreconditioner<Scalar, Cell, MeshType,
+                                               DeviceType>
+{
+  public:
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Array type.
+    using Array_t = Array<Scalar, Cell, MeshType, DeviceType>;
+    //! Vector type.
+    using Vector_t = typename ReferenceStructuredPreconditioner<
+        Scalar, Cell, MeshType, DeviceType>::Vector_t;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = MeshType::num_space_dim;
+    //! Level operator type.
+    using operator_type =
+        ConstantStencilOperator<Scalar, num_space_dim, DeviceType>;
+
+    static_assert( isUniformMesh<MeshType>::value,
+                   "Geometric multigrid requires a uniform mesh" );
+
+    /*!
+      \brief Constructor.
+      \param layout The array layout of the vectors to precondition.
+      \param stencil The (i,j,k) offsets of the operator stencil.
+      \param coefficients The coefficient of each stencil entry.
+    */
+    GeometricMultigrid(
+        const ArrayLayout<Cell, MeshType>& layout,
+        const std::vector<std::array<int, num_space_dim>>& stencil,
+        const std::vector<Scalar>& coefficients )
+        : _local_grid( layout.localGrid() )
+        , _stencil( stencil )
+        , _coefficients( coefficients )
+        , _num_sweep( 2 )
+        , _num_coarse_sweep( 50 )
+        , _weight( 2.0 / 3.0 )
+        , _max_levels( 20 )
+        , _agglomeration_size( 4096 )
+    {
+        if ( stencil.size() != coefficients.size() )
+            throw std::logic_error(
+                "Stencil and coefficients must have the same size" );
+    }
+
+    //! Set the number of pre- and post-smoothing sweeps.
+    void setNumSweeps( const int num_sweep ) { _num_sweep = num_sweep; }
+
+    //! Set the number of smoothing sweeps on the coarsest level.
+    void setNumCoarseSweeps( const int num_sweep )
+    {
+        _num_coarse_sweep = num_sweep;
+    }
+
+    //! Set the damped Jacobi smoother weight.
+    void setSmootherWeight( const Scalar weight ) { _weight = weight; }
+
+    //! Set the maximum number of levels.
+    void setMaxLevels( const int max_levels ) { _max_levels = max_levels; }
+
+    //! Set the global number of cells at or below which a level is
+    //! gathered onto every rank.
+    void setAgglomerationSize( const long size ) { _agglomeration_size = size; }
+
+    //! Get the number of levels in the hierarchy.
+    int numLevels() const { return _levels.size(); }
+
+    //! Build the grid hierarchy.
+    void setup() override
+    {
+        _levels.clear();
+        auto stencil = _stencil;
+        auto coefficients = _coefficients;
+        addLevel( _local_grid, stencil, coefficients, false );
+
+        int comm_size;
+        MPI_Comm_size( _local_grid->globalGrid().comm(), &comm_size );
+        bool replicated = ( 1 == comm_size );
+
+        while ( static_cast<int>( _levels.size() ) < _max_levels )
+        {
+            const auto& global_grid = _levels.back().local_grid->globalGrid();
+
+            // Gather a small distributed level onto every rank.
+            if ( !replicated && globalNumCell( global_grid ) <=
+                                    _agglomeration_size )
+            {
+                setupAgglomeration( global_grid );
+                auto local_grid = createCoarseLocalGrid(
+                    global_grid, 1, MPI_COMM_SELF, stencil );
+                addLevel( local_grid, stencil, coefficients, true );
+                replicated = true;
+                continue;
+            }
+
+            // Otherwise coarsen on the same ranks.
+            std::vector<std::array<int, num_space_dim>> coarse_stencil;
+            std::vector<Scalar> coarse_coefficients;
+            Impl::galerkinCoarsen( stencil, coefficients, coarse_stencil,
+                                   coarse_coefficients );
+            if ( !canCoarsen( global_grid, coarse_stencil ) )
+                break;
+            stencil = coarse_stencil;
+            coefficients = coarse_coefficients;
+            auto local_grid = createCoarseLocalGrid(
+                global_grid, 2,
+                replicated ? MPI_COMM_SELF : global_grid.comm(), stencil );
+            addLevel( local_grid, stencil, coefficients, false );
+        }
+    }
+
+    /*!
+      \brief Apply one V-cycle z = M r.
+      \param r The vector to precondition. Only owned values are read.
+      \param z The preconditioned vector. Only owned values are written.
+    */
+    void apply( const Vector_t& r, Vector_t& z ) override
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::GeometricMultigrid::apply" );
+
+        if ( _levels.empty() )
+            throw std::logic_error( "Multigrid setup has not been called" );
+
+        auto owned_space = _levels[0].b->layout()->indexSpace( Own(), Local() );
+        Kokkos::deep_copy( createSubview( _levels[0].b->view(), owned_space ),
+                           createSubview( r.view(), owned_space ) );
+        cycle( 0 );
+        Kokkos::deep_copy( createSubview( z.view(), owned_space ),
+                           createSubview( _levels[0].x->view(), owned_space ) );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+  private:
+    // A level of the hierarchy.
+    struct Level
+    {
+        std::shared_ptr<LocalGrid<MeshType>> local_grid;
+        std::shared_ptr<Array_t> x;
+        std::shared_ptr<Array_t> b;
+        std::shared_ptr<Array_t> r;
+        std::shared_ptr<Halo<memory_space>> halo;
+        std::shared_ptr<operator_type> A;
+        Scalar diagonal;
+        // If true this level is a copy of the previous level gathered onto
+        // every rank.
+        bool agglomerated;
+    };
+
+    // Get the global number of cells of a grid.
+    long globalNumCell( const GlobalGrid<MeshType>& global_grid ) const
+    {
+        long size = 1;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            size *= global_grid.globalNumEntity( Cell(), d );
+        return size;
+    }
+
+    // Get the width of a stencil.
+    static int
+    stencilWidth( const std::vector<std::array<int, num_space_dim>>& stencil )
+    {
+        int width = 0;
+        for ( auto s : stencil )
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                width = std::max( width, std::abs( s[d] ) );
+        return width;
+    }
+
+    // Determine if every rank of a grid can halve its owned cells while
+    // keeping at least a halo width of cells.
+    bool
+    canCoarsen( const GlobalGrid<MeshType>& global_grid,
+                const std::vector<std::array<int, num_space_dim>>& stencil )
+    {
+        int min_cell = std::max( stencilWidth( stencil ), 1 );
+        int can_coarsen = 1;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            int owned = global_grid.ownedNumCell( d );
+            if ( owned % 2 != 0 || owned / 2 < min_cell )
+                can_coarsen = 0;
+        }
+        MPI_Allreduce( MPI_IN_PLACE, &can_coarsen, 1, MPI_INT, MPI_LAND,
+                       global_grid.comm() );
+        return can_coarsen;
+    }
+
+    // Create the local grid of a level coarsened by the given factor (1 or
+    // 2). Coarsened blocks are aligned with the blocks of the fine grid.
+    std::shared_ptr<LocalGrid<MeshType>> createCoarseLocalGrid(
+        const GlobalGrid<MeshType>& global_grid, const int factor,
+        MPI_Comm comm,
+        const std::vector<std::array<int, num_space_dim>>& stencil )
+    {
+        const auto& global_mesh = global_grid.globalMesh();
+        std::array<typename MeshType::scalar_type, num_space_dim> low_corner;
+        std::array<typename MeshType::scalar_type, num_space_dim> high_corner;
+        std::array<int, num_space_dim> num_cell;
+        std::array<bool, num_space_dim> periodic;
+        std::array<int, num_space_dim> ranks_per_dim;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            low_corner[d] = global_mesh.lowCorner( d );
+            high_corner[d] = global_mesh.highCorner( d );
+            num_cell[d] = global_mesh.globalNumCell( d ) / factor;
+            periodic[d] = global_grid.isPeriodic( d );
+            ranks_per_dim[d] =
+                ( MPI_COMM_SELF == comm ) ? 1 : global_grid.dimNumBlock( d );
+        }
+        auto coarse_mesh =
+            createUniformGlobalMesh( low_corner, high_corner, num_cell );
+
+        // The fine grid communicator already has the Cartesian topology of
+        // the coarse grid. Build the coarse grid on it without reordering
+        // the ranks so each rank keeps the block id it has on the fine grid.
+        auto coarse_grid = std::make_shared<GlobalGrid<MeshType>>(
+            comm, coarse_mesh, periodic,
+            ManualBlockPartitioner<num_space_dim>( ranks_per_dim ), false );
+
+        // Align the owned blocks with the fine grid.
+        if ( MPI_COMM_SELF != comm )
+        {
+            std::array<int, num_space_dim> owned_num_cell;
+            std::array<int, num_space_dim> offset;
+            int mismatch = 0;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                if ( coarse_grid->dimBlockId( d ) !=
+                     global_grid.dimBlockId( d ) )
+                    mismatch = 1;
+                owned_num_cell[d] = global_grid.ownedNumCell( d ) / factor;
+                offset[d] = global_grid.globalOffset( d ) / factor;
+            }
+
+            // Agree on the result so every rank throws together.
+            MPI_Allreduce( MPI_IN_PLACE, &mismatch, 1, MPI_INT, MPI_LOR,
+                           comm );
+            if ( mismatch )
+                throw std::logic_error(
+                    "Coarse grid blocks do not match the fine grid" );
+            coarse_grid->setNumCellAndOffset( owned_num_cell, offset );
+        }
+
+        return createLocalGrid( coarse_grid,
+                                std::max( stencilWidth( stencil ), 1 ) );
+    }
+
+    // Add a level to the hierarchy.
+    void addLevel( const std::shared_ptr<LocalGrid<MeshType>>& local_grid,
+                   const std::vector<std::array<int, num_space_dim>>& stencil,
+                   const std::vector<Scalar>& coefficients,
+                   const bool agglomerated )
+    {
+        Level level;
+        level.local_grid = local_grid;
+        auto layout = createArrayLayout( local_grid, 1, Cell() );
+        level.x = createArray<Scalar, DeviceType>( "multigrid_x", layout );
+        level.b = createArray<Scalar, DeviceType>( "multigrid_b", layout );
+        level.r = createArray<Scalar, DeviceType>( "multigrid_r", layout );
+        level.halo = createHalo( NodeHaloPattern<num_space_dim>(),
+                                 stencilWidth( stencil ), *level.x );
+        level.A = std::make_shared<operator_type>( stencil, coefficients );
+        level.diagonal = 0.0;
+        for ( std::size_t s = 0; s < stencil.size(); ++s )
+            if ( std::all_of( stencil[s].begin(), stencil[s].end(),
+                              []( const int o ) { return 0 == o; } ) )
+                level.diagonal += coefficients[s];
+        if ( 0.0 == level.diagonal )
+            throw std::logic_error( "Multigrid operator has a zero diagonal" );
+        level.agglomerated = agglomerated;
+        _levels.push_back( level );
+    }
+
+    // Gather the owned blocks of every rank for agglomeration.
+    void setupAgglomeration( const GlobalGrid<MeshType>& global_grid )
+    {
+        int comm_size;
+        MPI_Comm_size( global_grid.comm(), &comm_size );
+        std::vector<int> block( 2 * num_space_dim );
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            block[d] = global_grid.globalOffset( d );
+            block[num_space_dim + d] = global_grid.ownedNumCell( d );
+        }
+        _blocks.resize( 2 * num_space_dim * comm_size );
+        MPI_Allgather( block.data(), block.size(), MPI_INT, _blocks.data(),
+                       block.size(), MPI_INT, global_grid.comm() );
+
+        _block_counts.assign( comm_size, 1 );
+        _block_displs.assign( comm_size, 0 );
+        for ( int n = 0; n < comm_size; ++n )
+        {
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                _block_counts[n] *= _blocks[2 * num_space_dim * n +
+                                            num_space_dim + d];
+            if ( n > 0 )
+                _block_displs[n] = _block_displs[n - 1] + _block_counts[n - 1];
+        }
+    }
+
+    // Smooth a level with damped Jacobi.
+    void smooth( Level& level, const int num_sweep )
+    {
+        auto owned_space =
+            level.local_grid->indexSpace( Own(), Cell(), Local() );
+        for ( int s = 0; s < num_sweep; ++s )
+        {
+            level.halo->gather( execution_space(), *level.x );
+            computeResidual( level );
+            grid_parallel_for(
+                "multigrid_jacobi", execution_space(), owned_space,
+                Impl::MultigridJacobiUpdate<typename Array_t::view_type,
+                                            Scalar>{
+                    level.x->view(), level.r->view(),
+                    _weight / level.diagonal } );
+        }
+    }
+
+    // Compute the residual of a level. The halo of x must be gathered.
+    void computeResidual( Level& level )
+    {
+        grid_parallel_for(
+            "multigrid_residual", execution_space(),
+            level.local_grid->indexSpace( Own(), Cell(), Local() ),
+            Impl::MultigridResidual<operator_type,
+                                    typename Array_t::view_type>{
+                *level.A, level.x->view(), level.b->view(),
+                level.r->view() } );
+    }
+
+    // Get the minimum owned local index of a level.
+    Kokkos::Array<int, num_space_dim> ownedMin( const Level& level ) const
+    {
+        auto owned_space =
+            level.local_grid->indexSpace( Own(), Cell(), Local() );
+        Kokkos::Array<int, num_space_dim> min;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            min[d] = owned_space.min( d );
+        return min;
+    }
+
+    // Apply a V-cycle starting at the given level.
+    void cycle( const std::size_t l )
+    {
+        auto& level = _levels[l];
+        ArrayOp::assign( *level.x, 0.0, Own() );
+
+        // Coarsest level.
+        if ( l + 1 == _levels.size() )
+        {
+            smooth( level, _num_coarse_sweep );
+            return;
+        }
+
+        // Pre-smooth and compute the residual.
+        smooth( level, _num_sweep );
+        level.halo->gather( execution_space(), *level.x );
+        computeResidual( level );
+
+        // Restrict, solve the coarse level, and correct.
+        auto& coarse = _levels[l + 1];
+        if ( coarse.agglomerated )
+        {
+            agglomerate( level, coarse );
+            cycle( l + 1 );
+            auto level_min = ownedMin( level );
+            auto coarse_min = ownedMin( coarse );
+            Kokkos::Array<int, num_space_dim> shift;
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                shift[d] = coarse_min[d] - level_min[d] +
+                           level.local_grid->globalGrid().globalOffset( d );
+            grid_parallel_for(
+                "multigrid_agglomerated_correction", execution_space(),
+                level.local_grid->indexSpace( Own(), Cell(), Local() ),
+                Impl::MultigridShiftAdd<typename Array_t::view_type,
+                                        num_space_dim>{
+                    coarse.x->view(), level.x->view(), shift } );
+        }
+        else
+        {
+            grid_parallel_for(
+                "multigrid_restriction", execution_space(),
+                coarse.local_grid->indexSpace( Own(), Cell(), Local() ),
+                Impl::MultigridRestriction<typename Array_t::view_type,
+                                           num_space_dim>{
+                    level.r->view(), coarse.b->view(), ownedMin( level ),
+                    ownedMin( coarse ) } );
+            cycle( l + 1 );
+            grid_parallel_for(
+                "multigrid_prolongation", execution_space(),
+                level.local_grid->indexSpace( Own(), Cell(), Local() ),
+                Impl::MultigridProlongation<typename Array_t::view_type,
+                                            num_space_dim>{
+                    coarse.x->view(), level.x->view(), ownedMin( coarse ),
+                    ownedMin( level ) } );
+        }
+
+        // Post-smooth.
+        smooth( level, _num_sweep );
+    }
+
+    // Gather the residual of a distributed level into the right hand side
+    // of its agglomerated copy on every rank.
+    void agglomerate( const Level& level, Level& coarse )
+    {
+        // Pack the owned residual.
+        auto r_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                           level.r->view() );
+        auto owned_space =
+            level.local_grid->indexSpace( Own(), Cell(), Local() );
+        std::array<long, num_space_dim> min;
+        std::array<long, num_space_dim> extent;
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            min[d] = owned_space.min( d );
+            extent[d] = owned_space.extent( d );
+        }
+        std::vector<Scalar> send;
+        send.reserve( owned_space.size() );
+        Impl::forEachBlockIndex(
+            min, extent, [&]( const std::array<long, num_space_dim>& ijk ) {
+                send.push_back( Impl::hostValue( r_host, ijk ) );
+            } );
+
+        // Gather all blocks.
+        std::vector<Scalar> recv( _block_displs.back() +
+                                  _block_counts.back() );
+        MPI_Allgatherv( send.data(), send.size(), MpiTraits<Scalar>::type(),
+                        recv.data(), _block_counts.data(),
+                        _block_displs.data(), MpiTraits<Scalar>::type(),
+                        level.local_grid->globalGrid().comm() );
+
+        // Unpack the blocks at their global location.
+        auto b_host = Kokkos::create_mirror_view( Kokkos::HostSpace(),
+                                                  coarse.b->view() );
+        auto coarse_min = ownedMin( coarse );
+        for ( std::size_t n = 0; n < _block_counts.size(); ++n )
+        {
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                min[d] = coarse_min[d] + _blocks[2 * num_space_dim * n + d];
+                extent[d] =
+                    _blocks[2 * num_space_dim * n + num_space_dim + d];
+            }
+            int index = _block_displs[n];
+            Impl::forEachBlockIndex(
+                min, extent,
+                [&]( const std::array<long, num_space_dim>& ijk ) {
+                    Impl::hostValue( b_host, ijk ) = recv[index++];
+                } );
+        }
+        Kokkos::deep_copy( coarse.b->view(), b_host );
+    }
+
+  private:
+    std::shared_ptr<LocalGrid<MeshType>> _local_grid;
+    std::vector<std::array<int, num_space_dim>> _stencil;
+    std::vector<Scalar> _coefficients;
+    int _num_sweep;
+    int _num_coarse_sweep;
+    Scalar _weight;
+    int _max_levels;
+    long _agglomeration_size;
+    std::vector<Level> _levels;
+    std::vector<int> _blocks;
+    std::vector<int> _block_counts;
+    std::vector<int> _block_displs;
+};
+
+//---------------------------------------------------------------------------//
+// Builders.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a geometric multigrid preconditioner.
+  \param layout The array layout of the vectors to precondition.
+  \param stencil The (i,j,k) offsets of the operator stencil.
+  \param coefficients The coefficient of each stencil entry.
+*/
+template <class Scalar, class DeviceType, class MeshType>
+std::shared_ptr<GeometricMultigrid<Scalar, MeshType, DeviceType>>
+createGeometricMultigrid(
+    const ArrayLayout<Cell, MeshType>& layout,
+    const std::vector<std::array<int, MeshType::num_space_dim>>& stencil,
+    const std::vector<Scalar>& coefficients )
+{
+    return std::make_shared<GeometricMultigrid<Scalar, MeshType, DeviceType>>(
+        layout, stencil, coefficients );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_GEOMETRICMULTIGRID_HPP
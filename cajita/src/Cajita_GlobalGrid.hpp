@@ -48,11 +48,14 @@ class GlobalGrid
      \param global_mesh The global mesh data.
      \param periodic Whether each logical dimension is periodic.
      \param partitioner The grid partitioner.
+     \param reorder_ranks Whether MPI may reorder the ranks of the Cartesian
+     communicator. Without reordering each rank keeps its rank in comm.
     */
     GlobalGrid( MPI_Comm comm,
                 const std::shared_ptr<GlobalMesh<MeshType>>& global_mesh,
                 const std::array<bool, num_space_dim>& periodic,
-                const BlockPartitioner<num_space_dim>& partitioner );
+                const BlockPartitioner<num_space_dim>& partitioner,
+                const bool reorder_ranks = true );
 
     // Destructor.
     ~GlobalGrid();
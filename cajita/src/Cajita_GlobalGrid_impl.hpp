@@ -24,7 +24,8 @@ template <class MeshType>
 GlobalGrid<MeshType>::GlobalGrid(
     MPI_Comm comm, const std::shared_ptr<GlobalMesh<MeshType>>& global_mesh,
     const std::array<bool, num_space_dim>& periodic,
-    const BlockPartitioner<num_space_dim>& partitioner )
+    const BlockPartitioner<num_space_dim>& partitioner,
+    const bool reorder_ranks )
     : _global_mesh( global_mesh )
     , _periodic( periodic )
 {
@@ -40,7 +41,7 @@ GlobalGrid<MeshType>::GlobalGrid(
         periodic_dims[d] = _periodic[d];
 
     // Generate a communicator with a Cartesian topology.
-    int reorder_cart_ranks = 1;
+    int reorder_cart_ranks = reorder_ranks;
     MPI_Cart_create( comm, num_space_dim, _ranks_per_dim.data(),
                      periodic_dims.data(), reorder_cart_ranks, &_cart_comm );
 
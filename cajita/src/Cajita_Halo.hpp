@@ -187,6 +187,25 @@ struct Replace
 
 //---------------------------------------------------------------------------//
 // Halo
+//---------------------------------------------------------------------------//
+/*!
+  \brief Handle for a split-phase halo communication that has been started
+  but not yet completed. Returned by Halo::gatherBegin() and
+  Halo::scatterBegin() and completed by the matching end call.
+*/
+class HaloRequest
+{
+  public:
+    //! Check if the communication has been completed.
+    bool complete() const { return _requests.empty(); }
+
+  private:
+    template <class MemorySpace>
+    friend class Halo;
+
+    std::vector<MPI_Request> _requests;
+};
+
 // ---------------------------------------------------------------------------//
 /*!
   General multiple array halo communication plan for migrating shared data
@@ -284,7 +303,11 @@ class Halo
     ~Halo() { MPI_Comm_free( &_comm ); }
 
     /*!
-      \brief Gather data into our ghosts from their owners.
+      \brief Start gathering data into our ghosts from their owners. The
+      owned data is packed and sent and the receives are posted before
+      returning so other work (e.g. on the interior of the owned index space)
+      may be done while the messages are in flight. The gather is completed
+      with gatherEnd().
 
       \param exec_space The execution space to use for pack/unpack.
 
@@ -292,24 +315,30 @@ class Halo
       the same order as in the constructor. These could technically be
       different arrays, they just need to have the same layouts and data types
       as the input arrays.
+
+      \return The request to complete with gatherEnd().
+
+      \note Only one gather or scatter may be in flight at a time as they
+      share the communication buffers of the halo. The ghosted data must not
+      be accessed until the gather is completed.
     */
     template <class ExecutionSpace, class... ArrayTypes>
-    void gather( const ExecutionSpace& exec_space,
-                 const ArrayTypes&... arrays ) const
+    HaloRequest gatherBegin( const ExecutionSpace& exec_space,
+                             const ArrayTypes&... arrays ) const
     {
-        Kokkos::Profiling::pushRegion( "Cajita::gather" );
+        Kokkos::Profiling::pushRegion( "Cajita::gatherBegin" );
 
         // Get the number of neighbors. Return if we have none.
+        HaloRequest request;
         int num_n = _neighbor_ranks.size();
         if ( 0 == num_n )
-            return;
+        {
+            Kokkos::Profiling::popRegion();
+            return request;
+        }
 
         // Allocate requests.
-        std::vector<MPI_Request> requests( 2 * num_n, MPI_REQUEST_NULL );
-
-        // Pick a tag to use for communication. This object has its own
-        // communication space so any tag will do.
-        const int mpi_tag = 1234;
+        request._requests.resize( 2 * num_n, MPI_REQUEST_NULL );
 
         // Post receives.
         for ( int n = 0; n < num_n; ++n )
@@ -319,8 +348,8 @@ class Halo
             {
                 MPI_Irecv( _ghosted_buffers[n].data(),
                            _ghosted_buffers[n].size(), MPI_BYTE,
-                           _neighbor_ranks[n], mpi_tag + _receive_tags[n],
-                           _comm, &requests[n] );
+                           _neighbor_ranks[n], _gather_tag + _receive_tags[n],
+                           _comm, &request._requests[n] );
             }
         }
 
@@ -337,65 +366,88 @@ class Halo
                 // Post a send.
                 MPI_Isend( _owned_buffers[n].data(), _owned_buffers[n].size(),
                            MPI_BYTE, _neighbor_ranks[n],
-                           mpi_tag + _send_tags[n], _comm,
-                           &requests[num_n + n] );
+                           _gather_tag + _send_tags[n], _comm,
+                           &request._requests[num_n + n] );
             }
         }
 
-        // Unpack receive buffers.
-        bool unpack_complete = false;
-        while ( !unpack_complete )
-        {
-            // Get the next buffer to unpack.
-            int unpack_index = MPI_UNDEFINED;
-            MPI_Waitany( num_n, requests.data(), &unpack_index,
-                         MPI_STATUS_IGNORE );
+        Kokkos::Profiling::popRegion();
+        return request;
+    }
 
-            // If there are no more buffers to unpack we are done.
-            if ( MPI_UNDEFINED == unpack_index )
-            {
-                unpack_complete = true;
-            }
+    /*!
+      \brief Complete a gather started with gatherBegin(). Receive buffers
+      are unpacked into the ghosts as they arrive.
 
-            // Otherwise unpack the next buffer.
-            else
-            {
-                unpackBuffer( ScatterReduce::Replace(), exec_space,
-                              _ghosted_buffers[unpack_index],
-                              _ghosted_steering[unpack_index],
-                              arrays.view()... );
-            }
-        }
+      \param exec_space The execution space to use for pack/unpack.
 
-        // Wait on send requests.
-        MPI_Waitall( num_n, requests.data() + num_n, MPI_STATUSES_IGNORE );
+      \param request The request returned by gatherBegin().
+
+      \param arrays The arrays to gather. These must be the same arrays given
+      to gatherBegin().
+    */
+    template <class ExecutionSpace, class... ArrayTypes>
+    void gatherEnd( const ExecutionSpace& exec_space, HaloRequest& request,
+                    const ArrayTypes&... arrays ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::gatherEnd" );
+        waitAndUnpack( ScatterReduce::Replace(), exec_space, request,
+                       _ghosted_buffers, _ghosted_steering, arrays... );
         Kokkos::Profiling::popRegion();
     }
 
     /*!
-      \brief Scatter data from our ghosts to their owners using the given type
-      of reduce operation.
-      \param reduce_op The functor used to reduce the results.
+      \brief Gather data into our ghosts from their owners.
+
       \param exec_space The execution space to use for pack/unpack.
+
+      \param arrays The arrays to gather. NOTE: These arrays must be given in
+      the same order as in the constructor. These could technically be
+      different arrays, they just need to have the same layouts and data types
+      as the input arrays.
+    */
+    template <class ExecutionSpace, class... ArrayTypes>
+    void gather( const ExecutionSpace& exec_space,
+                 const ArrayTypes&... arrays ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::gather" );
+        auto request = gatherBegin( exec_space, arrays... );
+        gatherEnd( exec_space, request, arrays... );
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Start scattering data from our ghosts to their owners. The
+      ghosted data is packed and sent and the receives are posted before
+      returning. The scatter is completed with scatterEnd().
+
+      \param exec_space The execution space to use for pack/unpack.
+
       \param arrays The arrays to scatter.
+
+      \return The request to complete with scatterEnd().
+
+      \note Only one gather or scatter may be in flight at a time as they
+      share the communication buffers of the halo. The owned data shared with
+      neighbors must not be accessed until the scatter is completed.
     */
-    template <class ExecutionSpace, class ReduceOp, class... ArrayTypes>
-    void scatter( const ExecutionSpace& exec_space, const ReduceOp& reduce_op,
-                  const ArrayTypes&... arrays ) const
+    template <class ExecutionSpace, class... ArrayTypes>
+    HaloRequest scatterBegin( const ExecutionSpace& exec_space,
+                              const ArrayTypes&... arrays ) const
     {
-        Kokkos::Profiling::pushRegion( "Cajita::scatter" );
+        Kokkos::Profiling::pushRegion( "Cajita::scatterBegin" );
 
         // Get the number of neighbors. Return if we have none.
+        HaloRequest request;
         int num_n = _neighbor_ranks.size();
         if ( 0 == num_n )
-            return;
+        {
+            Kokkos::Profiling::popRegion();
+            return request;
+        }
 
         // Requests.
-        std::vector<MPI_Request> requests( 2 * num_n, MPI_REQUEST_NULL );
-
-        // Pick a tag to use for communication. This object has its own
-        // communication space so any tag will do.
-        const int mpi_tag = 2345;
+        request._requests.resize( 2 * num_n, MPI_REQUEST_NULL );
 
         // Post receives for all neighbors that are not self sends.
         for ( int n = 0; n < num_n; ++n )
@@ -405,7 +457,8 @@ class Halo
             {
                 MPI_Irecv( _owned_buffers[n].data(), _owned_buffers[n].size(),
                            MPI_BYTE, _neighbor_ranks[n],
-                           mpi_tag + _receive_tags[n], _comm, &requests[n] );
+                           _scatter_tag + _receive_tags[n], _comm,
+                           &request._requests[n] );
             }
         }
 
@@ -422,37 +475,54 @@ class Halo
                 // Post a send.
                 MPI_Isend( _ghosted_buffers[n].data(),
                            _ghosted_buffers[n].size(), MPI_BYTE,
-                           _neighbor_ranks[n], mpi_tag + _send_tags[n], _comm,
-                           &requests[num_n + n] );
+                           _neighbor_ranks[n], _scatter_tag + _send_tags[n],
+                           _comm, &request._requests[num_n + n] );
             }
         }
 
-        // Unpack receive buffers.
-        bool unpack_complete = false;
-        while ( !unpack_complete )
-        {
-            // Get the next buffer to unpack.
-            int unpack_index = MPI_UNDEFINED;
-            MPI_Waitany( num_n, requests.data(), &unpack_index,
-                         MPI_STATUS_IGNORE );
+        Kokkos::Profiling::popRegion();
+        return request;
+    }
 
-            // If there are no more buffers to unpack we are done.
-            if ( MPI_UNDEFINED == unpack_index )
-            {
-                unpack_complete = true;
-            }
+    /*!
+      \brief Complete a scatter started with scatterBegin() using the given
+      type of reduce operation. Receive buffers are reduced into the owned
+      data as they arrive.
 
-            // Otherwise unpack the next buffer and apply the reduce operation.
-            else
-            {
-                unpackBuffer( reduce_op, exec_space,
-                              _owned_buffers[unpack_index],
-                              _owned_steering[unpack_index], arrays.view()... );
-            }
+      \param exec_space The execution space to use for pack/unpack.
 
-            // Wait on send requests.
-            MPI_Waitall( num_n, requests.data() + num_n, MPI_STATUSES_IGNORE );
-        }
+      \param reduce_op The functor used to reduce the results.
+
+      \param request The request returned by scatterBegin().
+
+      \param arrays The arrays to scatter. These must be the same arrays
+      given to scatterBegin().
+    */
+    template <class ExecutionSpace, class ReduceOp, class... ArrayTypes>
+    void scatterEnd( const ExecutionSpace& exec_space,
+                     const ReduceOp& reduce_op, HaloRequest& request,
+                     const ArrayTypes&... arrays ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::scatterEnd" );
+        waitAndUnpack( reduce_op, exec_space, request, _owned_buffers,
+                       _owned_steering, arrays... );
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Scatter data from our ghosts to their owners using the given type
+      of reduce operation.
+      \param reduce_op The functor used to reduce the results.
+      \param exec_space The execution space to use for pack/unpack.
+      \param arrays The arrays to scatter.
+    */
+    template <class ExecutionSpace, class ReduceOp, class... ArrayTypes>
+    void scatter( const ExecutionSpace& exec_space, const ReduceOp& reduce_op,
+                  const ArrayTypes&... arrays ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::scatter" );
+        auto request = scatterBegin( exec_space, arrays... );
+        scatterEnd( exec_space, reduce_op, request, arrays... );
         Kokkos::Profiling::popRegion();
     }
 
@@ -911,9 +981,58 @@ class Halo
     }
 
   private:
+    // Wait on the receives of a request, unpacking each buffer as it
+    // arrives, and then wait on the sends.
+    template <class ReduceOp, class ExecutionSpace, class... ArrayTypes>
+    void waitAndUnpack(
+        const ReduceOp& reduce_op, const ExecutionSpace& exec_space,
+        HaloRequest& request,
+        const std::vector<Kokkos::View<char*, memory_space>>& buffers,
+        const std::vector<Kokkos::View<int**, memory_space>>& steering,
+        const ArrayTypes&... arrays ) const
+    {
+        // Return if the request has already been completed.
+        int num_n = request._requests.size() / 2;
+        if ( 0 == num_n )
+            return;
+
+        // Unpack receive buffers.
+        bool unpack_complete = false;
+        while ( !unpack_complete )
+        {
+            // Get the next buffer to unpack.
+            int unpack_index = MPI_UNDEFINED;
+            MPI_Waitany( num_n, request._requests.data(), &unpack_index,
+                         MPI_STATUS_IGNORE );
+
+            // If there are no more buffers to unpack we are done.
+            if ( MPI_UNDEFINED == unpack_index )
+            {
+                unpack_complete = true;
+            }
+
+            // Otherwise unpack the next buffer and apply the reduce operation.
+            else
+            {
+                unpackBuffer( reduce_op, exec_space, buffers[unpack_index],
+                              steering[unpack_index], arrays.view()... );
+            }
+        }
+
+        // Wait on send requests.
+        MPI_Waitall( num_n, request._requests.data() + num_n,
+                     MPI_STATUSES_IGNORE );
+        request._requests.clear();
+    }
+
     // MPI communicator.
     MPI_Comm _comm;
 
+    // Base tags for gathers and scatters. This object has its own
+    // communication space so any tags will do.
+    static constexpr int _gather_tag = 1234;
+    static constexpr int _scatter_tag = 2345;
+
     // The ranks we will send/receive from.
     std::vector<int> _neighbor_ranks;
 
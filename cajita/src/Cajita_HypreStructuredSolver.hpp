@@ -92,6 +92,32 @@ struct HypreIsCompatibleWithMemorySpace<Kokkos::HostSpace> : std::true_type
 };
 #endif // end HYPRE_USING_GPU
 
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Get a pointer HYPRE can use directly for the values of a view or null if
+// the values must be reordered.
+template <class ViewType>
+std::enable_if_t<std::is_same<typename ViewType::non_const_value_type,
+                              HYPRE_Complex>::value,
+                 HYPRE_Complex*>
+hypreDirectPointer( const ViewType& view )
+{
+    return isContiguousLayoutRight( view ) ? view.data() : nullptr;
+}
+
+template <class ViewType>
+std::enable_if_t<!std::is_same<typename ViewType::non_const_value_type,
+                               HYPRE_Complex>::value,
+                 HYPRE_Complex*>
+hypreDirectPointer( const ViewType& )
+{
+    return nullptr;
+}
+} // end namespace Impl
+//! \endcond
+
 //---------------------------------------------------------------------------//
 //! Hypre structured solver interface for scalar fields.
 template <class Scalar, class EntityType, class MemorySpace>
@@ -119,6 +145,7 @@ class HypreStructuredSolver
                            const bool is_preconditioner = false )
         : _comm( layout.localGrid()->globalGrid().comm() )
         , _is_preconditioner( is_preconditioner )
+        , _matrix_initialized( false )
     {
         static_assert( is_array_layout<ArrayLayout_t>::value,
                        "Must use an array layout" );
@@ -176,24 +203,20 @@ class HypreStructuredSolver
             checkHypreError( error );
 
             // Allocate LHS and RHS vectors and initialize to zero. Note that we
-            // are fixing the views under these vectors to layout-right.
-            std::array<long, num_space_dim> reorder_size;
+            // are fixing the views under these vectors to layout-right. The
+            // staging buffer is kept for reordering vector values in solves.
+            long vector_size = 1;
             for ( std::size_t d = 0; d < num_space_dim; ++d )
-            {
-                reorder_size[d] = global_space.extent( d );
-            }
-            IndexSpace<num_space_dim> reorder_space( reorder_size );
-            auto vector_values =
-                createView<HYPRE_Complex, Kokkos::LayoutRight, memory_space>(
-                    "vector_values", reorder_space );
-            Kokkos::deep_copy( vector_values, 0.0 );
+                vector_size *= global_space.extent( d );
+            _vector_buffer = Kokkos::View<HYPRE_Complex*, memory_space>(
+                "vector_values", vector_size );
 
             error = HYPRE_StructVectorCreate( _comm, _grid, &_b );
             checkHypreError( error );
             error = HYPRE_StructVectorInitialize( _b );
             checkHypreError( error );
             error = HYPRE_StructVectorSetBoxValues(
-                _b, _lower.data(), _upper.data(), vector_values.data() );
+                _b, _lower.data(), _upper.data(), _vector_buffer.data() );
             checkHypreError( error );
             error = HYPRE_StructVectorAssemble( _b );
             checkHypreError( error );
@@ -203,7 +226,7 @@ class HypreStructuredSolver
             error = HYPRE_StructVectorInitialize( _x );
             checkHypreError( error );
             error = HYPRE_StructVectorSetBoxValues(
-                _x, _lower.data(), _upper.data(), vector_values.data() );
+                _x, _lower.data(), _upper.data(), _vector_buffer.data() );
             checkHypreError( error );
             error = HYPRE_StructVectorAssemble( _x );
             checkHypreError( error );
@@ -264,10 +287,16 @@ class HypreStructuredSolver
         checkHypreError( error );
         error = HYPRE_StructMatrixSetSymmetric( _A, is_symmetric );
         checkHypreError( error );
+        _matrix_initialized = false;
     }
 
     /*!
       \brief Set the matrix values.
+
+      The HYPRE matrix is persistent. Values set after the first call
+      overwrite the assembled matrix without reinitializing it. Call setup()
+      again after changing values.
+
       \param values The matrix entry values. For each entity over which the
       vector space is defined an entry for each stencil element is
       required. The order of the stencil elements is that same as that in the
@@ -299,40 +328,76 @@ class HypreStructuredSolver
             throw std::runtime_error(
                 "Number of matrix values does not match stencil size" );
 
-        // Spatial dimension.
-        const std::size_t num_space_dim = Array_t::num_space_dim;
-
         // Intialize the matrix for setting values.
-        auto error = HYPRE_StructMatrixInitialize( _A );
-        checkHypreError( error );
+        initializeMatrix();
 
         // Copy the matrix entries into HYPRE. The HYPRE layout is fixed as
         // layout-right.
         auto owned_space = values.layout()->indexSpace( Own(), Local() );
-        std::array<long, num_space_dim + 1> reorder_size;
-        for ( std::size_t d = 0; d < num_space_dim; ++d )
-        {
-            reorder_size[d] = owned_space.extent( d );
-        }
-        reorder_size.back() = _stencil_size;
-        IndexSpace<num_space_dim + 1> reorder_space( reorder_size );
-        auto a_values =
-            createView<HYPRE_Complex, Kokkos::LayoutRight, memory_space>(
-                "a_values", reorder_space );
         auto values_subv = createSubview( values.view(), owned_space );
-        Kokkos::deep_copy( a_values, values_subv );
 
         // Insert values into the HYPRE matrix.
         std::vector<HYPRE_Int> indices( _stencil_size );
         std::iota( indices.begin(), indices.end(), 0 );
-        error = HYPRE_StructMatrixSetBoxValues(
+        auto error = HYPRE_StructMatrixSetBoxValues(
             _A, _lower.data(), _upper.data(), indices.size(), indices.data(),
-            a_values.data() );
+            stageValues( values_subv, _matrix_buffer ) );
         checkHypreError( error );
         error = HYPRE_StructMatrixAssemble( _A );
         checkHypreError( error );
     }
 
+    /*!
+      \brief Update the values of a subset of the stencil entries.
+
+      Only the given entries are copied into the persistent HYPRE matrix.
+      The other entries keep the values from previous calls. Call setup()
+      again after changing values.
+
+      \param values The matrix entry values with an entry for each stencil
+      element as in setMatrixValues().
+      \param entries The indices of the stencil elements to update.
+    */
+    template <class Array_t>
+    void updateMatrixValues( const Array_t& values,
+                             const std::vector<int>& entries )
+    {
+        static_assert( is_array<Array_t>::value, "Must use an array" );
+        static_assert(
+            std::is_same<typename Array_t::memory_space, MemorySpace>::value,
+            "Array device type and solver device type are different." );
+
+        // This function is only valid for non-preconditioners.
+        if ( _is_preconditioner )
+            throw std::logic_error(
+                "Cannot call updateMatrixValues() on preconditioners" );
+
+        if ( values.layout()->dofsPerEntity() !=
+             static_cast<int>( _stencil_size ) )
+            throw std::runtime_error(
+                "Number of matrix values does not match stencil size" );
+
+        // Intialize the matrix for setting values.
+        initializeMatrix();
+
+        // Insert the values of each entry into the HYPRE matrix.
+        for ( auto e : entries )
+        {
+            if ( e < 0 || e >= static_cast<int>( _stencil_size ) )
+                throw std::runtime_error( "Stencil entry out of bounds" );
+            auto entry = createSubarray( values, e, e + 1 );
+            auto entry_subv = createSubview(
+                entry->view(), entry->layout()->indexSpace( Own(), Local() ) );
+            HYPRE_Int index = e;
+            auto error = HYPRE_StructMatrixSetBoxValues(
+                _A, _lower.data(), _upper.data(), 1, &index,
+                stageValues( entry_subv, _matrix_buffer ) );
+            checkHypreError( error );
+        }
+        auto error = HYPRE_StructMatrixAssemble( _A );
+        checkHypreError( error );
+    }
+
     //! Set convergence tolerance implementation.
     void setTolerance( const double tol ) { this->setToleranceImpl( tol ); }
 
@@ -404,46 +469,62 @@ class HypreStructuredSolver
             throw std::runtime_error(
                 "Structured solver only for scalar fields" );
 
-        // Spatial dimension.
-        const std::size_t num_space_dim = Array_t::num_space_dim;
+        auto owned_space = b.layout()->indexSpace( Own(), Local() );
+        solveSubviews( createSubview( b.view(), owned_space ),
+                       createSubview( x.view(), owned_space ) );
 
-        // Initialize the RHS.
-        auto error = HYPRE_StructVectorInitialize( _b );
-        checkHypreError( error );
+        Kokkos::Profiling::popRegion();
+    }
 
-        // Copy the RHS into HYPRE. The HYPRE layout is fixed as layout-right.
-        auto owned_space = b.layout()->indexSpace( Own(), Local() );
-        std::array<long, num_space_dim + 1> reorder_size;
-        for ( std::size_t d = 0; d < num_space_dim; ++d )
-        {
-            reorder_size[d] = owned_space.extent( d );
-        }
-        reorder_size.back() = 1;
-        IndexSpace<num_space_dim + 1> reorder_space( reorder_size );
-        auto vector_values =
-            createView<HYPRE_Complex, Kokkos::LayoutRight, memory_space>(
-                "vector_values", reorder_space );
-        auto b_subv = createSubview( b.view(), owned_space );
-        Kokkos::deep_copy( vector_values, b_subv );
-
-        // Insert b values into the HYPRE vector.
-        error = HYPRE_StructVectorSetBoxValues(
-            _b, _lower.data(), _upper.data(), vector_values.data() );
-        checkHypreError( error );
-        error = HYPRE_StructVectorAssemble( _b );
-        checkHypreError( error );
+    /*!
+      \brief Solve the problem AX = B for a block of right-hand sides.
 
-        // Solve the problem
-        this->solveImpl( _A, _b, _x );
+      Each degree-of-freedom of B is an independent right-hand side. The
+      systems are solved one after another with the same setup and HYPRE
+      vectors. The iteration count and residual norm are those of the last
+      system.
 
-        // Extract the solution from the LHS
-        error = HYPRE_StructVectorGetBoxValues(
-            _x, _lower.data(), _upper.data(), vector_values.data() );
-        checkHypreError( error );
+      \param b The forcing terms.
+      \param x The solutions. Must have the same number of
+      degrees-of-freedom per entity as b.
+    */
+    template <class Array_t>
+    void solveMultiple( const Array_t& b, Array_t& x )
+    {
+        Kokkos::Profiling::pushRegion(
+            "Cajita::HypreStructuredSolver::solveMultiple" );
 
-        // Copy the HYPRE solution to the LHS.
-        auto x_subv = createSubview( x.view(), owned_space );
-        Kokkos::deep_copy( x_subv, vector_values );
+        static_assert( is_array<Array_t>::value, "Must use an array" );
+        static_assert(
+            std::is_same<typename Array_t::entity_type, entity_type>::value,
+            "Array entity type mush match solver entity type" );
+        static_assert(
+            std::is_same<typename Array_t::memory_space, MemorySpace>::value,
+            "Array device type and solver device type are different." );
+
+        static_assert(
+            std::is_same<typename Array_t::value_type, value_type>::value,
+            "Array value type and solver value type are different." );
+
+        // This function is only valid for non-preconditioners.
+        if ( _is_preconditioner )
+            throw std::logic_error(
+                "Cannot call solveMultiple() on preconditioners" );
+
+        const int num_rhs = b.layout()->dofsPerEntity();
+        if ( x.layout()->dofsPerEntity() != num_rhs )
+            throw std::runtime_error(
+                "Number of LHS and RHS vectors does not match" );
+
+        // Solve each system.
+        for ( int n = 0; n < num_rhs; ++n )
+        {
+            auto b_n = createSubarray( b, n, n + 1 );
+            auto x_n = createSubarray( x, n, n + 1 );
+            auto owned_space = b_n->layout()->indexSpace( Own(), Local() );
+            solveSubviews( createSubview( b_n->view(), owned_space ),
+                           createSubview( x_n->view(), owned_space ) );
+        }
 
         Kokkos::Profiling::popRegion();
     }
@@ -508,6 +589,80 @@ class HypreStructuredSolver
         }
     }
 
+  private:
+    // Solve for the owned values of a single system.
+    template <class ViewB, class ViewX>
+    void solveSubviews( const ViewB& b_subv, const ViewX& x_subv )
+    {
+        // Copy the RHS into the persistent HYPRE vector. The HYPRE layout is
+        // fixed as layout-right.
+        auto error = HYPRE_StructVectorSetBoxValues(
+            _b, _lower.data(), _upper.data(),
+            stageValues( b_subv, _vector_buffer ) );
+        checkHypreError( error );
+        error = HYPRE_StructVectorAssemble( _b );
+        checkHypreError( error );
+
+        // Solve the problem
+        this->solveImpl( _A, _b, _x );
+
+        // Extract the solution from the LHS directly into the array if its
+        // layout matches.
+        auto x_values = Impl::hypreDirectPointer( x_subv );
+        error = HYPRE_StructVectorGetBoxValues(
+            _x, _lower.data(), _upper.data(),
+            x_values ? x_values : _vector_buffer.data() );
+        checkHypreError( error );
+
+        // Copy the HYPRE solution to the LHS.
+        if ( !x_values )
+            Kokkos::deep_copy( x_subv, stagingView( x_subv, _vector_buffer ) );
+    }
+
+    // Initialize the matrix the first time values are set.
+    void initializeMatrix()
+    {
+        if ( !_matrix_initialized )
+        {
+            auto error = HYPRE_StructMatrixInitialize( _A );
+            checkHypreError( error );
+            _matrix_initialized = true;
+        }
+    }
+
+    // Get a layout-right view of a staging buffer with the extents of a
+    // view.
+    template <class ViewType>
+    auto stagingView(
+        const ViewType& view,
+        const Kokkos::View<HYPRE_Complex*, memory_space>& buffer ) const
+    {
+        std::array<long, ViewType::rank> size;
+        for ( std::size_t r = 0; r < ViewType::rank; ++r )
+            size[r] = view.extent( r );
+        return createView<HYPRE_Complex, Kokkos::LayoutRight, memory_space>(
+            IndexSpace<ViewType::rank>( size ), buffer.data() );
+    }
+
+    // Get the values of a view in the HYPRE layout. Views that are already
+    // a contiguous layout-right block are used directly. Otherwise they are
+    // reordered into the staging buffer.
+    template <class ViewType>
+    HYPRE_Complex*
+    stageValues( const ViewType& view,
+                 Kokkos::View<HYPRE_Complex*, memory_space>& buffer )
+    {
+        auto values = Impl::hypreDirectPointer( view );
+        if ( values )
+            return values;
+        if ( buffer.size() < view.size() )
+            buffer = Kokkos::View<HYPRE_Complex*, memory_space>(
+                Kokkos::ViewAllocateWithoutInitializing( "hypre_values" ),
+                view.size() );
+        Kokkos::deep_copy( stagingView( view, buffer ), view );
+        return buffer.data();
+    }
+
   private:
     MPI_Comm _comm;
     bool _is_preconditioner;
@@ -519,6 +674,9 @@ class HypreStructuredSolver
     HYPRE_StructMatrix _A;
     HYPRE_StructVector _b;
     HYPRE_StructVector _x;
+    bool _matrix_initialized;
+    Kokkos::View<HYPRE_Complex*, memory_space> _vector_buffer;
+    Kokkos::View<HYPRE_Complex*, memory_space> _matrix_buffer;
     std::shared_ptr<HypreStructuredSolver<Scalar, EntityType, MemorySpace>>
         _preconditioner;
 };
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <string>
 
 namespace Cajita
@@ -215,6 +216,28 @@ createExecutionPolicy( const IndexSpace_t& index_space, const ExecutionSpace&,
         index_space.min(), index_space.max() );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a multi-dimensional execution policy over an index space with
+  the given number of indices per tile in each dimension.
+*/
+template <long N, class ExecutionSpace, std::size_t TileRank>
+Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<N>>
+createTiledExecutionPolicy( const IndexSpace<N>& index_space,
+                            const ExecutionSpace& exec_space,
+                            const Kokkos::Array<int, TileRank>& tile )
+{
+    static_assert( static_cast<std::size_t>( N ) == TileRank,
+                   "Tile and index space rank mismatch" );
+    static_assert( N > 1, "Tiled execution requires a rank of at least 2" );
+    using policy_type = Kokkos::MDRangePolicy<ExecutionSpace, Kokkos::Rank<N>>;
+    typename policy_type::tile_type tile_size;
+    for ( long d = 0; d < N; ++d )
+        tile_size[d] = tile[d];
+    return policy_type( exec_space, index_space.min(), index_space.max(),
+                        tile_size );
+}
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Given an index space create a view over the extent of that index
@@ -413,6 +436,25 @@ KOKKOS_INLINE_FUNCTION auto createSubview( const ViewType& view,
                             index_space.range( 3 ) );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Determine if the data of a view is a contiguous layout-right block
+  regardless of the layout type of the view (e.g. a subview of the owned
+  entities of an array without halo).
+*/
+template <class ViewType>
+bool isContiguousLayoutRight( const ViewType& view )
+{
+    std::size_t stride = 1;
+    for ( int r = ViewType::Rank - 1; r >= 0; --r )
+    {
+        if ( view.extent( r ) > 1 && view.stride( r ) != stride )
+            return false;
+        stride *= view.extent( r );
+    }
+    return true;
+}
+
 //---------------------------------------------------------------------------//
 /*!
   Given an N-dimensional index space append an additional dimension with the
@@ -457,6 +499,65 @@ IndexSpace<N + 1> appendDimension( const IndexSpace<N>& index_space,
     return IndexSpace<N + 1>( range_min, range_max );
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given an index space get the interior index space containing the
+  indices at least the given width away from every boundary of the space. If
+  the space is thinner than twice the width in a dimension the interior is
+  empty in that dimension.
+*/
+template <long N>
+IndexSpace<N> interiorIndexSpace( const IndexSpace<N>& index_space,
+                                  const long width )
+{
+    std::array<long, N> min;
+    std::array<long, N> max;
+    for ( long d = 0; d < N; ++d )
+    {
+        min[d] = std::min( index_space.min( d ) + width, index_space.max( d ) );
+        max[d] = std::max( index_space.max( d ) - width, min[d] );
+    }
+    return IndexSpace<N>( min, max );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Given an index space get the boundary slabs of the space: the
+  non-overlapping index spaces which together with interiorIndexSpace() of the
+  same width exactly cover the space.
+
+  Slabs 2*d and 2*d+1 are the low and high slabs in dimension d. They span the
+  interior in the dimensions before d and the full space in the dimensions
+  after d. Slabs may be empty.
+*/
+template <long N>
+Kokkos::Array<IndexSpace<N>, 2 * N>
+boundarySlabIndexSpaces( const IndexSpace<N>& index_space, const long width )
+{
+    auto interior = interiorIndexSpace( index_space, width );
+    Kokkos::Array<IndexSpace<N>, 2 * N> slabs;
+    for ( long d = 0; d < N; ++d )
+    {
+        std::array<long, N> min;
+        std::array<long, N> max;
+        for ( long dp = 0; dp < N; ++dp )
+        {
+            min[dp] = ( dp < d ) ? interior.min( dp ) : index_space.min( dp );
+            max[dp] = ( dp < d ) ? interior.max( dp ) : index_space.max( dp );
+        }
+
+        // Low slab.
+        max[d] = interior.min( d );
+        slabs[2 * d] = IndexSpace<N>( min, max );
+
+        // High slab.
+        min[d] = interior.max( d );
+        max[d] = index_space.max( d );
+        slabs[2 * d + 1] = IndexSpace<N>( min, max );
+    }
+    return slabs;
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
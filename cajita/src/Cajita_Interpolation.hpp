@@ -16,6 +16,10 @@
 #ifndef CAJITA_INTERPOLATION_HPP
 #define CAJITA_INTERPOLATION_HPP
 
+#include <Cabana_ParameterPack.hpp>
+#include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
+
 #include <Cajita_Array.hpp>
 #include <Cajita_Halo.hpp>
 #include <Cajita_LocalMesh.hpp>
@@ -26,7 +30,11 @@
 #include <Kokkos_ScatterView.hpp>
 
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace Cajita
 {
@@ -60,12 +68,12 @@ KOKKOS_INLINE_FUNCTION
 
     result = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                result += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                sd.s[Dim::K][k], 0 ) *
-                          sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            result += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                            sd.s[Dim::K][k], 0 ) *
+                      sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k];
+        } );
 }
 
 /*!
@@ -88,10 +96,11 @@ KOKKOS_INLINE_FUNCTION
 
     result = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             result += view( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) *
                       sd.w[Dim::I][i] * sd.w[Dim::J][j];
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -116,14 +125,14 @@ KOKKOS_INLINE_FUNCTION
     for ( int d = 0; d < 3; ++d )
         result[d] = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                for ( int d = 0; d < 3; ++d )
-                    result[d] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                       sd.s[Dim::K][k], d ) *
-                                 sd.w[Dim::I][i] * sd.w[Dim::J][j] *
-                                 sd.w[Dim::K][k];
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            for ( int d = 0; d < 3; ++d )
+                result[d] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                   sd.s[Dim::K][k], d ) *
+                             sd.w[Dim::I][i] * sd.w[Dim::J][j] *
+                             sd.w[Dim::K][k];
+        } );
 }
 
 /*!
@@ -147,11 +156,12 @@ KOKKOS_INLINE_FUNCTION
     for ( int d = 0; d < 2; ++d )
         result[d] = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             for ( int d = 0; d < 2; ++d )
                 result[d] += view( sd.s[Dim::I][i], sd.s[Dim::J][j], d ) *
                              sd.w[Dim::I][i] * sd.w[Dim::J][j];
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -178,25 +188,23 @@ KOKKOS_INLINE_FUNCTION
     for ( int d = 0; d < 3; ++d )
         result[d] = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-            {
-                result[Dim::I] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                        sd.s[Dim::K][k], 0 ) *
-                                  sd.g[Dim::I][i] * sd.w[Dim::J][j] *
-                                  sd.w[Dim::K][k];
-
-                result[Dim::J] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                        sd.s[Dim::K][k], 0 ) *
-                                  sd.w[Dim::I][i] * sd.g[Dim::J][j] *
-                                  sd.w[Dim::K][k];
-
-                result[Dim::K] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                        sd.s[Dim::K][k], 0 ) *
-                                  sd.w[Dim::I][i] * sd.w[Dim::J][j] *
-                                  sd.g[Dim::K][k];
-            }
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            result[Dim::I] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                    sd.s[Dim::K][k], 0 ) *
+                              sd.g[Dim::I][i] * sd.w[Dim::J][j] *
+                              sd.w[Dim::K][k];
+
+            result[Dim::J] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                    sd.s[Dim::K][k], 0 ) *
+                              sd.w[Dim::I][i] * sd.g[Dim::J][j] *
+                              sd.w[Dim::K][k];
+
+            result[Dim::K] += view( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                    sd.s[Dim::K][k], 0 ) *
+                              sd.w[Dim::I][i] * sd.w[Dim::J][j] *
+                              sd.g[Dim::K][k];
+        } );
 }
 
 /*!
@@ -222,15 +230,14 @@ KOKKOS_INLINE_FUNCTION
     for ( int d = 0; d < 2; ++d )
         result[d] = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-        {
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             result[Dim::I] += view( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) *
                               sd.g[Dim::I][i] * sd.w[Dim::J][j];
 
             result[Dim::J] += view( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) *
                               sd.w[Dim::I][i] * sd.g[Dim::J][j];
-        }
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -258,24 +265,22 @@ KOKKOS_INLINE_FUNCTION
         for ( int d1 = 0; d1 < 3; ++d1 )
             result[d0][d1] = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-            {
-                typename SplineDataType::scalar_type rg[3] = {
-                    sd.g[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k],
-                    sd.w[Dim::I][i] * sd.g[Dim::J][j] * sd.w[Dim::K][k],
-                    sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.g[Dim::K][k] };
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            typename SplineDataType::scalar_type rg[3] = {
+                sd.g[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k],
+                sd.w[Dim::I][i] * sd.g[Dim::J][j] * sd.w[Dim::K][k],
+                sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.g[Dim::K][k] };
 
-                for ( int d0 = 0; d0 < 3; ++d0 )
-                {
-                    auto mg = rg[d0];
-                    for ( int d1 = 0; d1 < 3; ++d1 )
-                        result[d0][d1] +=
-                            mg * view( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                       sd.s[Dim::K][k], d1 );
-                }
+            for ( int d0 = 0; d0 < 3; ++d0 )
+            {
+                auto mg = rg[d0];
+                for ( int d1 = 0; d1 < 3; ++d1 )
+                    result[d0][d1] +=
+                        mg * view( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                   sd.s[Dim::K][k], d1 );
             }
+        } );
 }
 
 /*!
@@ -302,9 +307,8 @@ KOKKOS_INLINE_FUNCTION
         for ( int d1 = 0; d1 < 2; ++d1 )
             result[d0][d1] = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-        {
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             typename SplineDataType::scalar_type rg[2] = {
                 sd.g[Dim::I][i] * sd.w[Dim::J][j],
                 sd.w[Dim::I][i] * sd.g[Dim::J][j] };
@@ -316,7 +320,7 @@ KOKKOS_INLINE_FUNCTION
                     result[d0][d1] +=
                         mg * view( sd.s[Dim::I][i], sd.s[Dim::J][j], d1 );
             }
-        }
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -343,21 +347,21 @@ KOKKOS_INLINE_FUNCTION
 
     result = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                result +=
-                    view( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                          Dim::I ) *
-                        sd.g[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k] +
-
-                    view( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                          Dim::J ) *
-                        sd.w[Dim::I][i] * sd.g[Dim::J][j] * sd.w[Dim::K][k] +
-
-                    view( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                          Dim::K ) *
-                        sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.g[Dim::K][k];
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            result +=
+                view( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                      Dim::I ) *
+                    sd.g[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k] +
+
+                view( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                      Dim::J ) *
+                    sd.w[Dim::I][i] * sd.g[Dim::J][j] * sd.w[Dim::K][k] +
+
+                view( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                      Dim::K ) *
+                    sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.g[Dim::K][k];
+        } );
 }
 
 /*!
@@ -383,14 +387,67 @@ KOKKOS_INLINE_FUNCTION
 
     result = 0.0;
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             result += view( sd.s[Dim::I][i], sd.s[Dim::J][j], Dim::I ) *
                           sd.g[Dim::I][i] * sd.w[Dim::J][j] +
 
                       view( sd.s[Dim::I][i], sd.s[Dim::J][j], Dim::J ) *
                           sd.w[Dim::I][i] * sd.g[Dim::J][j];
+        } );
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+// Team scratch tile with the access semantics of a grid view. The tile holds
+// a copy of a block of entities and its trailing stencil overlap and is
+// indexed with local grid indices.
+template <class ScratchViewType, std::size_t NumSpaceDim>
+struct ScratchTileView
+{
+    using value_type = typename ScratchViewType::value_type;
+
+    ScratchViewType _data;
+    Kokkos::Array<int, NumSpaceDim> _origin;
+    int _width;
+    int _num_comp;
+
+    KOKKOS_INLINE_FUNCTION
+    value_type operator()( const int i, const int j, const int k,
+                           const int l ) const
+    {
+        int n = ( i - _origin[Dim::I] ) +
+                _width * ( ( j - _origin[Dim::J] ) +
+                           _width * ( k - _origin[Dim::K] ) );
+        return _data( n * _num_comp + l );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    value_type operator()( const int i, const int j, const int l ) const
+    {
+        int n = ( i - _origin[Dim::I] ) + _width * ( j - _origin[Dim::J] );
+        return _data( n * _num_comp + l );
+    }
+};
+
+// Read a grid entry into a scratch tile. 3D specialization.
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<4 == ViewType::Rank,
+                                        typename ViewType::value_type>
+scratchTileLoad( const ViewType& view, const int ijk[3], const int l )
+{
+    return view( ijk[Dim::I], ijk[Dim::J], ijk[Dim::K], l );
+}
+
+// Read a grid entry into a scratch tile. 2D specialization.
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<3 == ViewType::Rank,
+                                        typename ViewType::value_type>
+scratchTileLoad( const ViewType& view, const int ij[2], const int l )
+{
+    return view( ij[Dim::I], ij[Dim::J], l );
 }
+//! \endcond
 
 //---------------------------------------------------------------------------//
 
@@ -424,6 +481,83 @@ struct is_scatter_view
 {
 };
 
+//---------------------------------------------------------------------------//
+//! \cond Impl
+// Reference to a team scratch tile entry. Each thread accumulates into its
+// own partial tile so contributions are added without atomics.
+template <class ValueType>
+struct ScratchTileReference
+{
+    ValueType* _ptr;
+
+    KOKKOS_INLINE_FUNCTION
+    void operator+=( const ValueType value ) const { *_ptr += value; }
+};
+
+// Team scratch tile with the access semantics of a scatter view. The tile
+// covers the interpolation stencils of all points binned into a block of
+// entities and is indexed with local grid indices.
+template <class ScratchViewType, std::size_t NumSpaceDim>
+struct ScratchTileScatterView
+{
+    using value_type = typename ScratchViewType::value_type;
+
+    ScratchViewType _data;
+    Kokkos::Array<int, NumSpaceDim> _origin;
+    int _width;
+    int _num_comp;
+
+    KOKKOS_INLINE_FUNCTION
+    const ScratchTileScatterView& access() const { return *this; }
+
+    KOKKOS_INLINE_FUNCTION
+    ScratchTileReference<value_type> operator()( const int i, const int j,
+                                                 const int k,
+                                                 const int l ) const
+    {
+        int n = ( i - _origin[Dim::I] ) +
+                _width * ( ( j - _origin[Dim::J] ) +
+                           _width * ( k - _origin[Dim::K] ) );
+        return { &_data( n * _num_comp + l ) };
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    ScratchTileReference<value_type> operator()( const int i, const int j,
+                                                 const int l ) const
+    {
+        int n = ( i - _origin[Dim::I] ) + _width * ( j - _origin[Dim::J] );
+        return { &_data( n * _num_comp + l ) };
+    }
+};
+
+template <class ScratchViewType, std::size_t NumSpaceDim>
+struct is_scatter_view_impl<
+    ScratchTileScatterView<ScratchViewType, NumSpaceDim>>
+    : public std::true_type
+{
+};
+
+// Add a scratch tile entry to the grid. Tiles written concurrently do not
+// overlap. 3D specialization.
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<4 == ViewType::Rank, void>
+scratchTileContribute( const ViewType& view, const int ijk[3], const int l,
+                       const typename ViewType::value_type value )
+{
+    view( ijk[Dim::I], ijk[Dim::J], ijk[Dim::K], l ) += value;
+}
+
+// Add a scratch tile entry to the grid. Tiles written concurrently do not
+// overlap. 2D specialization.
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<3 == ViewType::Rank, void>
+scratchTileContribute( const ViewType& view, const int ij[2], const int l,
+                       const typename ViewType::value_type value )
+{
+    view( ij[Dim::I], ij[Dim::J], l ) += value;
+}
+//! \endcond
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Interpolate a scalar value to the grid. 3D specialization.
@@ -446,12 +580,12 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                             0 ) += point_data * sd.w[Dim::I][i] *
-                                    sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                         0 ) += point_data * sd.w[Dim::I][i] *
+                                sd.w[Dim::J][j] * sd.w[Dim::K][k];
+        } );
 }
 
 /*!
@@ -475,10 +609,11 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) +=
                 point_data * sd.w[Dim::I][i] * sd.w[Dim::J][j];
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -504,14 +639,14 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-                for ( int d = 0; d < 3; ++d )
-                    view_access( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                 sd.s[Dim::K][k], d ) +=
-                        point_data[d] * sd.w[Dim::I][i] * sd.w[Dim::J][j] *
-                        sd.w[Dim::K][k];
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            for ( int d = 0; d < 3; ++d )
+                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                             sd.s[Dim::K][k], d ) +=
+                    point_data[d] * sd.w[Dim::I][i] * sd.w[Dim::J][j] *
+                    sd.w[Dim::K][k];
+        } );
 }
 
 /*!
@@ -536,11 +671,12 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             for ( int d = 0; d < 2; ++d )
                 view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], d ) +=
                     point_data[d] * sd.w[Dim::I][i] * sd.w[Dim::J][j];
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -566,22 +702,20 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-            {
-                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                             Dim::I ) += point_data * sd.g[Dim::I][i] *
-                                         sd.w[Dim::J][j] * sd.w[Dim::K][k];
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                         Dim::I ) += point_data * sd.g[Dim::I][i] *
+                                     sd.w[Dim::J][j] * sd.w[Dim::K][k];
 
-                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                             Dim::J ) += point_data * sd.w[Dim::I][i] *
-                                         sd.g[Dim::J][j] * sd.w[Dim::K][k];
+            view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                         Dim::J ) += point_data * sd.w[Dim::I][i] *
+                                     sd.g[Dim::J][j] * sd.w[Dim::K][k];
 
-                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                             Dim::K ) += point_data * sd.w[Dim::I][i] *
-                                         sd.w[Dim::J][j] * sd.g[Dim::K][k];
-            }
+            view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                         Dim::K ) += point_data * sd.w[Dim::I][i] *
+                                     sd.w[Dim::J][j] * sd.g[Dim::K][k];
+        } );
 }
 
 /*!
@@ -606,15 +740,14 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-        {
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], Dim::I ) +=
                 point_data * sd.g[Dim::I][i] * sd.w[Dim::J][j];
 
             view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], Dim::J ) +=
                 point_data * sd.w[Dim::I][i] * sd.g[Dim::J][j];
-        }
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -643,22 +776,20 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-            {
-                PointDataType result = point_data[Dim::I] * sd.g[Dim::I][i] *
-                                           sd.w[Dim::J][j] * sd.w[Dim::K][k] +
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            PointDataType result = point_data[Dim::I] * sd.g[Dim::I][i] *
+                                       sd.w[Dim::J][j] * sd.w[Dim::K][k] +
 
-                                       point_data[Dim::J] * sd.w[Dim::I][i] *
-                                           sd.g[Dim::J][j] * sd.w[Dim::K][k] +
+                                   point_data[Dim::J] * sd.w[Dim::I][i] *
+                                       sd.g[Dim::J][j] * sd.w[Dim::K][k] +
 
-                                       point_data[Dim::K] * sd.w[Dim::I][i] *
-                                           sd.w[Dim::J][j] * sd.g[Dim::K][k];
+                                   point_data[Dim::K] * sd.w[Dim::I][i] *
+                                       sd.w[Dim::J][j] * sd.g[Dim::K][k];
 
-                view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
-                             0 ) += result;
-            }
+            view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], sd.s[Dim::K][k],
+                         0 ) += result;
+        } );
 }
 
 /*!
@@ -686,16 +817,15 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-        {
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             PointDataType result =
                 point_data[Dim::I] * sd.g[Dim::I][i] * sd.w[Dim::J][j] +
 
                 point_data[Dim::J] * sd.w[Dim::I][i] * sd.g[Dim::J][j];
 
             view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], 0 ) += result;
-        }
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -724,23 +854,21 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-            for ( int k = 0; k < SplineDataType::num_knot; ++k )
-            {
-                typename SplineDataType::scalar_type rg[3] = {
-                    sd.g[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k],
-                    sd.w[Dim::I][i] * sd.g[Dim::J][j] * sd.w[Dim::K][k],
-                    sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.g[Dim::K][k] };
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j, const int k ) {
+            typename SplineDataType::scalar_type rg[3] = {
+                sd.g[Dim::I][i] * sd.w[Dim::J][j] * sd.w[Dim::K][k],
+                sd.w[Dim::I][i] * sd.g[Dim::J][j] * sd.w[Dim::K][k],
+                sd.w[Dim::I][i] * sd.w[Dim::J][j] * sd.g[Dim::K][k] };
 
-                for ( int d1 = 0; d1 < 3; ++d1 )
-                {
-                    for ( int d0 = 0; d0 < 3; ++d0 )
-                        view_access( sd.s[Dim::I][i], sd.s[Dim::J][j],
-                                     sd.s[Dim::K][k], d0 ) +=
-                            rg[d1] * point_data[d0][d1];
-                }
+            for ( int d1 = 0; d1 < 3; ++d1 )
+            {
+                for ( int d0 = 0; d0 < 3; ++d0 )
+                    view_access( sd.s[Dim::I][i], sd.s[Dim::J][j],
+                                 sd.s[Dim::K][k], d0 ) +=
+                        rg[d1] * point_data[d0][d1];
             }
+        } );
 }
 
 /*!
@@ -768,9 +896,8 @@ KOKKOS_INLINE_FUNCTION
                    "P2G requires a Kokkos::ScatterView" );
     auto view_access = view.access();
 
-    for ( int i = 0; i < SplineDataType::num_knot; ++i )
-        for ( int j = 0; j < SplineDataType::num_knot; ++j )
-        {
+    splineStencilLoop<SplineDataType>(
+        [&]( const int i, const int j ) {
             typename SplineDataType::scalar_type rg[2] = {
                 sd.g[Dim::I][i] * sd.w[Dim::J][j],
                 sd.w[Dim::I][i] * sd.g[Dim::J][j] };
@@ -781,7 +908,7 @@ KOKKOS_INLINE_FUNCTION
                     view_access( sd.s[Dim::I][i], sd.s[Dim::J][j], d0 ) +=
                         rg[d1] * point_data[d0][d1];
             }
-        }
+        } );
 }
 
 //---------------------------------------------------------------------------//
@@ -810,6 +937,8 @@ KOKKOS_INLINE_FUNCTION
 
   \tparam NumSpaceDim The spatial dimension of the mesh.
 
+  \tparam MeshType The mesh type. Either a uniform or a non-uniform mesh.
+
   \tparam EntityType The entitytype to which the points will interpolate.
 
   \tparam SplineOrder The order of spline interpolation to use.
@@ -838,16 +967,17 @@ KOKKOS_INLINE_FUNCTION
 */
 template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
           class MeshScalar, class EntityType, int SplineOrder,
-          std::size_t NumSpaceDim, class DeviceType, class... ArrayParams>
+          std::size_t NumSpaceDim, template <class, std::size_t> class MeshType,
+          class DeviceType, class... ArrayParams>
 void g2p(
-    const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+    const Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
                 ArrayParams...>& array,
     const Halo<DeviceType>& halo, const PointCoordinates& points,
     const std::size_t num_point, Spline<SplineOrder>,
     const PointEvalFunctor& functor )
 {
     using array_type =
-        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+        Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
               ArrayParams...>;
     static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
                                 typename array_type::memory_space>::value,
@@ -889,137 +1019,759 @@ void g2p(
 
 //---------------------------------------------------------------------------//
 /*!
-  \brief Grid-to-point scalar value functor.
+  \brief Global Grid-to-Point interpolation with cached spline data.
 
-  Interpolates a scalar function from entities to points with a given
-  multiplier such that:
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
 
-  f_p = multiplier * \\sum_{ijk} weight_{pijk} * f_{ijk}
-*/
-template <class ViewType>
-struct ScalarValueG2P
-{
-    //! Scalar value type.
-    using value_type = typename ViewType::value_type;
+  \tparam ArrayScalar The scalar type used for the interpolated data.
 
-    //! Spline evaluation locations.
-    ViewType _x;
-    //! Scalar multiplier.
-    value_type _multiplier;
+  \tparam MeshScalar The scalar type used for the geometry/interpolation data.
 
-    //! Constructor
-    ScalarValueG2P( const ViewType& x, const value_type multiplier )
-        : _x( x )
-        , _multiplier( multiplier )
-    {
-        static_assert( 1 == ViewType::Rank, "View must be of scalars" );
-    }
+  \tparam NumSpaceDim The spatial dimension of the mesh.
 
-    //! Apply spline interplation.
-    template <class SplineDataType, class GridViewType>
-    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
-                                            const int p,
-                                            const GridViewType& view ) const
-    {
-        value_type result;
-        G2P::value( view, sd, result );
-        _x( p ) += _multiplier * result;
-    }
-};
+  \tparam EntityType The entitytype to which the points will interpolate.
 
-//! Creation function for grid-to-point with scalar value.
-template <class ViewType>
-ScalarValueG2P<ViewType>
-createScalarValueG2P( const ViewType& x,
-                      const typename ViewType::value_type& multiplier )
-{
-    return ScalarValueG2P<ViewType>( x, multiplier );
-}
+  \tparam SplineDataType The cached spline data type.
 
-//---------------------------------------------------------------------------//
-/*!
-  \brief Grid-to-point vector value functor.
+  \tparam DeviceType The device type to use for interplation
 
-  Interpolates a vector function from entities to points with a given
-  multiplier such that:
+  \tparam MemorySpace The memory space of the halo.
 
-  f_{pd} = multiplier * \\sum_{ijk} weight_{pijk} * f_{ijkd}
+  \tparam ArrayParams Parameters for the array type.
+
+  \param array The grid array from which the point data will be interpolated.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to gather the array data before interpolation.
+
+  \param cache The spline data of the points over which to perform the
+  interpolation.
+
+  \param functor A functor that interpolates from a given entity to a given
+  point.
 */
-template <class ViewType>
-struct VectorValueG2P
+template <class PointEvalFunctor, class ArrayScalar, class MeshScalar,
+          class EntityType, std::size_t NumSpaceDim, class SplineDataType,
+          class DeviceType, class MemorySpace, class... ArrayParams>
+void g2p(
+    const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+    const Halo<MemorySpace>& halo,
+    const SplineDataCache<SplineDataType, DeviceType>& cache,
+    const PointEvalFunctor& functor )
 {
-    //! Scalar value type.
-    using value_type = typename ViewType::value_type;
+    static_assert(
+        std::is_same<typename SplineDataType::entity_type, EntityType>::value,
+        "Mismatching cache/array entity type." );
+    static_assert( SplineDataType::num_space_dim == NumSpaceDim,
+                   "Mismatching cache/array dimension." );
+    static_assert(
+        std::is_same<typename Halo<MemorySpace>::memory_space,
+                     typename DeviceType::memory_space>::value,
+        "Mismatching cache/array memory space." );
 
-    //! Spline evaluation locations.
-    ViewType _x;
-    //! Scalar multiplier.
-    value_type _multiplier;
+    using execution_space = typename DeviceType::execution_space;
 
-    //! Constructor
-    VectorValueG2P( const ViewType& x, const value_type multiplier )
-        : _x( x )
-        , _multiplier( multiplier )
-    {
-        static_assert( 2 == ViewType::Rank, "View must be of vectors" );
-    }
+    // Gather data into the halo before interpolating.
+    halo.gather( execution_space(), array );
 
-    //! Apply spline interplation.
-    template <class SplineDataType, class GridViewType>
-    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
-                                            const int p,
-                                            const GridViewType& view ) const
-    {
-        value_type result[SplineDataType::num_space_dim];
-        G2P::value( view, sd, result );
-        for ( std::size_t d = 0; d < SplineDataType::num_space_dim; ++d )
-            _x( p, d ) += _multiplier * result[d];
-    }
-};
+    // Get a view of the array data.
+    auto array_view = array.view();
 
-//! Creation function for grid-to-point with vector value.
-template <class ViewType>
-VectorValueG2P<ViewType>
-createVectorValueG2P( const ViewType& x,
-                      const typename ViewType::value_type& multiplier )
-{
-    return VectorValueG2P<ViewType>( x, multiplier );
+    // Loop over points and interpolate from the grid.
+    Kokkos::parallel_for(
+        "g2p_cached", Kokkos::RangePolicy<execution_space>( 0, cache.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Load the local spline data.
+            SplineDataType sd;
+            cache.load( p, sd );
+
+            // Evaluate the functor.
+            functor( sd, p, array_view );
+        } );
 }
 
+//---------------------------------------------------------------------------//
+//! Interpolation tag: batched spline evaluation over the SoA lanes of points.
+struct BatchedSplineTag
+{
+};
+
 //---------------------------------------------------------------------------//
 /*!
-  \brief Grid-to-point scalar gradient functor.
+  \brief Global Grid-to-Point interpolation with batched spline evaluation.
 
-  Interpolates the gradient of a scalar function from entities to points with
-  a given multiplier such that:
+  Each thread handles one SoA of the point AoSoA. The spline data of all the
+  points in the SoA is evaluated together with the lanes innermost so the
+  weight computations vectorize, then the functor is applied to each point.
+  This targets host execution spaces where the per-point weight evaluation
+  dominates the interpolation cost.
 
-  f_{pd} = multiplier * \\sum_{ijk} grad_weight_{pijkd} * f_{ijk}
-*/
-template <class ViewType>
-struct ScalarGradientG2P
-{
-    //! Scalar value type.
-    using value_type = typename ViewType::value_type;
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
 
-    //! Spline evaluation locations.
-    ViewType _x;
-    //! Scalar multiplier.
-    value_type _multiplier;
+  \tparam PointCoordinates Cabana slice type containing the point
+  coordinates.
 
-    //! Constructor
-    ScalarGradientG2P( const ViewType& x, const value_type multiplier )
-        : _x( x )
-        , _multiplier( multiplier )
-    {
-        static_assert( 2 == ViewType::Rank, "View must be of vectors" );
-    }
+  \tparam ArrayScalar The scalar type used for the interpolated data.
 
-    //! Apply spline interplation.
-    template <class SplineDataType, class GridViewType>
-    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
-                                            const int p,
-                                            const GridViewType& view ) const
-    {
+  \tparam MeshScalar The scalar type used for the geometry/interpolation data.
+
+  \tparam NumSpaceDim The spatial dimension of the mesh.
+
+  \tparam EntityType The entitytype to which the points will interpolate.
+
+  \tparam SplineOrder The order of spline interpolation to use.
+
+  \tparam DeviceType The device type to use for interplation
+
+  \tparam ArrayParams Parameters for the array type.
+
+  \param array The grid array from which the point data will be interpolated.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to gather the array data before interpolation.
+
+  \param points The slice of point coordinates. The subset of indices in each
+  point's interpolation stencil must be contained within the local grid that
+  will be used for the interpolation
+
+  \param num_point The number of points.
+
+  \param functor A functor that interpolates from a given entity to a given
+  point.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
+          class MeshScalar, class EntityType, int SplineOrder,
+          std::size_t NumSpaceDim, class DeviceType, class... ArrayParams>
+void g2p(
+    const Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+    const Halo<DeviceType>& halo, const PointCoordinates& points,
+    const std::size_t num_point, Spline<SplineOrder>,
+    const PointEvalFunctor& functor, BatchedSplineTag )
+{
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+    static_assert( Cabana::is_slice<PointCoordinates>::value,
+                   "Batched interpolation requires a slice of points" );
+
+    using execution_space = typename DeviceType::execution_space;
+    constexpr int vector_length = PointCoordinates::vector_length;
+    using sd_type =
+        SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+    using batch_type = SplineDataBatch<sd_type, vector_length>;
+
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
+
+    // Gather data into the halo before interpolating.
+    halo.gather( execution_space(), array );
+
+    // Get a view of the array data.
+    auto array_view = array.view();
+
+    // Loop over the point SoAs and interpolate from the grid.
+    int num_point_soa = ( num_point + vector_length - 1 ) / vector_length;
+    int last_num_lane = num_point - ( num_point_soa - 1 ) * vector_length;
+    Kokkos::parallel_for(
+        "g2p_batched", Kokkos::RangePolicy<execution_space>( 0, num_point_soa ),
+        KOKKOS_LAMBDA( const int s ) {
+            int num_lane =
+                ( s == num_point_soa - 1 ) ? last_num_lane : vector_length;
+
+            // Get the point coordinates.
+            MeshScalar px[NumSpaceDim][vector_length];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                for ( int a = 0; a < num_lane; ++a )
+                    px[d][a] = points.access( s, a, d );
+
+            // Evaluate the spline data of all the points in the SoA.
+            batch_type batch;
+            evaluateSpline( local_mesh, px, num_lane, batch );
+
+            // Evaluate the functor.
+            for ( int a = 0; a < num_lane; ++a )
+            {
+                sd_type sd;
+                batch.load( a, sd );
+                functor( sd, s * vector_length + a, array_view );
+            }
+        } );
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Key each point by the block of entities containing the start of its
+// interpolation stencil. Blocks are numbered with the first dimension
+// fastest.
+template <class DeviceType, class MeshScalar, class LocalMeshType,
+          class PointCoordinates, int SplineOrder, class EntityType,
+          std::size_t NumSpaceDim>
+Kokkos::View<int*, DeviceType>
+pointTileKeys( const LocalMeshType& local_mesh, const PointCoordinates& points,
+               const std::size_t num_point, Spline<SplineOrder>, EntityType,
+               const Kokkos::Array<int, NumSpaceDim>& num_tile,
+               const int tile_width )
+{
+    using execution_space = typename DeviceType::execution_space;
+
+    Kokkos::View<int*, DeviceType> tile_keys(
+        Kokkos::ViewAllocateWithoutInitializing( "point_tile_keys" ),
+        num_point );
+    Kokkos::parallel_for(
+        "point_tile_keys", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            MeshScalar px[NumSpaceDim];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Only the stencil is needed to locate the point.
+            using sd_type =
+                SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType,
+                           SplineDataMemberTypes<SplineLogicalPosition>>;
+            sd_type sd;
+            evaluateSpline( local_mesh, px, sd );
+
+            int key = 0;
+            for ( int d = static_cast<int>( NumSpaceDim ) - 1; d >= 0; --d )
+                key = key * num_tile[d] + sd.s[d][0] / tile_width;
+            tile_keys( p ) = key;
+        } );
+    return tile_keys;
+}
+
+// Check that a scratch tile of the given size in bytes fits in the level 0
+// team scratch of a policy. Large tile widths and high order splines can
+// otherwise fail at kernel launch.
+template <class PolicyType>
+void checkTileScratchSize( const std::size_t tile_bytes, const int tile_width,
+                           const int scratch_width )
+{
+    const std::size_t max_bytes = PolicyType::scratch_size_max( 0 );
+    if ( tile_bytes > max_bytes )
+        throw std::runtime_error(
+            "Scratch tile of " + std::to_string( tile_bytes ) +
+            " bytes (tile width " + std::to_string( tile_width ) +
+            ", stencil-padded width " + std::to_string( scratch_width ) +
+            ") exceeds the maximum level 0 team scratch size of " +
+            std::to_string( max_bytes ) + " bytes" );
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+//! Grid-to-point evaluation tag: cell-sorted team scratch grid blocks.
+struct SortedG2PTag
+{
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Grid-to-Point interpolation with cell-sorted evaluation.
+
+  Points are binned by the block of entities containing the start of their
+  interpolation stencil. Each team copies one block and its stencil overlap
+  into a scratch tile once and interpolates all the points of the block from
+  the tile, replacing the redundant grid reads of neighboring points with one
+  read per tile entry.
+
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \tparam ArrayScalar The scalar type used for the interpolated data.
+
+  \tparam MeshScalar The scalar type used for the geometry/interpolation data.
+
+  \tparam NumSpaceDim The spatial dimension of the mesh.
+
+  \tparam MeshType The mesh type. Either a uniform or a non-uniform mesh.
+
+  \tparam EntityType The entitytype to which the points will interpolate.
+
+  \tparam SplineOrder The order of spline interpolation to use.
+
+  \tparam DeviceType The device type to use for interplation
+
+  \tparam ArrayParams Parameters for the array type.
+
+  \param array The grid array from which the point data will be interpolated.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to gather the array data before interpolation.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The subset of indices in each point's interpolation
+  stencil must be contained within the local grid that will be used for the
+  interpolation
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param functor A functor that interpolates from a given entity to a given
+  point.
+
+  \param tile_width The number of entities per dimension in each block.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
+          class MeshScalar, class EntityType, int SplineOrder,
+          std::size_t NumSpaceDim, template <class, std::size_t> class MeshType,
+          class DeviceType, class... ArrayParams>
+void g2p(
+    const Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+    const Halo<DeviceType>& halo, const PointCoordinates& points,
+    const std::size_t num_point, Spline<SplineOrder>,
+    const PointEvalFunctor& functor, SortedG2PTag, const int tile_width = 4 )
+{
+    using array_type =
+        Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+
+    using execution_space = typename DeviceType::execution_space;
+
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
+
+    // Gather data into the halo before interpolating.
+    halo.gather( execution_space(), array );
+
+    // Divide the local entities into blocks.
+    auto array_view = array.view();
+    Kokkos::Array<int, NumSpaceDim> num_tile;
+    int total_tile = 1;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        num_tile[d] = ( array_view.extent( d ) + tile_width - 1 ) / tile_width;
+        total_tile *= num_tile[d];
+    }
+
+    // Bin the points with a single bin for each block.
+    auto tile_keys = Impl::pointTileKeys<DeviceType, MeshScalar>(
+        local_mesh, points, num_point, Spline<SplineOrder>(), EntityType(),
+        num_tile, tile_width );
+    Kokkos::BinOp1D<decltype( tile_keys )> comp( total_tile, 0, total_tile );
+    auto bin_data = Cabana::binByKeyWithComparator( tile_keys, comp );
+
+    // Each scratch tile holds a block and the trailing stencil overlap.
+    using sd_type =
+        SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+    using scratch_view_type =
+        Kokkos::View<ArrayScalar*,
+                     typename execution_space::scratch_memory_space,
+                     Kokkos::MemoryUnmanaged>;
+    using tile_view_type = G2P::ScratchTileView<scratch_view_type, NumSpaceDim>;
+    const int scratch_width = tile_width + sd_type::num_knot - 1;
+    const int num_comp = array_view.extent( NumSpaceDim );
+    int scratch_size = num_comp;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        scratch_size *= scratch_width;
+
+    // Loop over blocks and interpolate their points from the grid.
+    using policy_type = Kokkos::TeamPolicy<execution_space>;
+    const std::size_t tile_bytes =
+        scratch_view_type::shmem_size( scratch_size );
+    Impl::checkTileScratchSize<policy_type>( tile_bytes, tile_width,
+                                             scratch_width );
+    policy_type policy( total_tile, Kokkos::AUTO );
+    policy.set_scratch_size( 0, Kokkos::PerTeam( tile_bytes ) );
+    Kokkos::parallel_for(
+        "g2p_sorted", policy,
+        KOKKOS_LAMBDA( const typename policy_type::member_type& team ) {
+            const int tile = team.league_rank();
+            const int num_in_tile = bin_data.binSize( tile );
+            if ( 0 == num_in_tile )
+                return;
+
+            // Locate the tile in the local grid.
+            tile_view_type tile_view;
+            tile_view._data =
+                scratch_view_type( team.team_scratch( 0 ), scratch_size );
+            tile_view._width = scratch_width;
+            tile_view._num_comp = num_comp;
+            int t = tile;
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                tile_view._origin[d] = ( t % num_tile[d] ) * tile_width;
+                t /= num_tile[d];
+            }
+
+            // Load the block and its stencil overlap from the grid.
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, scratch_size ),
+                [&]( const int n ) {
+                    int ijk[NumSpaceDim];
+                    int e = n / num_comp;
+                    bool in_grid = true;
+                    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                    {
+                        ijk[d] = tile_view._origin[d] + e % scratch_width;
+                        e /= scratch_width;
+                        in_grid = in_grid &&
+                                  ijk[d] < static_cast<int>(
+                                               array_view.extent( d ) );
+                    }
+                    tile_view._data( n ) =
+                        in_grid ? G2P::scratchTileLoad( array_view, ijk,
+                                                        n % num_comp )
+                                : ArrayScalar( 0 );
+                } );
+            team.team_barrier();
+
+            // Interpolate the points of the block from the tile.
+            const auto offset = bin_data.binOffset( tile );
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, num_in_tile ),
+                [&]( const int n ) {
+                    const int p = bin_data.permutation( offset + n );
+
+                    // Get the point coordinates.
+                    MeshScalar px[NumSpaceDim];
+                    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                    {
+                        px[d] = points( p, d );
+                    }
+
+                    // Create the local spline data.
+                    sd_type sd;
+                    evaluateSpline( local_mesh, px, sd );
+
+                    // Evaluate the functor.
+                    functor( sd, p, tile_view );
+                } );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Apply each interpolation functor in a pack to the grid view with the same
+// index.
+template <class FunctorPack, class SplineDataType, class ViewPack>
+KOKKOS_INLINE_FUNCTION void
+applyInterpolationFunctors( const FunctorPack& functors,
+                            const SplineDataType& sd, const int p,
+                            const ViewPack& views,
+                            std::integral_constant<std::size_t, 0> )
+{
+    Cabana::get<0>( functors )( sd, p, Cabana::get<0>( views ) );
+}
+
+template <class FunctorPack, class SplineDataType, class ViewPack,
+          std::size_t N>
+KOKKOS_INLINE_FUNCTION void
+applyInterpolationFunctors( const FunctorPack& functors,
+                            const SplineDataType& sd, const int p,
+                            const ViewPack& views,
+                            std::integral_constant<std::size_t, N> )
+{
+    Cabana::get<N>( functors )( sd, p, Cabana::get<N>( views ) );
+    applyInterpolationFunctors( functors, sd, p, views,
+                                std::integral_constant<std::size_t, N - 1>() );
+}
+
+// Contribute each scatter view in a pack to the view with the same index.
+template <class ViewPack, class ScatterViewPack, std::size_t... Indices>
+void contributeScatterViews( ViewPack& views, const ScatterViewPack& svs,
+                             std::index_sequence<Indices...> )
+{
+    int dummy[] = { 0, ( Kokkos::Experimental::contribute(
+                             Cabana::get<Indices>( views ),
+                             Cabana::get<Indices>( svs ) ),
+                         0 )... };
+    (void)dummy;
+}
+
+// Check that every value in a boolean pack is true.
+template <bool... Values>
+struct all_true;
+
+template <>
+struct all_true<> : std::true_type
+{
+};
+
+template <bool Value, bool... Values>
+struct all_true<Value, Values...>
+    : std::integral_constant<bool, Value && all_true<Values...>::value>
+{
+};
+
+// Check that a set of arrays can share spline data and a halo.
+template <class DeviceType, class... ArrayTypes>
+struct FusedInterpolationTraits
+{
+    using array_type =
+        typename Cabana::PackTypeAtIndex<0, ArrayTypes...>::type;
+    using entity_type = typename array_type::entity_type;
+    using mesh_type = typename array_type::mesh_type;
+    using scalar_type = typename mesh_type::scalar_type;
+
+    static_assert(
+        all_true<std::is_same<typename ArrayTypes::entity_type,
+                              entity_type>::value...>::value,
+        "Fused interpolation requires a common entity type" );
+    static_assert( all_true<std::is_same<typename ArrayTypes::mesh_type,
+                                         mesh_type>::value...>::value,
+                   "Fused interpolation requires a common mesh type" );
+    static_assert(
+        all_true<std::is_same<typename Halo<DeviceType>::memory_space,
+                              typename ArrayTypes::memory_space>::value...>::
+            value,
+        "Mismatching points/array memory space." );
+};
+
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Fused global Grid-to-Point interpolation of several fields.
+
+  All arrays are gathered with a single halo exchange and the spline data of
+  each point is evaluated once and shared by every functor.
+
+  \tparam PointEvalFunctors Functor types used to evaluate the interpolated
+  data for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \tparam SplineOrder The order of spline interpolation to use.
+
+  \tparam DeviceType The device type to use for interplation
+
+  \tparam ArrayTypes The grid array types. All arrays must share an entity
+  type and a mesh type.
+
+  \param halo The halo associated with all of the grid arrays. This halo will
+  be used to gather the array data before interpolation and must have been
+  created with the same arrays in the same order.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The subset of indices in each point's interpolation
+  stencil must be contained within the local grid that will be used for the
+  interpolation
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param functors The grid-to-point functors, created with
+  Cabana::makeParameterPack(). The Nth functor interpolates from the Nth array.
+
+  \param arrays The grid arrays from which the point data will be
+  interpolated.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class... PointEvalFunctors, class PointCoordinates, int SplineOrder,
+          class DeviceType, class... ArrayTypes>
+void g2p( const Halo<DeviceType>& halo, const PointCoordinates& points,
+          const std::size_t num_point, Spline<SplineOrder>,
+          const Cabana::ParameterPack<PointEvalFunctors...>& functors,
+          const ArrayTypes&... arrays )
+{
+    static_assert( sizeof...( PointEvalFunctors ) == sizeof...( ArrayTypes ),
+                   "Each array requires a grid-to-point functor" );
+    using traits = Impl::FusedInterpolationTraits<DeviceType, ArrayTypes...>;
+    using mesh_type = typename traits::mesh_type;
+    using entity_type = typename traits::entity_type;
+    using scalar_type = typename traits::scalar_type;
+
+    using execution_space = typename DeviceType::execution_space;
+
+    // Create the local mesh.
+    const auto& array = std::get<0>( std::forward_as_tuple( arrays... ) );
+    auto local_mesh =
+        createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
+
+    // Gather data for all arrays into the halo before interpolating.
+    halo.gather( execution_space(), arrays... );
+
+    // Get views of the array data.
+    auto array_views = Cabana::makeParameterPack( arrays.view()... );
+
+    // Loop over points and interpolate from the grid.
+    Kokkos::parallel_for(
+        "g2p_fused", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Get the point coordinates.
+            scalar_type px[mesh_type::num_space_dim];
+            for ( std::size_t d = 0; d < mesh_type::num_space_dim; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Create the local spline data once for all functors.
+            using sd_type =
+                SplineData<scalar_type, SplineOrder, mesh_type::num_space_dim,
+                           entity_type>;
+            sd_type sd;
+            evaluateSpline( local_mesh, px, sd );
+
+            // Evaluate the functors.
+            Impl::applyInterpolationFunctors(
+                functors, sd, p, array_views,
+                std::integral_constant<std::size_t,
+                                       sizeof...( ArrayTypes ) - 1>() );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Grid-to-point scalar value functor.
+
+  Interpolates a scalar function from entities to points with a given
+  multiplier such that:
+
+  f_p = multiplier * \\sum_{ijk} weight_{pijk} * f_{ijk}
+*/
+template <class ViewType>
+struct ScalarValueG2P
+{
+    //! Scalar value type.
+    using value_type = typename ViewType::value_type;
+
+    //! Spline evaluation locations.
+    ViewType _x;
+    //! Scalar multiplier.
+    value_type _multiplier;
+
+    //! Constructor
+    ScalarValueG2P( const ViewType& x, const value_type multiplier )
+        : _x( x )
+        , _multiplier( multiplier )
+    {
+        static_assert( 1 == ViewType::Rank, "View must be of scalars" );
+    }
+
+    //! Apply spline interplation.
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
+        value_type result;
+        G2P::value( view, sd, result );
+        _x( p ) += _multiplier * result;
+    }
+};
+
+//! Creation function for grid-to-point with scalar value.
+template <class ViewType>
+ScalarValueG2P<ViewType>
+createScalarValueG2P( const ViewType& x,
+                      const typename ViewType::value_type& multiplier )
+{
+    return ScalarValueG2P<ViewType>( x, multiplier );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Grid-to-point vector value functor.
+
+  Interpolates a vector function from entities to points with a given
+  multiplier such that:
+
+  f_{pd} = multiplier * \\sum_{ijk} weight_{pijk} * f_{ijkd}
+*/
+template <class ViewType>
+struct VectorValueG2P
+{
+    //! Scalar value type.
+    using value_type = typename ViewType::value_type;
+
+    //! Spline evaluation locations.
+    ViewType _x;
+    //! Scalar multiplier.
+    value_type _multiplier;
+
+    //! Constructor
+    VectorValueG2P( const ViewType& x, const value_type multiplier )
+        : _x( x )
+        , _multiplier( multiplier )
+    {
+        static_assert( 2 == ViewType::Rank, "View must be of vectors" );
+    }
+
+    //! Apply spline interplation.
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
+        value_type result[SplineDataType::num_space_dim];
+        G2P::value( view, sd, result );
+        for ( std::size_t d = 0; d < SplineDataType::num_space_dim; ++d )
+            _x( p, d ) += _multiplier * result[d];
+    }
+};
+
+//! Creation function for grid-to-point with vector value.
+template <class ViewType>
+VectorValueG2P<ViewType>
+createVectorValueG2P( const ViewType& x,
+                      const typename ViewType::value_type& multiplier )
+{
+    return VectorValueG2P<ViewType>( x, multiplier );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Grid-to-point scalar gradient functor.
+
+  Interpolates the gradient of a scalar function from entities to points with
+  a given multiplier such that:
+
+  f_{pd} = multiplier * \\sum_{ijk} grad_weight_{pijkd} * f_{ijk}
+*/
+template <class ViewType>
+struct ScalarGradientG2P
+{
+    //! Scalar value type.
+    using value_type = typename ViewType::value_type;
+
+    //! Spline evaluation locations.
+    ViewType _x;
+    //! Scalar multiplier.
+    value_type _multiplier;
+
+    //! Constructor
+    ScalarGradientG2P( const ViewType& x, const value_type multiplier )
+        : _x( x )
+        , _multiplier( multiplier )
+    {
+        static_assert( 2 == ViewType::Rank, "View must be of vectors" );
+    }
+
+    //! Apply spline interplation.
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
         value_type result[SplineDataType::num_space_dim];
         G2P::gradient( view, sd, result );
         for ( std::size_t d = 0; d < SplineDataType::num_space_dim; ++d )
@@ -1027,121 +1779,423 @@ struct ScalarGradientG2P
     }
 };
 
-//! Creation function for grid-to-point with scalar gradient.
-template <class ViewType>
-ScalarGradientG2P<ViewType>
-createScalarGradientG2P( const ViewType& x,
-                         const typename ViewType::value_type& multiplier )
-{
-    return ScalarGradientG2P<ViewType>( x, multiplier );
-}
+//! Creation function for grid-to-point with scalar gradient.
+template <class ViewType>
+ScalarGradientG2P<ViewType>
+createScalarGradientG2P( const ViewType& x,
+                         const typename ViewType::value_type& multiplier )
+{
+    return ScalarGradientG2P<ViewType>( x, multiplier );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Grid-to-point vector gradient functor.
+
+  Interpolates the gradient of a vector function from entities to points with
+  a given multiplier such that:
+
+  f_{pmn} = multiplier * \\sum_{ijk} grad_weight_{pijkm} * f_{ijkn}
+*/
+template <class ViewType>
+struct VectorGradientG2P
+{
+    //! Scalar value type.
+    using value_type = typename ViewType::value_type;
+
+    //! Spline evaluation locations.
+    ViewType _x;
+    //! Scalar multiplier.
+    value_type _multiplier;
+
+    //! Constructor
+    VectorGradientG2P( const ViewType& x, const value_type multiplier )
+        : _x( x )
+        , _multiplier( multiplier )
+    {
+        static_assert( 3 == ViewType::Rank, "View must be of tensors" );
+    }
+
+    //! Apply spline interplation.
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
+        value_type result[SplineDataType::num_space_dim]
+                         [SplineDataType::num_space_dim];
+        G2P::gradient( view, sd, result );
+        for ( std::size_t d0 = 0; d0 < SplineDataType::num_space_dim; ++d0 )
+            for ( std::size_t d1 = 0; d1 < SplineDataType::num_space_dim; ++d1 )
+                _x( p, d0, d1 ) += _multiplier * result[d0][d1];
+    }
+};
+
+//! Creation function for grid-to-point with vector gradient.
+template <class ViewType>
+VectorGradientG2P<ViewType>
+createVectorGradientG2P( const ViewType& x,
+                         const typename ViewType::value_type& multiplier )
+{
+    return VectorGradientG2P<ViewType>( x, multiplier );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Grid-to-point vector value functor.
+
+  Interpolates the divergence of a vector function from entities to points
+  with a given multiplier such that:
+
+  f_p = multiplier * \\sum_d \\sum_{ijk} grad_weight_{pijkd} * f_{ijkd}
+*/
+template <class ViewType>
+struct VectorDivergenceG2P
+{
+    //! Scalar value type.
+    using value_type = typename ViewType::value_type;
+
+    //! Spline evaluation locations.
+    ViewType _x;
+    //! Scalar multiplier.
+    value_type _multiplier;
+
+    //! Constructor
+    VectorDivergenceG2P( const ViewType& x, const value_type multiplier )
+        : _x( x )
+        , _multiplier( multiplier )
+    {
+        static_assert( 1 == ViewType::Rank, "View must be of scalars" );
+    }
+
+    //! Apply spline interplation.
+    template <class SplineDataType, class GridViewType>
+    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
+                                            const int p,
+                                            const GridViewType& view ) const
+    {
+        value_type result;
+        G2P::divergence( view, sd, result );
+        _x( p ) += result * _multiplier;
+    }
+};
+
+//! Creation function for grid-to-point with vector divergence.
+template <class ViewType>
+VectorDivergenceG2P<ViewType>
+createVectorDivergenceG2P( const ViewType& x,
+                           const typename ViewType::value_type& multiplier )
+{
+    return VectorDivergenceG2P<ViewType>( x, multiplier );
+}
+
+//---------------------------------------------------------------------------//
+// Global point-to-grid
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Point-to-Grid interpolation.
+
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \tparam ArrayScalar The scalar type used for the interpolated data.
+
+  \tparam MeshScalar The scalar type used for the geometry/interpolation data.
+
+  \tparam NumSpaceDim The spatial dimension of the mesh.
+
+  \tparam MeshType The mesh type. Either a uniform or a non-uniform mesh.
+
+  \tparam EntityType The entitytype to which the points will interpolate.
+
+  \tparam SplineOrder The order of spline interpolation to use.
+
+  \tparam DeviceType The device type to use for interplation
+
+  \tparam ArrayParams Parameters for the array type.
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The subset of indices in each point's interpolation
+  stencil must be contained within the local grid that will be used for the
+  interpolation
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to scatter the interpolated data.
+
+  \param array The grid array to which the point data will be interpolated.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
+          class MeshScalar, std::size_t NumSpaceDim,
+          template <class, std::size_t> class MeshType, class EntityType,
+          int SplineOrder, class DeviceType, class... ArrayParams>
+std::enable_if_t<!Cabana::is_parameter_pack<PointEvalFunctor>::value, void>
+p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
+     const std::size_t num_point, Spline<SplineOrder>,
+     const Halo<DeviceType>& halo,
+     Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
+           ArrayParams...>& array )
+{
+    using array_type =
+        Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+
+    using execution_space = typename DeviceType::execution_space;
+
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
+
+    // Create a scatter view of the array.
+    auto array_view = array.view();
+    auto array_sv = Kokkos::Experimental::create_scatter_view( array_view );
+
+    // Loop over points and interpolate to the grid.
+    Kokkos::parallel_for(
+        "p2g", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Get the point coordinates.
+            MeshScalar px[NumSpaceDim];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Create the local spline data.
+            using sd_type =
+                SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+            sd_type sd;
+            evaluateSpline( local_mesh, px, sd );
+
+            // Evaluate the functor.
+            functor( sd, p, array_sv );
+        } );
+    Kokkos::Experimental::contribute( array_view, array_sv );
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    halo.scatter( execution_space(), ScatterReduce::Sum(), array );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Global Point-to-Grid interpolation with cached spline data.
+
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam SplineDataType The cached spline data type.
+
+  \tparam ArrayScalar The scalar type used for the interpolated data.
+
+  \tparam MeshScalar The scalar type used for the geometry/interpolation data.
+
+  \tparam NumSpaceDim The spatial dimension of the mesh.
+
+  \tparam EntityType The entitytype to which the points will interpolate.
+
+  \tparam DeviceType The device type to use for interplation
+
+  \tparam MemorySpace The memory space of the halo.
+
+  \tparam ArrayParams Parameters for the array type.
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
 
-//---------------------------------------------------------------------------//
-/*!
-  \brief Grid-to-point vector gradient functor.
+  \param cache The spline data of the points over which to perform the
+  interpolation.
 
-  Interpolates the gradient of a vector function from entities to points with
-  a given multiplier such that:
+  \param halo The halo associated with the grid array. This hallo will be used
+  to scatter the interpolated data.
 
-  f_{pmn} = multiplier * \\sum_{ijk} grad_weight_{pijkm} * f_{ijkn}
+  \param array The grid array to which the point data will be interpolated.
 */
-template <class ViewType>
-struct VectorGradientG2P
+template <class PointEvalFunctor, class SplineDataType, class ArrayScalar,
+          class MeshScalar, std::size_t NumSpaceDim, class EntityType,
+          class DeviceType, class MemorySpace, class... ArrayParams>
+void p2g( const PointEvalFunctor& functor,
+          const SplineDataCache<SplineDataType, DeviceType>& cache,
+          const Halo<MemorySpace>& halo,
+          Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array )
 {
-    //! Scalar value type.
-    using value_type = typename ViewType::value_type;
+    static_assert(
+        std::is_same<typename SplineDataType::entity_type, EntityType>::value,
+        "Mismatching cache/array entity type." );
+    static_assert( SplineDataType::num_space_dim == NumSpaceDim,
+                   "Mismatching cache/array dimension." );
+    static_assert(
+        std::is_same<typename Halo<MemorySpace>::memory_space,
+                     typename DeviceType::memory_space>::value,
+        "Mismatching cache/array memory space." );
 
-    //! Spline evaluation locations.
-    ViewType _x;
-    //! Scalar multiplier.
-    value_type _multiplier;
+    using execution_space = typename DeviceType::execution_space;
 
-    //! Constructor
-    VectorGradientG2P( const ViewType& x, const value_type multiplier )
-        : _x( x )
-        , _multiplier( multiplier )
-    {
-        static_assert( 3 == ViewType::Rank, "View must be of tensors" );
-    }
+    // Create a scatter view of the array.
+    auto array_view = array.view();
+    auto array_sv = Kokkos::Experimental::create_scatter_view( array_view );
 
-    //! Apply spline interplation.
-    template <class SplineDataType, class GridViewType>
-    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
-                                            const int p,
-                                            const GridViewType& view ) const
-    {
-        value_type result[SplineDataType::num_space_dim]
-                         [SplineDataType::num_space_dim];
-        G2P::gradient( view, sd, result );
-        for ( std::size_t d0 = 0; d0 < SplineDataType::num_space_dim; ++d0 )
-            for ( std::size_t d1 = 0; d1 < SplineDataType::num_space_dim; ++d1 )
-                _x( p, d0, d1 ) += _multiplier * result[d0][d1];
-    }
-};
+    // Loop over points and interpolate to the grid.
+    Kokkos::parallel_for(
+        "p2g_cached", Kokkos::RangePolicy<execution_space>( 0, cache.size() ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Load the local spline data.
+            SplineDataType sd;
+            cache.load( p, sd );
 
-//! Creation function for grid-to-point with vector gradient.
-template <class ViewType>
-VectorGradientG2P<ViewType>
-createVectorGradientG2P( const ViewType& x,
-                         const typename ViewType::value_type& multiplier )
-{
-    return VectorGradientG2P<ViewType>( x, multiplier );
+            // Evaluate the functor.
+            functor( sd, p, array_sv );
+        } );
+    Kokkos::Experimental::contribute( array_view, array_sv );
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    halo.scatter( execution_space(), ScatterReduce::Sum(), array );
 }
 
 //---------------------------------------------------------------------------//
 /*!
-  \brief Grid-to-point vector value functor.
+  \brief Global Point-to-Grid interpolation with batched spline evaluation.
 
-  Interpolates the divergence of a vector function from entities to points
-  with a given multiplier such that:
+  Each thread handles one SoA of the point AoSoA. The spline data of all the
+  points in the SoA is evaluated together with the lanes innermost so the
+  weight computations vectorize, then the functor is applied to each point.
+  This targets host execution spaces where the per-point weight evaluation
+  dominates the interpolation cost.
 
-  f_p = multiplier * \\sum_d \\sum_{ijk} grad_weight_{pijkd} * f_{ijkd}
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam PointCoordinates Cabana slice type containing the point
+  coordinates.
+
+  \tparam ArrayScalar The scalar type used for the interpolated data.
+
+  \tparam MeshScalar The scalar type used for the geometry/interpolation data.
+
+  \tparam NumSpaceDim The spatial dimension of the mesh.
+
+  \tparam EntityType The entitytype to which the points will interpolate.
+
+  \tparam SplineOrder The order of spline interpolation to use.
+
+  \tparam DeviceType The device type to use for interplation
+
+  \tparam ArrayParams Parameters for the array type.
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
+
+  \param points The slice of point coordinates. The subset of indices in each
+  point's interpolation stencil must be contained within the local grid that
+  will be used for the interpolation
+
+  \param num_point The number of points.
+
+  \param halo The halo associated with the grid array. This hallo will be used
+  to scatter the interpolated data.
+
+  \param array The grid array to which the point data will be interpolated.
+
+  \note Spline of SplineOrder passed for interpolation.
 */
-template <class ViewType>
-struct VectorDivergenceG2P
+template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
+          class MeshScalar, std::size_t NumSpaceDim, class EntityType,
+          int SplineOrder, class DeviceType, class... ArrayParams>
+void p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
+          const std::size_t num_point, Spline<SplineOrder>,
+          const Halo<DeviceType>& halo,
+          Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+          BatchedSplineTag )
 {
-    //! Scalar value type.
-    using value_type = typename ViewType::value_type;
+    using array_type =
+        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+              ArrayParams...>;
+    static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
+                                typename array_type::memory_space>::value,
+                   "Mismatching points/array memory space." );
+    static_assert( Cabana::is_slice<PointCoordinates>::value,
+                   "Batched interpolation requires a slice of points" );
 
-    //! Spline evaluation locations.
-    ViewType _x;
-    //! Scalar multiplier.
-    value_type _multiplier;
+    using execution_space = typename DeviceType::execution_space;
+    constexpr int vector_length = PointCoordinates::vector_length;
+    using sd_type =
+        SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+    using batch_type = SplineDataBatch<sd_type, vector_length>;
 
-    //! Constructor
-    VectorDivergenceG2P( const ViewType& x, const value_type multiplier )
-        : _x( x )
-        , _multiplier( multiplier )
-    {
-        static_assert( 1 == ViewType::Rank, "View must be of scalars" );
-    }
+    // Create the local mesh.
+    auto local_mesh =
+        createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
 
-    //! Apply spline interplation.
-    template <class SplineDataType, class GridViewType>
-    KOKKOS_INLINE_FUNCTION void operator()( const SplineDataType& sd,
-                                            const int p,
-                                            const GridViewType& view ) const
-    {
-        value_type result;
-        G2P::divergence( view, sd, result );
-        _x( p ) += result * _multiplier;
-    }
-};
+    // Create a scatter view of the array.
+    auto array_view = array.view();
+    auto array_sv = Kokkos::Experimental::create_scatter_view( array_view );
 
-//! Creation function for grid-to-point with vector divergence.
-template <class ViewType>
-VectorDivergenceG2P<ViewType>
-createVectorDivergenceG2P( const ViewType& x,
-                           const typename ViewType::value_type& multiplier )
-{
-    return VectorDivergenceG2P<ViewType>( x, multiplier );
+    // Loop over the point SoAs and interpolate to the grid.
+    int num_point_soa = ( num_point + vector_length - 1 ) / vector_length;
+    int last_num_lane = num_point - ( num_point_soa - 1 ) * vector_length;
+    Kokkos::parallel_for(
+        "p2g_batched", Kokkos::RangePolicy<execution_space>( 0, num_point_soa ),
+        KOKKOS_LAMBDA( const int s ) {
+            int num_lane =
+                ( s == num_point_soa - 1 ) ? last_num_lane : vector_length;
+
+            // Get the point coordinates.
+            MeshScalar px[NumSpaceDim][vector_length];
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                for ( int a = 0; a < num_lane; ++a )
+                    px[d][a] = points.access( s, a, d );
+
+            // Evaluate the spline data of all the points in the SoA.
+            batch_type batch;
+            evaluateSpline( local_mesh, px, num_lane, batch );
+
+            // Evaluate the functor.
+            for ( int a = 0; a < num_lane; ++a )
+            {
+                sd_type sd;
+                batch.load( a, sd );
+                functor( sd, s * vector_length + a, array_sv );
+            }
+        } );
+    Kokkos::Experimental::contribute( array_view, array_sv );
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    halo.scatter( execution_space(), ScatterReduce::Sum(), array );
 }
 
 //---------------------------------------------------------------------------//
-// Global point-to-grid
+//! Point-to-grid deposition tag: cell-sorted team scratch accumulation.
+struct SortedP2GTag
+{
+};
+
 //---------------------------------------------------------------------------//
 /*!
-  \brief Global Point-to-Grid interpolation.
+  \brief Global Point-to-Grid interpolation with cell-sorted deposition.
+
+  Points are binned by the block of entities containing the start of their
+  interpolation stencil. Each team deposits one block: every thread of the
+  team accumulates its points into its own partial tile in team scratch and
+  the partial tiles are summed and added to the grid once. Blocks are
+  processed in 2^d colors such that the tiles of a color do not overlap, so
+  the deposition uses no atomics.
 
   \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
   for a given point at a given entity.
@@ -1155,6 +2209,8 @@ createVectorDivergenceG2P( const ViewType& x,
 
   \tparam NumSpaceDim The spatial dimension of the mesh.
 
+  \tparam MeshType The mesh type. Either a uniform or a non-uniform mesh.
+
   \tparam EntityType The entitytype to which the points will interpolate.
 
   \tparam SplineOrder The order of spline interpolation to use.
@@ -1179,59 +2235,299 @@ createVectorDivergenceG2P( const ViewType& x,
 
   \param array The grid array to which the point data will be interpolated.
 
+  \param tile_width The number of entities per dimension in each block. It
+  must be at least the spline order.
+
   \note Spline of SplineOrder passed for interpolation.
 */
 template <class PointEvalFunctor, class PointCoordinates, class ArrayScalar,
-          class MeshScalar, std::size_t NumSpaceDim, class EntityType,
+          class MeshScalar, std::size_t NumSpaceDim,
+          template <class, std::size_t> class MeshType, class EntityType,
           int SplineOrder, class DeviceType, class... ArrayParams>
 void p2g( const PointEvalFunctor& functor, const PointCoordinates& points,
           const std::size_t num_point, Spline<SplineOrder>,
           const Halo<DeviceType>& halo,
-          Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
-                ArrayParams...>& array )
+          Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
+                ArrayParams...>& array,
+          SortedP2GTag, const int tile_width = 4 )
 {
     using array_type =
-        Array<ArrayScalar, EntityType, UniformMesh<MeshScalar, NumSpaceDim>,
+        Array<ArrayScalar, EntityType, MeshType<MeshScalar, NumSpaceDim>,
               ArrayParams...>;
     static_assert( std::is_same<typename Halo<DeviceType>::memory_space,
                                 typename array_type::memory_space>::value,
                    "Mismatching points/array memory space." );
 
+    // Tiles of the same color are separated by a tile in each dimension. They
+    // do not overlap if the stencil overlap fits within a tile.
+    const int stencil_overlap = Spline<SplineOrder>::num_knot - 1;
+    if ( tile_width < std::max( stencil_overlap, 1 ) )
+        throw std::runtime_error(
+            "Sorted P2G tile width " + std::to_string( tile_width ) +
+            " is smaller than the stencil overlap of " +
+            std::to_string( stencil_overlap ) );
+
     using execution_space = typename DeviceType::execution_space;
 
     // Create the local mesh.
     auto local_mesh =
         createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
 
-    // Create a scatter view of the array.
+    // Divide the local entities into blocks.
     auto array_view = array.view();
-    auto array_sv = Kokkos::Experimental::create_scatter_view( array_view );
+    Kokkos::Array<int, NumSpaceDim> num_tile;
+    int total_tile = 1;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        num_tile[d] = ( array_view.extent( d ) + tile_width - 1 ) / tile_width;
+        total_tile *= num_tile[d];
+    }
+
+    // Bin the points with a single bin for each block.
+    auto tile_keys = Impl::pointTileKeys<DeviceType, MeshScalar>(
+        local_mesh, points, num_point, Spline<SplineOrder>(), EntityType(),
+        num_tile, tile_width );
+    Kokkos::BinOp1D<decltype( tile_keys )> comp( total_tile, 0, total_tile );
+    auto bin_data = Cabana::binByKeyWithComparator( tile_keys, comp );
+
+    // Each scratch tile holds a block and the trailing stencil overlap.
+    using sd_type =
+        SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+    using scratch_view_type =
+        Kokkos::View<ArrayScalar*,
+                     typename execution_space::scratch_memory_space,
+                     Kokkos::MemoryUnmanaged>;
+    using tile_view_type =
+        P2G::ScratchTileScatterView<scratch_view_type, NumSpaceDim>;
+    const int scratch_width = tile_width + sd_type::num_knot - 1;
+    const int num_comp = array_view.extent( NumSpaceDim );
+    int scratch_size = num_comp;
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        scratch_size *= scratch_width;
+
+    // Each thread of a team accumulates into its own partial tile so the
+    // team size is limited by the scratch available for the partial tiles.
+    using policy_type = Kokkos::TeamPolicy<execution_space>;
+    const std::size_t tile_bytes =
+        scratch_view_type::shmem_size( scratch_size );
+    Impl::checkTileScratchSize<policy_type>( tile_bytes, tile_width,
+                                             scratch_width );
+    const int max_team_size = policy_type::scratch_size_max( 0 ) / tile_bytes;
+
+    // Loop over the tile colors and interpolate the points of each block of
+    // the color to the grid.
+    for ( int color = 0; color < ( 1 << NumSpaceDim ); ++color )
+    {
+        Kokkos::Array<int, NumSpaceDim> tile_offset;
+        Kokkos::Array<int, NumSpaceDim> num_color_tile;
+        int total_color_tile = 1;
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        {
+            tile_offset[d] = ( color >> d ) & 1;
+            num_color_tile[d] = ( num_tile[d] - tile_offset[d] + 1 ) / 2;
+            total_color_tile *= num_color_tile[d];
+        }
+        if ( 0 == total_color_tile )
+            continue;
+
+        auto deposit = KOKKOS_LAMBDA(
+            const typename policy_type::member_type& team )
+        {
+            // Locate the tile in the local grid.
+            tile_view_type tile_view;
+            tile_view._width = scratch_width;
+            tile_view._num_comp = num_comp;
+            int t = team.league_rank();
+            int tile = 0;
+            int tile_stride = 1;
+            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            {
+                int tile_d = 2 * ( t % num_color_tile[d] ) + tile_offset[d];
+                t /= num_color_tile[d];
+                tile += tile_stride * tile_d;
+                tile_stride *= num_tile[d];
+                tile_view._origin[d] = tile_d * tile_width;
+            }
+            const int num_in_tile = bin_data.binSize( tile );
+            if ( 0 == num_in_tile )
+                return;
+
+            // Clear the partial tiles.
+            const int num_partial = team.team_size();
+            scratch_view_type partials( team.team_scratch( 0 ),
+                                        num_partial * scratch_size );
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, num_partial * scratch_size ),
+                [&]( const int n ) { partials( n ) = 0.0; } );
+            team.team_barrier();
+
+            // Accumulate the points of the block into the partial tile of the
+            // thread evaluating them.
+            const auto offset = bin_data.binOffset( tile );
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, num_in_tile ),
+                [&]( const int n ) {
+                    const int p = bin_data.permutation( offset + n );
+
+                    // Get the point coordinates.
+                    MeshScalar px[NumSpaceDim];
+                    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                    {
+                        px[d] = points( p, d );
+                    }
+
+                    // Create the local spline data.
+                    sd_type sd;
+                    evaluateSpline( local_mesh, px, sd );
+
+                    // Evaluate the functor.
+                    tile_view_type thread_tile = tile_view;
+                    thread_tile._data = scratch_view_type(
+                        partials.data() + team.team_rank() * scratch_size,
+                        scratch_size );
+                    functor( sd, p, thread_tile );
+                } );
+            team.team_barrier();
+
+            // Sum the partial tiles and add the touched entries to the grid.
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange( team, scratch_size ),
+                [&]( const int n ) {
+                    ArrayScalar value = 0.0;
+                    for ( int r = 0; r < num_partial; ++r )
+                        value += partials( r * scratch_size + n );
+                    if ( value == ArrayScalar( 0 ) )
+                        return;
+                    int ijk[NumSpaceDim];
+                    int e = n / num_comp;
+                    bool in_grid = true;
+                    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+                    {
+                        ijk[d] = tile_view._origin[d] + e % scratch_width;
+                        e /= scratch_width;
+                        in_grid = in_grid &&
+                                  ijk[d] < static_cast<int>(
+                                               array_view.extent( d ) );
+                    }
+                    if ( in_grid )
+                        P2G::scratchTileContribute( array_view, ijk,
+                                                    n % num_comp, value );
+                } );
+        };
+
+        const int team_size =
+            std::min( max_team_size,
+                      policy_type( total_color_tile, 1 )
+                          .team_size_recommended( deposit,
+                                                  Kokkos::ParallelForTag() ) );
+        const std::size_t partial_bytes =
+            scratch_view_type::shmem_size( team_size * scratch_size );
+        policy_type policy( total_color_tile, team_size );
+        policy.set_scratch_size( 0, Kokkos::PerTeam( partial_bytes ) );
+        Kokkos::parallel_for( "p2g_sorted", policy, deposit );
+    }
+
+    // Scatter interpolation contributions in the halo back to their owning
+    // ranks.
+    halo.scatter( execution_space(), ScatterReduce::Sum(), array );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Fused global Point-to-Grid interpolation of several fields.
+
+  The spline data of each point is evaluated once and shared by every functor
+  and the contributions to all arrays are scattered with a single halo
+  exchange.
+
+  \tparam PointEvalFunctors Functor types used to evaluate the interpolated
+  data for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \tparam SplineOrder The order of spline interpolation to use.
+
+  \tparam DeviceType The device type to use for interplation
+
+  \tparam ArrayTypes The grid array types. All arrays must share an entity
+  type and a mesh type.
+
+  \param functors The point-to-grid functors, created with
+  Cabana::makeParameterPack(). The Nth functor interpolates to the Nth array.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim). The subset of indices in each point's interpolation
+  stencil must be contained within the local grid that will be used for the
+  interpolation
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param halo The halo associated with all of the grid arrays. This halo will
+  be used to scatter the interpolated data and must have been created with the
+  same arrays in the same order.
+
+  \param arrays The grid arrays to which the point data will be interpolated.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <class... PointEvalFunctors, class PointCoordinates, int SplineOrder,
+          class DeviceType, class... ArrayTypes>
+void p2g( const Cabana::ParameterPack<PointEvalFunctors...>& functors,
+          const PointCoordinates& points, const std::size_t num_point,
+          Spline<SplineOrder>, const Halo<DeviceType>& halo,
+          ArrayTypes&... arrays )
+{
+    static_assert( sizeof...( PointEvalFunctors ) == sizeof...( ArrayTypes ),
+                   "Each array requires a point-to-grid functor" );
+    using traits = Impl::FusedInterpolationTraits<DeviceType, ArrayTypes...>;
+    using mesh_type = typename traits::mesh_type;
+    using entity_type = typename traits::entity_type;
+    using scalar_type = typename traits::scalar_type;
+
+    using execution_space = typename DeviceType::execution_space;
+
+    // Create the local mesh.
+    const auto& array = std::get<0>( std::forward_as_tuple( arrays... ) );
+    auto local_mesh =
+        createLocalMesh<DeviceType>( *( array.layout()->localGrid() ) );
+
+    // Create scatter views of the arrays.
+    auto array_views = Cabana::makeParameterPack( arrays.view()... );
+    auto array_svs = Cabana::makeParameterPack(
+        Kokkos::Experimental::create_scatter_view( arrays.view() )... );
 
     // Loop over points and interpolate to the grid.
     Kokkos::parallel_for(
-        "p2g", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        "p2g_fused", Kokkos::RangePolicy<execution_space>( 0, num_point ),
         KOKKOS_LAMBDA( const int p ) {
             // Get the point coordinates.
-            MeshScalar px[NumSpaceDim];
-            for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            scalar_type px[mesh_type::num_space_dim];
+            for ( std::size_t d = 0; d < mesh_type::num_space_dim; ++d )
             {
                 px[d] = points( p, d );
             }
 
-            // Create the local spline data.
+            // Create the local spline data once for all functors.
             using sd_type =
-                SplineData<MeshScalar, SplineOrder, NumSpaceDim, EntityType>;
+                SplineData<scalar_type, SplineOrder, mesh_type::num_space_dim,
+                           entity_type>;
             sd_type sd;
             evaluateSpline( local_mesh, px, sd );
 
-            // Evaluate the functor.
-            functor( sd, p, array_sv );
+            // Evaluate the functors.
+            Impl::applyInterpolationFunctors(
+                functors, sd, p, array_svs,
+                std::integral_constant<std::size_t,
+                                       sizeof...( ArrayTypes ) - 1>() );
         } );
-    Kokkos::Experimental::contribute( array_view, array_sv );
+    Impl::contributeScatterViews( array_views, array_svs,
+                                  std::index_sequence_for<ArrayTypes...>() );
 
-    // Scatter interpolation contributions in the halo back to their owning
-    // ranks.
-    halo.scatter( execution_space(), ScatterReduce::Sum(), array );
+    // Scatter interpolation contributions for all arrays in the halo back to
+    // their owning ranks in a single exchange.
+    halo.scatter( execution_space(), ScatterReduce::Sum(), arrays... );
 }
 
 //---------------------------------------------------------------------------//
@@ -118,6 +118,38 @@ class LocalGrid
     IndexSpace<num_space_dim> indexSpace( DecompositionTag t1, EntityType t2,
                                           IndexType t3 ) const;
 
+    /*!
+      \brief Get the interior of the index space of the given entities: the
+      entities that are not within the given width of the boundary of the
+      space and therefore do not touch the halo with a stencil of that width.
+
+      \param t1 Decomposition type: Own or Ghost
+      \param t2 Entity type: Cell, Node, Edge, or Face
+      \param t3 Index type: Local or Global
+      \param halo_width Optional stencil width. Default is to use the halo
+      width of the local grid.
+    */
+    template <class DecompositionTag, class EntityType, class IndexType>
+    IndexSpace<num_space_dim>
+    interiorIndexSpace( DecompositionTag t1, EntityType t2, IndexType t3,
+                        const int halo_width = -1 ) const;
+
+    /*!
+      \brief Get the boundary slabs of the index space of the given entities:
+      the non-overlapping index spaces which together with the interior index
+      space of the same width exactly cover the index space.
+
+      \param t1 Decomposition type: Own or Ghost
+      \param t2 Entity type: Cell, Node, Edge, or Face
+      \param t3 Index type: Local or Global
+      \param halo_width Optional stencil width. Default is to use the halo
+      width of the local grid.
+    */
+    template <class DecompositionTag, class EntityType, class IndexType>
+    Kokkos::Array<IndexSpace<num_space_dim>, 2 * num_space_dim>
+    boundarySlabIndexSpaces( DecompositionTag t1, EntityType t2, IndexType t3,
+                             const int halo_width = -1 ) const;
+
     /*!
       \brief Given the relative offsets of a neighbor rank relative to this
       local grid's indices get the set of local entity indices shared with that
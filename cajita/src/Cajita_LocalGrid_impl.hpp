@@ -102,6 +102,36 @@ auto LocalGrid<MeshType>::indexSpace( DecompositionTag t1, EntityType t2,
     return indexSpaceImpl( t1, t2, t3 );
 }
 
+//---------------------------------------------------------------------------//
+// Get the interior of the index space of the given entities. Optionally
+// provide a stencil width. The default behavior is to use the halo width of
+// the local grid.
+template <class MeshType>
+template <class DecompositionTag, class EntityType, class IndexType>
+auto LocalGrid<MeshType>::interiorIndexSpace( DecompositionTag t1,
+                                              EntityType t2, IndexType t3,
+                                              const int halo_width ) const
+    -> IndexSpace<num_space_dim>
+{
+    int hw = ( -1 == halo_width ) ? _halo_cell_width : halo_width;
+    return Cajita::interiorIndexSpace( indexSpace( t1, t2, t3 ), hw );
+}
+
+//---------------------------------------------------------------------------//
+// Get the boundary slabs of the index space of the given entities. Optionally
+// provide a stencil width. The default behavior is to use the halo width of
+// the local grid.
+template <class MeshType>
+template <class DecompositionTag, class EntityType, class IndexType>
+auto LocalGrid<MeshType>::boundarySlabIndexSpaces( DecompositionTag t1,
+                                                   EntityType t2, IndexType t3,
+                                                   const int halo_width ) const
+    -> Kokkos::Array<IndexSpace<num_space_dim>, 2 * num_space_dim>
+{
+    int hw = ( -1 == halo_width ) ? _halo_cell_width : halo_width;
+    return Cajita::boundarySlabIndexSpaces( indexSpace( t1, t2, t3 ), hw );
+}
+
 //---------------------------------------------------------------------------//
 // Given the relative offsets of a neighbor rank relative to this local
 // grid's indices get the set of local entity indices shared with that
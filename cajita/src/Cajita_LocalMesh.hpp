@@ -650,6 +650,31 @@ class LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>
                 x[d] = _local_edges[d]( index[d] );
     }
 
+    /*!
+      \brief Locate the local cell containing a position in a dimension by
+      binary search over the local node coordinates. Positions outside of the
+      ghosted local domain are assigned to the nearest ghosted local cell.
+      \param dim The dimension in which to locate the position.
+      \param x The position.
+      \return The local index of the cell containing the position.
+    */
+    KOKKOS_INLINE_FUNCTION
+    int locateCell( const int dim, const Scalar x ) const
+    {
+        const auto& edges = _local_edges[dim];
+        int low = 0;
+        int high = edges.extent( 0 ) - 2;
+        while ( low < high )
+        {
+            int mid = ( low + high + 1 ) / 2;
+            if ( edges( mid ) <= x )
+                low = mid;
+            else
+                high = mid - 1;
+        }
+        return low;
+    }
+
     /*!
       Get the measure of a Node.
     */
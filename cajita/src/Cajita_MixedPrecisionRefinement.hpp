@@ -0,0 +1,473 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_MixedPrecisionRefinement.hpp
+  \brief Mixed-precision iterative refinement of structured solves
+*/
+#ifndef CAJITA_MIXEDPRECISIONREFINEMENT_HPP
+#define CAJITA_MIXEDPRECISIONREFINEMENT_HPP
+
+#include <Cajita_Array.hpp>
+#include <Cajita_Halo.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_MpiTraits.hpp>
+#include <Cajita_Parallel.hpp>
+#include <Cajita_ReferenceStructuredSolver.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace Cajita
+{
+//! \cond Impl
+namespace Impl
+{
+// Copy all components of an array into an array of another precision.
+template <class ViewOut, class ViewIn>
+struct MixedPrecisionCopy
+{
+    ViewOut out_view;
+    ViewIn in_view;
+
+    using value_type = typename ViewOut::value_type;
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k, const int l ) const
+    {
+        out_view( i, j, k, l ) =
+            static_cast<value_type>( in_view( i, j, k, l ) );
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int l ) const
+    {
+        out_view( i, j, l ) = static_cast<value_type>( in_view( i, j, l ) );
+    }
+};
+
+// Add a correction of another precision to an array.
+template <class ViewOut, class ViewIn>
+struct MixedPrecisionAdd
+{
+    ViewOut out_view;
+    ViewIn in_view;
+
+    using value_type = typename ViewOut::value_type;
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int k, const int l ) const
+    {
+        out_view( i, j, k, l ) +=
+            static_cast<value_type>( in_view( i, j, k, l ) );
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                            const int l ) const
+    {
+        out_view( i, j, l ) += static_cast<value_type>( in_view( i, j, l ) );
+    }
+};
+
+// Compute the residual r = b - Ax and its squared norm.
+template <class OperatorA, class ViewX, class ViewB, class ViewR>
+struct MixedPrecisionResidual
+{
+    OperatorA A;
+    ViewX x_view;
+    ViewB b_view;
+    ViewR r_view;
+
+    using value_type = typename ViewR::value_type;
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                const int j, const int k, value_type& result ) const
+    {
+        auto r = b_view( i, j, k, 0 ) -
+                 A( createVectorAccessor( x_view ), i, j, k );
+        r_view( i, j, k, 0 ) = r;
+        result += r * r;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                const int j, value_type& result ) const
+    {
+        auto r = b_view( i, j, 0 ) - A( createVectorAccessor( x_view ), i, j );
+        r_view( i, j, 0 ) = r;
+        result += r * r;
+    }
+};
+
+// Copy an array into an array of another precision over a decomposition.
+template <class ArrayOut, class ArrayIn, class DecompositionTag>
+void mixedPrecisionCopy( ArrayOut& out, const ArrayIn& in,
+                         DecompositionTag tag )
+{
+    using execution_space = typename ArrayOut::execution_space;
+    Kokkos::parallel_for(
+        "Cajita::MixedPrecisionRefinement::copy",
+        createExecutionPolicy( out.layout()->indexSpace( tag, Local() ),
+                               execution_space() ),
+        MixedPrecisionCopy<typename ArrayOut::view_type,
+                           typename ArrayIn::view_type>{ out.view(),
+                                                         in.view() } );
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Mixed-precision iterative refinement.
+
+  Outer residual corrections are computed in the precision of the arrays
+  while each correction is solved by an inner reference conjugate gradient
+  solver on lower precision copies of the matrix, preconditioner, and
+  vectors. The inner solves are bandwidth bound and move half the data for
+  float inner solves of double problems. The final residual is computed in
+  full precision.
+
+  \tparam Scalar Outer scalar value type.
+  \tparam InnerScalar Inner solve scalar value type.
+  \tparam EntityType Entity type.
+  \tparam MeshType Mesh type.
+  \tparam DeviceType Kokkos device type.
+*/
+template <class Scalar, class InnerScalar, class EntityType, class MeshType,
+          class DeviceType>
+class MixedPrecisionRefinement
+    : public ReferenceStructuredSolver<Scalar, EntityType, MeshType, DeviceType>
+{
+  public:
+    //! Entity type.
+    using entity_type = EntityType;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Array type.
+    using Array_t = Array<Scalar, EntityType, MeshType, DeviceType>;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = MeshType::num_space_dim;
+    //! Inner solver type.
+    using inner_solver_type =
+        ReferenceConjugateGradient<InnerScalar, EntityType, MeshType,
+                                   DeviceType>;
+
+    /*!
+      \brief Constructor.
+      \param layout The array layout defining the vector space of the solver.
+    */
+    MixedPrecisionRefinement( const ArrayLayout<EntityType, MeshType>& layout )
+        : _tol( 1.0e-6 )
+        , _max_iter( 100 )
+        , _print_level( 0 )
+        , _num_iter( 0 )
+        , _residual_norm( 0.0 )
+        , _A_width( 0 )
+    {
+        // Vectors (x,r).
+        auto vector_layout =
+            createArrayLayout( layout.localGrid(), 2, EntityType() );
+        _vectors = createArray<Scalar, DeviceType>( "mixed_precision_vectors",
+                                                    vector_layout );
+
+        // Inner vectors.
+        auto inner_layout =
+            createArrayLayout( layout.localGrid(), 1, EntityType() );
+        _inner_b = createArray<InnerScalar, DeviceType>( "inner_b",
+                                                         inner_layout );
+        _inner_x = createArray<InnerScalar, DeviceType>( "inner_x",
+                                                         inner_layout );
+
+        // Inner solver.
+        _inner = std::make_shared<inner_solver_type>( layout );
+        _inner->setTolerance( 1.0e-4 );
+    }
+
+    /*!
+      \brief Set the matrix stencil.
+      \param stencil The (i,j,k) offsets describing the structured matrix
+      entries at each grid point. Offsets are defined relative to an index.
+      \param is_symmetric If true the matrix is designated as symmetric. The
+      stencil entries should only contain one entry from each symmetric
+      component if this is true.
+    */
+    void setMatrixStencil(
+        const std::vector<std::array<int, num_space_dim>>& stencil,
+        const bool is_symmetric = false ) override
+    {
+        _inner->setMatrixStencil( stencil, is_symmetric );
+
+        // Copy stencil to the device.
+        _A_stencil = Kokkos::View<int* [num_space_dim], DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "stencil" ),
+            stencil.size() );
+        auto stencil_mirror =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), _A_stencil );
+        _A_width = 0;
+        for ( unsigned s = 0; s < stencil.size(); ++s )
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                stencil_mirror( s, d ) = stencil[s][d];
+                _A_width = std::max( _A_width, std::abs( stencil[s][d] ) );
+            }
+        Kokkos::deep_copy( _A_stencil, stencil_mirror );
+
+        // Allocate the matrix.
+        auto local_grid = _vectors->layout()->localGrid();
+        auto matrix_layout =
+            createArrayLayout( local_grid, stencil.size(), EntityType() );
+        _A = createArray<Scalar, DeviceType>( "matrix", matrix_layout );
+
+        // Build the halo of the LHS.
+        _x_halo = createHalo( NodeHaloPattern<num_space_dim>(), _A_width,
+                              *createSubarray( *_vectors, 0, 1 ) );
+    }
+
+    /*!
+      \brief Get the matrix values.
+      \return The full precision matrix entry values. For each entity over
+      which the vector space is defined an entry for each stencil element is
+      required. The order of the stencil elements is that same as that in the
+      stencil definition. Note that values corresponding to stencil entries
+      outside of the domain should be set to zero.
+    */
+    const Array_t& getMatrixValues() override { return *_A; }
+
+    /*!
+      \brief Set the preconditioner stencil of the inner solver.
+      \param stencil The (i,j,k) offsets describing the structured
+      preconditioner entries at each grid point. Offsets are defined relative to
+      an index. \param is_symmetric If true the preconditioner is designated as
+      symmetric. The stencil entries should only contain one entry from each
+      symmetric component if this is true.
+    */
+    void setPreconditionerStencil(
+        const std::vector<std::array<int, num_space_dim>>& stencil,
+        const bool is_symmetric = false ) override
+    {
+        _inner->setPreconditionerStencil( stencil, is_symmetric );
+        auto local_grid = _vectors->layout()->localGrid();
+        auto preconditioner_layout =
+            createArrayLayout( local_grid, stencil.size(), EntityType() );
+        _M = createArray<Scalar, DeviceType>( "preconditioner",
+                                              preconditioner_layout );
+    }
+
+    /*!
+      \brief Get the preconditioner values.
+      \return The full precision preconditioner entry values. They are
+      converted to the inner precision at setup.
+    */
+    const Array_t& getPreconditionerValues() override { return *_M; }
+
+    //! Set the convergence tolerance of the full precision residual.
+    void setTolerance( const double tol ) override { _tol = tol; }
+
+    //! Set the maximum number of refinement iterations.
+    void setMaxIter( const int max_iter ) override { _max_iter = max_iter; }
+
+    //! Set the output level.
+    void setPrintLevel( const int print_level ) override
+    {
+        _print_level = print_level;
+    }
+
+    //! Set the relative convergence tolerance of each inner solve.
+    void setInnerTolerance( const double tol ) { _inner->setTolerance( tol ); }
+
+    /*!
+      \brief Get the inner solver.
+
+      The inner solver may be configured directly, for example to use the
+      pipelined variant or a whole vector preconditioner in the inner
+      precision.
+    */
+    std::shared_ptr<inner_solver_type> innerSolver() const { return _inner; }
+
+    //! Setup the problem. Converts the matrix and preconditioner to the
+    //! inner precision.
+    void setup() override
+    {
+        Impl::mixedPrecisionCopy( _inner->getMatrixValues(), *_A, Ghost() );
+        if ( _M )
+            Impl::mixedPrecisionCopy( _inner->getPreconditionerValues(), *_M,
+                                      Ghost() );
+        _inner->setup();
+    }
+
+    /*!
+      \brief Solve the problem Ax = b for x.
+      \param b The forcing term.
+      \param x The solution.
+    */
+    void solve( const Array_t& b, Array_t& x ) override
+    {
+        Kokkos::Profiling::pushRegion(
+            "Cajita::MixedPrecisionRefinement::solve" );
+
+        // Get the local grid.
+        auto local_grid = _vectors->layout()->localGrid();
+
+        // Print banner
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << std::endl
+                      << "Mixed-precision iterative refinement" << std::endl;
+
+        // Index space.
+        auto entity_space =
+            local_grid->indexSpace( Own(), EntityType(), Local() );
+
+        // Subarrays.
+        auto x_gather = createSubarray( *_vectors, 0, 1 );
+        auto r = createSubarray( *_vectors, 1, 2 );
+
+        // Matrix operator.
+        auto A = Impl::createStencilMatrixOperator( _A_stencil, _A->view(),
+                                                    _A_width );
+
+        // Compute the norm of the RHS.
+        std::vector<Scalar> b_norm( 1 );
+        ArrayOp::norm2( b, b_norm );
+
+        // Iterate.
+        bool converged = false;
+        for ( _num_iter = 0;; ++_num_iter )
+        {
+            // Compute the full precision residual.
+            Kokkos::deep_copy( x_gather->view(), x.view() );
+            _x_halo->gather( execution_space(), *x_gather );
+            Scalar r_norm = 0.0;
+            grid_parallel_reduce(
+                "mixed_precision_residual", execution_space(), entity_space,
+                std::integral_constant<std::size_t, num_space_dim>{},
+                Impl::MixedPrecisionResidual<
+                    decltype( A ), typename Array_t::view_type,
+                    typename Array_t::view_type,
+                    typename decltype( r )::element_type::view_type>{
+                    A, x_gather->view(), b.view(), r->view() },
+                r_norm );
+            MPI_Allreduce( MPI_IN_PLACE, &r_norm, 1, MpiTraits<Scalar>::type(),
+                           MPI_SUM, local_grid->globalGrid().comm() );
+            _residual_norm = std::sqrt( r_norm ) / b_norm[0];
+
+            // Output result
+            if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+                std::cout << "Iteration " << _num_iter
+                          << ": |r|_2 / |b|_2 = " << _residual_norm
+                          << std::endl;
+
+            // Check for convergence.
+            if ( _residual_norm <= _tol )
+            {
+                converged = true;
+                break;
+            }
+            if ( _num_iter >= _max_iter )
+                break;
+
+            // Solve for the correction in the inner precision. The inner
+            // LHS ghosts are zero.
+            Impl::mixedPrecisionCopy( *_inner_b, *r, Own() );
+            ArrayOp::assign( *_inner_x, 0.0, Ghost() );
+            _inner->solve( *_inner_b, *_inner_x );
+
+            // Apply the correction in full precision.
+            Kokkos::parallel_for(
+                "mixed_precision_correction",
+                createExecutionPolicy(
+                    x.layout()->indexSpace( Own(), Local() ),
+                    execution_space() ),
+                Impl::MixedPrecisionAdd<
+                    typename Array_t::view_type,
+                    typename Array<InnerScalar, EntityType, MeshType,
+                                   DeviceType>::view_type>{
+                    x.view(), _inner_x->view() } );
+        }
+
+        // Output end state.
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Finished in " << _num_iter
+                      << " iterations, converged to " << _residual_norm
+                      << std::endl
+                      << std::endl;
+
+        Kokkos::Profiling::popRegion();
+
+        // If we didn't converge throw.
+        if ( !converged )
+            throw std::runtime_error(
+                "Mixed-precision refinement did not converge" );
+    }
+
+    //! Get the number of refinement iterations taken on the last solve.
+    int getNumIter() override { return _num_iter; }
+
+    //! Get the full precision relative residual norm achieved on the last
+    //! solve.
+    double getFinalRelativeResidualNorm() override { return _residual_norm; }
+
+  private:
+    Scalar _tol;
+    int _max_iter;
+    int _print_level;
+    int _num_iter;
+    Scalar _residual_norm;
+    Kokkos::View<int* [num_space_dim], DeviceType> _A_stencil;
+    int _A_width;
+    std::shared_ptr<Array_t> _A;
+    std::shared_ptr<Array_t> _M;
+    std::shared_ptr<Array_t> _vectors;
+    std::shared_ptr<Halo<memory_space>> _x_halo;
+    std::shared_ptr<Array<InnerScalar, EntityType, MeshType, DeviceType>>
+        _inner_b;
+    std::shared_ptr<Array<InnerScalar, EntityType, MeshType, DeviceType>>
+        _inner_x;
+    std::shared_ptr<inner_solver_type> _inner;
+};
+
+//---------------------------------------------------------------------------//
+// Builders.
+//---------------------------------------------------------------------------//
+//! Creation function for mixed-precision iterative refinement with an inner
+//! reference conjugate gradient solver.
+template <class Scalar, class InnerScalar, class DeviceType, class EntityType,
+          class MeshType>
+std::shared_ptr<MixedPrecisionRefinement<Scalar, InnerScalar, EntityType,
+                                         MeshType, DeviceType>>
+createMixedPrecisionRefinement(
+    const ArrayLayout<EntityType, MeshType>& layout )
+{
+    return std::make_shared<MixedPrecisionRefinement<
+        Scalar, InnerScalar, EntityType, MeshType, DeviceType>>( layout );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Cajita
+
+#endif // end CAJITA_MIXEDPRECISIONREFINEMENT_HPP
@@ -16,10 +16,18 @@
 #ifndef CAJITA_PARALLEL_HPP
 #define CAJITA_PARALLEL_HPP
 
+#include <Cabana_ParameterPack.hpp>
+
 #include <Cajita_IndexSpace.hpp>
 #include <Cajita_LocalGrid.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
 
+#include <array>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace Cajita
 {
@@ -411,6 +419,456 @@ grid_parallel_for( const std::string& label, const ExecutionSpace& exec_space,
     Kokkos::Profiling::popRegion();
 }
 
+namespace Impl
+{
+//! \cond Impl
+// Functor adapter dropping the index space id of a multi-space launch.
+template <class FunctorType>
+struct DropSpaceIdFunctor
+{
+    FunctorType functor;
+
+    template <class... IndexTypes>
+    KOKKOS_INLINE_FUNCTION void operator()( const int,
+                                            const IndexTypes... ids ) const
+    {
+        functor( ids... );
+    }
+};
+//! \endcond
+} // end namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a functor in parallel over the given local grid,
+  decomposition, and entity type in two phases to overlap computation with
+  halo communication. The functor is first executed over the interior
+  entities that do not touch the halo with a stencil of the given width, then
+  the given callback is executed (e.g. to complete a halo gather started
+  before this call), and finally the functor is executed over the remaining
+  boundary slabs in a single launch. The loop indices are local.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam CallbackType The callback type. Signature is f().
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam MeshType The mesh type of the local grid.
+
+  \param label Parallel region label.
+
+  \param exec_space An execution space instance.
+
+  \param local_grid The local grid to iterate over.
+
+  \param decomposition The decomposition type of the entities (own,ghost).
+
+  \param entity_type The entity type over which to loop.
+
+  \param stencil_width The width of the functor stencil.
+
+  \param callback The callback to execute between the interior and boundary
+  phases.
+
+  \param functor The functor to execute.
+ */
+template <class FunctorType, class CallbackType, class ExecutionSpace,
+          class MeshType, class DecompositionType, class EntityType>
+inline void
+grid_parallel_for( const std::string& label, const ExecutionSpace& exec_space,
+                   const LocalGrid<MeshType>& local_grid,
+                   const DecompositionType& decomposition,
+                   const EntityType& entity_type, const int stencil_width,
+                   const CallbackType& callback, const FunctorType& functor )
+{
+    Kokkos::Profiling::pushRegion( "Cajita::grid_parallel_for_overlap" );
+
+    // Interior phase.
+    auto interior_space = local_grid.interiorIndexSpace(
+        decomposition, entity_type, Local(), stencil_width );
+    grid_parallel_for( label + "_interior", exec_space, interior_space,
+                       functor );
+
+    // User work between phases.
+    callback();
+
+    // Boundary phase.
+    auto boundary_spaces = local_grid.boundarySlabIndexSpaces(
+        decomposition, entity_type, Local(), stencil_width );
+    grid_parallel_for( label + "_boundary", exec_space, boundary_spaces,
+                       Impl::DropSpaceIdFunctor<FunctorType>{ functor } );
+
+    Kokkos::Profiling::popRegion();
+}
+
+//---------------------------------------------------------------------------//
+// Tiled Grid Parallel For
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Index of an entity type in a tiling table.
+inline int tilingEntityId( Cell ) { return 0; }
+
+inline int tilingEntityId( Node ) { return 1; }
+
+template <int D>
+int tilingEntityId( Face<D> )
+{
+    return 2 + D;
+}
+
+template <int D>
+int tilingEntityId( Edge<D> )
+{
+    return 5 + D;
+}
+
+// Functor applying each functor of a pack to the same indices.
+template <class... FunctorTypes>
+struct FusedGridFunctor
+{
+    Cabana::ParameterPack<FunctorTypes...> functors;
+
+    template <std::size_t... Indices, class... IndexTypes>
+    KOKKOS_INLINE_FUNCTION void apply( std::index_sequence<Indices...>,
+                                       const IndexTypes... ids ) const
+    {
+        int dummy[] = { 0,
+                        ( Cabana::get<Indices>( functors )( ids... ), 0 )... };
+        (void)dummy;
+    }
+
+    template <class... IndexTypes>
+    KOKKOS_INLINE_FUNCTION void operator()( const IndexTypes... ids ) const
+    {
+        apply( std::index_sequence_for<FunctorTypes...>(), ids... );
+    }
+};
+
+// A single functor is executed as is.
+template <class FunctorType>
+const FunctorType& fuseGridFunctors( const FunctorType& functor )
+{
+    return functor;
+}
+
+// A pack of functors is executed in a single fused kernel.
+template <class... FunctorTypes>
+FusedGridFunctor<FunctorTypes...>
+fuseGridFunctors( const Cabana::ParameterPack<FunctorTypes...>& functors )
+{
+    return FusedGridFunctor<FunctorTypes...>{ functors };
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Tile sizes of tiled grid iteration for each entity type.
+
+  Cell-, node-, face-, and edge-centered arrays of the same grid have
+  different extents and are often accessed with different stencils, so each
+  entity type may be iterated with its own tile size.
+
+  \tparam NumSpaceDim The spatial dimension of the grid.
+*/
+template <std::size_t NumSpaceDim>
+class GridTiling
+{
+  public:
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+
+    /*!
+      \brief Constructor.
+      \param tile The number of entities per tile in each dimension used for
+      all entity types without an explicitly set tile size.
+    */
+    GridTiling( const Kokkos::Array<int, num_space_dim>& tile )
+    {
+        _tiles.fill( tile );
+    }
+
+    /*!
+      \brief Set the tile size of an entity type.
+      \param tile The number of entities per tile in each dimension.
+    */
+    template <class EntityType>
+    void setTile( EntityType, const Kokkos::Array<int, num_space_dim>& tile )
+    {
+        _tiles[Impl::tilingEntityId( EntityType() )] = tile;
+    }
+
+    //! Get the tile size of an entity type.
+    template <class EntityType>
+    Kokkos::Array<int, num_space_dim> tile( EntityType ) const
+    {
+        return _tiles[Impl::tilingEntityId( EntityType() )];
+    }
+
+  private:
+    std::array<Kokkos::Array<int, num_space_dim>, 8> _tiles;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a functor in parallel with a tiled multidimensional
+  execution policy specified by the given index space.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam N The dimension of the index space.
+
+  \tparam TileRank The dimension of the tile. Must equal N.
+
+  \param label Parallel region label.
+
+  \param exec_space An execution space instance.
+
+  \param index_space The index space over which to loop.
+
+  \param tile The number of indices per tile in each dimension.
+
+  \param functor The functor to execute. A pack of functors created with
+  Cabana::makeParameterPack() is executed in a single fused kernel in which
+  each functor is applied to each index in order.
+ */
+template <class FunctorType, class ExecutionSpace, long N,
+          std::size_t TileRank>
+inline void grid_parallel_for( const std::string& label,
+                               const ExecutionSpace& exec_space,
+                               const IndexSpace<N>& index_space,
+                               const Kokkos::Array<int, TileRank>& tile,
+                               const FunctorType& functor )
+{
+    Kokkos::Profiling::pushRegion( "Cajita::grid_parallel_for_tiled" );
+    Kokkos::parallel_for(
+        label, createTiledExecutionPolicy( index_space, exec_space, tile ),
+        Impl::fuseGridFunctors( functor ) );
+    Kokkos::Profiling::popRegion();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute a functor in parallel with a tiled multidimensional
+  execution policy specified by the given local grid, decomposition, and
+  entity type. The loop indices are local.
+
+  \tparam FunctorType The functor type to execute.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam MeshType The mesh type of the local grid.
+
+  \tparam NumSpaceDim The spatial dimension of the tiling.
+
+  \param label Parallel region label.
+
+  \param exec_space An execution space instance.
+
+  \param local_grid The local grid to iterate over.
+
+  \param decomposition The decomposition type of the entities (own,ghost).
+
+  \param entity_type The entity type over which to loop.
+
+  \param tiling The tile sizes of each entity type.
+
+  \param functor The functor to execute. A pack of functors created with
+  Cabana::makeParameterPack() is executed in a single fused kernel.
+ */
+template <class FunctorType, class ExecutionSpace, class MeshType,
+          class DecompositionType, class EntityType, std::size_t NumSpaceDim>
+inline void
+grid_parallel_for( const std::string& label, const ExecutionSpace& exec_space,
+                   const LocalGrid<MeshType>& local_grid,
+                   const DecompositionType& decomposition,
+                   const EntityType& entity_type,
+                   const GridTiling<NumSpaceDim>& tiling,
+                   const FunctorType& functor )
+{
+    static_assert( MeshType::num_space_dim == NumSpaceDim,
+                   "Tiling and mesh dimension mismatch" );
+
+    auto index_space =
+        local_grid.indexSpace( decomposition, entity_type, Local() );
+    grid_parallel_for( label, exec_space, index_space,
+                       tiling.tile( entity_type ), functor );
+}
+
+//---------------------------------------------------------------------------//
+// Temporal Blocking
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Execute a temporal block functor at a linear index of a region. 3D
+// specialization.
+template <class FunctorType>
+KOKKOS_INLINE_FUNCTION void
+temporalBlockApply( const FunctorType& functor, const int step,
+                    const Kokkos::Array<long, 3>& min,
+                    const Kokkos::Array<long, 3>& extent, const long n )
+{
+    long extent_jk = extent[Dim::J] * extent[Dim::K];
+    functor( step, min[Dim::I] + n / extent_jk,
+             min[Dim::J] + ( n % extent_jk ) / extent[Dim::K],
+             min[Dim::K] + n % extent[Dim::K] );
+}
+
+// Execute a temporal block functor at a linear index of a region. 2D
+// specialization.
+template <class FunctorType>
+KOKKOS_INLINE_FUNCTION void
+temporalBlockApply( const FunctorType& functor, const int step,
+                    const Kokkos::Array<long, 2>& min,
+                    const Kokkos::Array<long, 2>& extent, const long n )
+{
+    functor( step, min[Dim::I] + n / extent[Dim::J],
+             min[Dim::J] + n % extent[Dim::J] );
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Execute several dependent stencil sweeps over the owned entities of
+  a local grid tile by tile in a single launch.
+
+  Each team visits one tile of owned entities and applies all sweeps to it
+  before moving on, so the data of a tile is read from memory once per block
+  of sweeps rather than once per sweep. Sweep s is applied to the tile
+  extended by the stencil width times the number of remaining sweeps, which
+  contains all the entities the remaining sweeps of the tile depend on. The
+  halo is the time-skew budget: after a halo gather the ghosted entities hold
+  valid inputs, so the number of sweeps times the stencil width may not
+  exceed the halo width. The loop indices are local.
+
+  Entities in the overlap of neighboring extended tiles are computed
+  redundantly by each tile. The functor must therefore read the state of
+  sweep s and write the state of sweep s+1 to storage distinct from that of
+  every other sweep (e.g. one array component per state) so that all copies
+  are computed from the same inputs and are identical.
+
+  \tparam FunctorType The functor type to execute. Signature is f(s,i,j,k)
+  (or f(s,i,j) in 2D) where s is the sweep index.
+
+  \tparam ExecutionSpace The execution space type.
+
+  \tparam MeshType The mesh type of the local grid.
+
+  \param label Parallel region label.
+
+  \param exec_space An execution space instance.
+
+  \param local_grid The local grid to iterate over.
+
+  \param entity_type The entity type over which to loop.
+
+  \param tile The number of entities per tile in each dimension.
+
+  \param stencil_width The width of the functor stencil.
+
+  \param num_step The number of sweeps.
+
+  \param functor The functor to execute.
+ */
+template <class FunctorType, class ExecutionSpace, class MeshType,
+          class EntityType>
+void grid_temporal_block_for(
+    const std::string& label, const ExecutionSpace& exec_space,
+    const LocalGrid<MeshType>& local_grid, const EntityType& entity_type,
+    const Kokkos::Array<int, MeshType::num_space_dim>& tile,
+    const int stencil_width, const int num_step, const FunctorType& functor )
+{
+    static constexpr std::size_t num_space_dim = MeshType::num_space_dim;
+
+    auto owned_space = local_grid.indexSpace( Own(), entity_type, Local() );
+    auto ghosted_space = local_grid.indexSpace( Ghost(), entity_type, Local() );
+
+    // The sweeps of a block may only depend on ghosted entities.
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        if ( owned_space.min( d ) - ghosted_space.min( d ) <
+                 num_step * stencil_width ||
+             ghosted_space.max( d ) - owned_space.max( d ) <
+                 num_step * stencil_width )
+            throw std::logic_error(
+                "Temporal block sweeps exceed the halo width" );
+    }
+
+    Kokkos::Profiling::pushRegion( "Cajita::grid_temporal_block_for" );
+
+    // Divide the owned entities into tiles.
+    auto own_min = owned_space.min();
+    auto own_max = owned_space.max();
+    auto ghost_min = ghosted_space.min();
+    auto ghost_max = ghosted_space.max();
+    Kokkos::Array<int, num_space_dim> num_tile;
+    int total_tile = 1;
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        num_tile[d] = ( owned_space.extent( d ) + tile[d] - 1 ) / tile[d];
+        total_tile *= num_tile[d];
+    }
+
+    // Apply all sweeps to each tile.
+    using policy_type = Kokkos::TeamPolicy<ExecutionSpace>;
+    Kokkos::parallel_for(
+        label, policy_type( exec_space, total_tile, Kokkos::AUTO ),
+        KOKKOS_LAMBDA( const typename policy_type::member_type& team ) {
+            // Locate the tile.
+            Kokkos::Array<long, num_space_dim> tile_min;
+            Kokkos::Array<long, num_space_dim> tile_max;
+            int t = team.league_rank();
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                tile_min[d] = own_min[d] + ( t % num_tile[d] ) * tile[d];
+                tile_max[d] = tile_min[d] + tile[d];
+                if ( tile_max[d] > own_max[d] )
+                    tile_max[d] = own_max[d];
+                t /= num_tile[d];
+            }
+
+            for ( int s = 0; s < num_step; ++s )
+            {
+                // Extend the tile by the remaining skew and clip it to the
+                // entities with valid inputs for this sweep.
+                long skew = ( num_step - 1 - s ) * stencil_width;
+                long shrink = ( s + 1 ) * stencil_width;
+                Kokkos::Array<long, num_space_dim> step_min;
+                Kokkos::Array<long, num_space_dim> step_extent;
+                long size = 1;
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                {
+                    long lo = tile_min[d] - skew;
+                    if ( lo < ghost_min[d] + shrink )
+                        lo = ghost_min[d] + shrink;
+                    long hi = tile_max[d] + skew;
+                    if ( hi > ghost_max[d] - shrink )
+                        hi = ghost_max[d] - shrink;
+                    step_min[d] = lo;
+                    step_extent[d] = hi - lo;
+                    size *= step_extent[d];
+                }
+
+                Kokkos::parallel_for( Kokkos::TeamThreadRange( team, size ),
+                                      [&]( const long n ) {
+                                          Impl::temporalBlockApply(
+                                              functor, s, step_min,
+                                              step_extent, n );
+                                      } );
+                team.team_barrier();
+            }
+        } );
+
+    Kokkos::Profiling::popRegion();
+}
+
 //---------------------------------------------------------------------------//
 // Grid Parallel Reduce
 //---------------------------------------------------------------------------//
@@ -0,0 +1,511 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_ParticleGridHalo.hpp
+  \brief Particle halo construction from grid cell ownership
+*/
+#ifndef CAJITA_PARTICLEGRIDHALO_HPP
+#define CAJITA_PARTICLEGRIDHALO_HPP
+
+#include <Cabana_Halo.hpp>
+#include <Cabana_LinkedCellList.hpp>
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_ParticleGridDistributor.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Cajita
+{
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Particle halo built from the grid decomposition.
+
+  \tparam DeviceType Device type of the particle data.
+
+  \tparam NumSpaceDim The spatial dimension of the grid.
+
+  Wraps a Cabana::Halo whose exports are the locally owned particles within
+  the halo width of each neighboring block. Ghosts received across a global
+  periodic boundary must have their positions shifted into the ghosted domain
+  of the receiving block; the shift for every ghost is stored here and is
+  applied to the positions after each gather.
+*/
+template <class DeviceType, std::size_t NumSpaceDim>
+class ParticleGridHalo
+{
+  public:
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+    //! Particle halo type.
+    using halo_type = Cabana::Halo<device_type>;
+    //! Periodic ghost shift view type. The shifts of each neighbor are
+    //! communicated as a contiguous block of rows.
+    using shift_view_type =
+        Kokkos::View<double**, Kokkos::LayoutRight, device_type>;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+
+    /*!
+      \brief Constructor.
+      \param halo The particle halo.
+      \param ghost_shifts The periodic position shift of each ghost.
+    */
+    ParticleGridHalo( const halo_type& halo,
+                      const shift_view_type& ghost_shifts )
+        : _halo( halo )
+        , _ghost_shifts( ghost_shifts )
+    {
+    }
+
+    //! Get the particle halo for use with Cabana::gather and Cabana::scatter.
+    const halo_type& halo() const { return _halo; }
+
+    //! Get the number of locally owned particles.
+    std::size_t numLocal() const { return _halo.numLocal(); }
+
+    //! Get the number of ghost particles.
+    std::size_t numGhost() const { return _halo.numGhost(); }
+
+    //! Get the periodic position shift of each ghost.
+    shift_view_type ghostShifts() const { return _ghost_shifts; }
+
+    /*!
+      \brief Shift the ghost positions through the periodic boundaries after
+      they have been gathered.
+      \param positions The gathered particle positions, of size numLocal() +
+      numGhost().
+    */
+    template <class PositionSliceType>
+    void shiftGhosts( PositionSliceType& positions ) const
+    {
+        if ( positions.size() != numLocal() + numGhost() )
+            throw std::runtime_error(
+                "Positions are the wrong size for ghost shifting!" );
+
+        auto shifts = _ghost_shifts;
+        std::size_t num_local = numLocal();
+        Kokkos::parallel_for(
+            "Cajita::ParticleGridHalo::shiftGhosts",
+            Kokkos::RangePolicy<execution_space>( 0, numGhost() ),
+            KOKKOS_LAMBDA( const std::size_t g ) {
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    positions( num_local + g, d ) += shifts( g, d );
+            } );
+        Kokkos::fence();
+    }
+
+  private:
+    halo_type _halo;
+    shift_view_type _ghost_shifts;
+};
+
+namespace Impl
+{
+//! \cond Impl
+
+// Geometry of the region of the local domain sent to each neighbor.
+template <std::size_t NumSpaceDim>
+struct ParticleGridHaloGeometry
+{
+    Kokkos::Array<double, NumSpaceDim> inner_low;
+    Kokkos::Array<double, NumSpaceDim> inner_high;
+    Kokkos::Array<double, NumSpaceDim> low_shift;
+    Kokkos::Array<double, NumSpaceDim> high_shift;
+
+    // Logical direction of neighbor n [n = ni + 3*(nj + 3*nk)].
+    KOKKOS_INLINE_FUNCTION
+    static int direction( const int n, const std::size_t d )
+    {
+        int npower = 1;
+        for ( std::size_t dp = 0; dp < d; ++dp )
+            npower *= 3;
+        return ( n / npower ) % 3 - 1;
+    }
+
+    // Check if a particle must be ghosted on the neighbor in direction n.
+    template <class PositionSliceType>
+    KOKKOS_INLINE_FUNCTION bool inHalo( const PositionSliceType& positions,
+                                        const std::size_t p,
+                                        const int n ) const
+    {
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        {
+            int dir = direction( n, d );
+            if ( dir < 0 && !( positions( p, d ) < inner_low[d] ) )
+                return false;
+            if ( dir > 0 && !( positions( p, d ) > inner_high[d] ) )
+                return false;
+        }
+        return true;
+    }
+
+    // Position shift of a particle ghosted in direction n.
+    KOKKOS_INLINE_FUNCTION
+    double shift( const int n, const std::size_t d ) const
+    {
+        int dir = direction( n, d );
+        if ( dir < 0 )
+            return low_shift[d];
+        else if ( dir > 0 )
+            return high_shift[d];
+        return 0.0;
+    }
+};
+
+// Build the linked cell list over the local domain with cells at least one
+// halo width wide, padded by one cell on each side to catch particles
+// numerically outside of the owned domain.
+template <class DeviceType, class PositionSliceType, std::size_t NumSpaceDim>
+Cabana::LinkedCellList<DeviceType>
+createBoundaryCellList( const PositionSliceType& positions,
+                        const Kokkos::Array<double, NumSpaceDim>& local_low,
+                        const Kokkos::Array<double, NumSpaceDim>& local_high,
+                        const Kokkos::Array<double, NumSpaceDim>& width )
+{
+    using value_type = typename PositionSliceType::value_type;
+    value_type grid_delta[3];
+    value_type grid_min[3];
+    value_type grid_max[3];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        grid_delta[d] = width[d];
+        grid_min[d] = local_low[d] - width[d];
+        grid_max[d] = local_high[d] + width[d];
+    }
+    return Cabana::LinkedCellList<DeviceType>( positions, grid_delta, grid_min,
+                                               grid_max );
+}
+
+// A cell is on the boundary if it is within the first two layers of the
+// padded cell list, i.e. it may hold particles within one halo width of the
+// local domain boundary.
+template <class CellListType>
+KOKKOS_INLINE_FUNCTION bool isBoundaryCell( const CellListType& cell_list,
+                                            const int i, const int j,
+                                            const int k )
+{
+    return ( i < 2 || i > cell_list.numBin( 0 ) - 3 || j < 2 ||
+             j > cell_list.numBin( 1 ) - 3 || k < 2 ||
+             k > cell_list.numBin( 2 ) - 3 );
+}
+
+// Count the ghost exports of the particles in a boundary cell.
+template <class CellListType, class GeometryType, class PositionSliceType,
+          class TopologyView>
+KOKKOS_INLINE_FUNCTION int
+countCellExports( const CellListType& cell_list, const GeometryType& geometry,
+                  const PositionSliceType& positions,
+                  const TopologyView& topology, const int c )
+{
+    int i, j, k;
+    cell_list.ijkBinIndex( c, i, j, k );
+    if ( !isBoundaryCell( cell_list, i, j, k ) )
+        return 0;
+
+    int count = 0;
+    auto offset = cell_list.binOffset( i, j, k );
+    int size = cell_list.binSize( i, j, k );
+    int num_n = topology.extent( 0 );
+    for ( int q = 0; q < size; ++q )
+    {
+        auto p = cell_list.permutation( offset + q );
+        for ( int n = 0; n < num_n; ++n )
+            if ( n != num_n / 2 && topology( n ) >= 0 &&
+                 geometry.inHalo( positions, p, n ) )
+                ++count;
+    }
+    return count;
+}
+
+//! \endcond
+} // namespace Impl
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Build a particle halo from the grid decomposition.
+
+  Particles are binned into a linked cell list over the local domain with
+  cells one halo width wide so that only the particles in the boundary cells
+  are checked against the halo region of each neighboring block. Every
+  particle within the halo width of a neighbor (face, edge, or corner) is
+  exported to that neighbor, with the shift needed to move it through any
+  global periodic boundary.
+
+  \tparam LocalGridType Cajita LocalGrid type.
+
+  \tparam PositionSliceType Particle position type.
+
+  \param local_grid The local grid containing periodicity and system bound
+  information.
+
+  \param positions The locally owned particle positions. All particles are
+  expected to be within the local domain (e.g. after particleGridMigrate).
+
+  \param halo_width Number of mesh cell widths of particles to ghost.
+
+  \return ParticleGridHalo for gathering and scattering particle data.
+*/
+template <class LocalGridType, class PositionSliceType>
+ParticleGridHalo<typename PositionSliceType::device_type,
+                 LocalGridType::num_space_dim>
+createParticleGridHalo( const LocalGridType& local_grid,
+                        const PositionSliceType& positions,
+                        const int halo_width )
+{
+    using grid_type = LocalGridType;
+    static constexpr std::size_t num_space_dim = grid_type::num_space_dim;
+    using mesh_type = typename grid_type::mesh_type;
+    using scalar_type = typename mesh_type::scalar_type;
+    using uniform_type = UniformMesh<scalar_type, num_space_dim>;
+    static_assert( std::is_same<mesh_type, uniform_type>::value,
+                   "Particle grid halo requires a uniform mesh." );
+    static_assert( 3 == num_space_dim,
+                   "Particle grid halo requires a 3d grid for the linked "
+                   "cell list." );
+
+    using device_type = typename PositionSliceType::device_type;
+    using execution_space = typename PositionSliceType::execution_space;
+    using particle_halo_type = ParticleGridHalo<device_type, num_space_dim>;
+
+    Kokkos::Profiling::pushRegion( "Cajita::createParticleGridHalo" );
+
+    // Get the local and global domains.
+    const auto& local_mesh =
+        Cajita::createLocalMesh<Kokkos::HostSpace>( local_grid );
+    const auto& global_grid = local_grid.globalGrid();
+    const auto& global_mesh = global_grid.globalMesh();
+
+    Kokkos::Array<double, num_space_dim> local_low{};
+    Kokkos::Array<double, num_space_dim> local_high{};
+    Kokkos::Array<double, num_space_dim> width{};
+    Impl::ParticleGridHaloGeometry<num_space_dim> geometry;
+    for ( std::size_t d = 0; d < num_space_dim; ++d )
+    {
+        local_low[d] = local_mesh.lowCorner( Cajita::Own(), d );
+        local_high[d] = local_mesh.highCorner( Cajita::Own(), d );
+        width[d] = halo_width * global_mesh.cellSize( d );
+        geometry.inner_low[d] = local_low[d] + width[d];
+        geometry.inner_high[d] = local_high[d] - width[d];
+
+        // Particles sent through the global low boundary appear above the
+        // global high boundary on the receiving rank and vice versa.
+        bool periodic = global_grid.isPeriodic( d );
+        geometry.low_shift[d] = ( periodic && global_grid.onLowBoundary( d ) )
+                                    ? global_mesh.extent( d )
+                                    : 0.0;
+        geometry.high_shift[d] =
+            ( periodic && global_grid.onHighBoundary( d ) )
+                ? -global_mesh.extent( d )
+                : 0.0;
+    }
+
+    // Get all 26 neighbor ranks.
+    auto topology = Impl::getTopology( local_grid );
+    Kokkos::View<int*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+        topology_host( topology.data(), topology.size() );
+    auto topology_mirror =
+        Kokkos::create_mirror_view_and_copy( device_type(), topology_host );
+
+    // Bin the particles so only the boundary cells are visited.
+    auto cell_list = Impl::createBoundaryCellList<device_type>(
+        positions, local_low, local_high, width );
+    Kokkos::RangePolicy<execution_space> cell_policy( 0,
+                                                      cell_list.totalBins() );
+
+    // Count the exports.
+    int num_export = 0;
+    Kokkos::parallel_reduce(
+        "Cajita::createParticleGridHalo::count", cell_policy,
+        KOKKOS_LAMBDA( const int c, int& result ) {
+            result += Impl::countCellExports( cell_list, geometry, positions,
+                                              topology_mirror, c );
+        },
+        num_export );
+
+    // Fill the export ids and ranks.
+    Kokkos::View<int*, device_type> export_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "export_ids" ), num_export );
+    Kokkos::View<int*, device_type> export_ranks(
+        Kokkos::ViewAllocateWithoutInitializing( "export_ranks" ),
+        num_export );
+    Kokkos::parallel_scan(
+        "Cajita::createParticleGridHalo::fill", cell_policy,
+        KOKKOS_LAMBDA( const int c, int& update, const bool final_pass ) {
+            if ( final_pass )
+            {
+                int i, j, k;
+                cell_list.ijkBinIndex( c, i, j, k );
+                if ( Impl::isBoundaryCell( cell_list, i, j, k ) )
+                {
+                    auto offset = cell_list.binOffset( i, j, k );
+                    int size = cell_list.binSize( i, j, k );
+                    int num_n = topology_mirror.extent( 0 );
+                    int e = update;
+                    for ( int q = 0; q < size; ++q )
+                    {
+                        int p = cell_list.permutation( offset + q );
+                        for ( int n = 0; n < num_n; ++n )
+                            if ( n != num_n / 2 && topology_mirror( n ) >= 0 &&
+                                 geometry.inHalo( positions, p, n ) )
+                            {
+                                export_ids( e ) = p;
+                                export_ranks( e ) = topology_mirror( n );
+                                ++e;
+                            }
+                    }
+                }
+            }
+            update += Impl::countCellExports( cell_list, geometry, positions,
+                                              topology_mirror, c );
+        } );
+    Kokkos::fence();
+
+    // Create the Cabana halo.
+    typename particle_halo_type::halo_type halo(
+        global_grid.comm(), positions.size(), export_ids, export_ranks,
+        topology );
+
+    // Compute the shift of each entry in the gather send buffer. A particle
+    // may be sent to the same rank through several directions (e.g. a single
+    // periodic block) so each buffer entry claims one of the matching
+    // directions of its particle.
+    int num_neighbor = halo.numNeighbor();
+    Kokkos::View<int*, Kokkos::HostSpace> neighbor_info_host(
+        "neighbor_info", 2 * num_neighbor + 1 );
+    neighbor_info_host( 0 ) = 0;
+    for ( int n = 0; n < num_neighbor; ++n )
+    {
+        neighbor_info_host( n + 1 ) =
+            neighbor_info_host( n ) + halo.numExport( n );
+        neighbor_info_host( num_neighbor + 1 + n ) = halo.neighborRank( n );
+    }
+    auto neighbor_info = Kokkos::create_mirror_view_and_copy(
+        device_type(), neighbor_info_host );
+
+    auto steering = halo.getExportSteering();
+    Kokkos::View<int*, device_type> claimed( "claimed", positions.size() );
+    typename particle_halo_type::shift_view_type send_shifts(
+        Kokkos::ViewAllocateWithoutInitializing( "send_shifts" ),
+        halo.totalNumExport(), num_space_dim );
+    Kokkos::parallel_for(
+        "Cajita::createParticleGridHalo::shifts",
+        Kokkos::RangePolicy<execution_space>( 0, halo.totalNumExport() ),
+        KOKKOS_LAMBDA( const int b ) {
+            int nb = 0;
+            while ( b >= neighbor_info( nb + 1 ) )
+                ++nb;
+            int rank = neighbor_info( num_neighbor + 1 + nb );
+            int p = steering( b );
+            int num_n = topology_mirror.extent( 0 );
+            for ( int n = 0; n < num_n; ++n )
+            {
+                if ( n != num_n / 2 && topology_mirror( n ) == rank &&
+                     geometry.inHalo( positions, p, n ) )
+                {
+                    int bit = 1 << n;
+                    if ( !( Kokkos::atomic_fetch_or( &claimed( p ), bit ) &
+                            bit ) )
+                    {
+                        for ( std::size_t d = 0; d < num_space_dim; ++d )
+                            send_shifts( b, d ) = geometry.shift( n, d );
+                        break;
+                    }
+                }
+            }
+        } );
+    Kokkos::fence();
+
+    // Send the shifts to the ranks ghosting the particles. The receive order
+    // matches the order ghosts are received in a gather.
+    typename particle_halo_type::shift_view_type ghost_shifts(
+        Kokkos::ViewAllocateWithoutInitializing( "ghost_shifts" ),
+        halo.totalNumImport(), num_space_dim );
+    const int mpi_tag = 3456;
+    std::vector<MPI_Request> requests( num_neighbor );
+    std::pair<std::size_t, std::size_t> recv_range = { 0, 0 };
+    for ( int n = 0; n < num_neighbor; ++n )
+    {
+        recv_range.second = recv_range.first + halo.numImport( n );
+        auto recv_subview =
+            Kokkos::subview( ghost_shifts, recv_range, Kokkos::ALL );
+        MPI_Irecv( recv_subview.data(), recv_subview.size(), MPI_DOUBLE,
+                   halo.neighborRank( n ), mpi_tag, halo.comm(),
+                   &( requests[n] ) );
+        recv_range.first = recv_range.second;
+    }
+    std::pair<std::size_t, std::size_t> send_range = { 0, 0 };
+    for ( int n = 0; n < num_neighbor; ++n )
+    {
+        send_range.second = send_range.first + halo.numExport( n );
+        auto send_subview =
+            Kokkos::subview( send_shifts, send_range, Kokkos::ALL );
+        MPI_Send( send_subview.data(), send_subview.size(), MPI_DOUBLE,
+                  halo.neighborRank( n ), mpi_tag, halo.comm() );
+        send_range.first = send_range.second;
+    }
+    std::vector<MPI_Status> status( num_neighbor );
+    const int ec =
+        MPI_Waitall( requests.size(), requests.data(), status.data() );
+    if ( MPI_SUCCESS != ec )
+        throw std::logic_error( "Failed MPI Communication" );
+
+    Kokkos::Profiling::popRegion();
+
+    return particle_halo_type( halo, ghost_shifts );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Gather particle data into the ghosts of a particle grid halo and
+  shift the ghost positions through the periodic boundaries.
+
+  \tparam ParticleGridHaloType ParticleGridHalo type.
+
+  \tparam ParticleContainer AoSoA type.
+
+  \tparam PositionSliceType Particle position slice type.
+
+  \param halo The particle grid halo.
+
+  \param particles The particle AoSoA, of size numLocal() + numGhost().
+
+  \param positions The positions slice of the particle AoSoA.
+*/
+template <class ParticleGridHaloType, class ParticleContainer,
+          class PositionSliceType>
+void particleGridGather( const ParticleGridHaloType& halo,
+                         ParticleContainer& particles,
+                         PositionSliceType& positions )
+{
+    Cabana::gather( halo.halo(), particles );
+    halo.shiftGhosts( positions );
+}
+
+} // namespace Cajita
+
+#endif // end CAJITA_PARTICLEGRIDHALO_HPP
@@ -27,17 +27,418 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
 #include <array>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <set>
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Cajita
+{
+namespace Impl
+{
+// Local contributions to the dot products of an iteration of pipelined
+// conjugate gradient. The members are contiguous so they may be reduced
+// across ranks as one buffer.
+template <class Scalar>
+struct PipelinedCGDots
+{
+    // (r,u)
+    Scalar gamma = 0.0;
+    // (w,u)
+    Scalar delta = 0.0;
+    // (r,r)
+    Scalar rr = 0.0;
+
+    KOKKOS_INLINE_FUNCTION
+    PipelinedCGDots& operator+=( const PipelinedCGDots& rhs )
+    {
+        gamma += rhs.gamma;
+        delta += rhs.delta;
+        rr += rhs.rr;
+        return *this;
+    }
+};
+} // end namespace Impl
+} // end namespace Cajita
+
+namespace Kokkos
+{
+template <class Scalar>
+struct reduction_identity<Cajita::Impl::PipelinedCGDots<Scalar>>
+{
+    KOKKOS_FORCEINLINE_FUNCTION static Cajita::Impl::PipelinedCGDots<Scalar>
+    sum()
+    {
+        return Cajita::Impl::PipelinedCGDots<Scalar>();
+    }
+};
+} // end namespace Kokkos
+//! \endcond
+
 namespace Cajita
 {
+//---------------------------------------------------------------------------//
+// Structured operators.
+//---------------------------------------------------------------------------//
+/*
+  A structured operator applies a linear operator to a vector at a single
+  entity. It provides the width of the halo it reads from and a device
+  evaluation (3d and 2d):
+
+    int stencilWidth() const;
+
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION Scalar operator()( const VectorType& v,
+                                              const int i, const int j,
+                                              const int k ) const;
+
+  where v(i,j,k) returns the value of the operand vector at a local
+  entity. Operands are zero in the ghosts of non-periodic boundaries.
+*/
+//! \cond Impl
+namespace Impl
+{
+// Read access to the first component of a vector.
+template <class ViewType>
+struct VectorAccessor
+{
+    ViewType view;
+
+    KOKKOS_INLINE_FUNCTION auto operator()( const int i, const int j,
+                                            const int k ) const
+    {
+        return view( i, j, k, 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION auto operator()( const int i, const int j ) const
+    {
+        return view( i, j, 0 );
+    }
+};
+
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION VectorAccessor<ViewType>
+createVectorAccessor( const ViewType& view )
+{
+    return VectorAccessor<ViewType>{ view };
+}
+
+// Read access to the first component of x + a*y computed on the fly.
+template <class ViewX, class ViewY, class Scalar>
+struct AxpyVectorAccessor
+{
+    ViewX x_view;
+    ViewY y_view;
+    Scalar a;
+
+    KOKKOS_INLINE_FUNCTION Scalar operator()( const int i, const int j,
+                                              const int k ) const
+    {
+        return x_view( i, j, k, 0 ) + a * y_view( i, j, k, 0 );
+    }
+
+    KOKKOS_INLINE_FUNCTION Scalar operator()( const int i, const int j ) const
+    {
+        return x_view( i, j, 0 ) + a * y_view( i, j, 0 );
+    }
+};
+
+template <class ViewX, class ViewY, class Scalar>
+KOKKOS_INLINE_FUNCTION AxpyVectorAccessor<ViewX, ViewY, Scalar>
+createAxpyVectorAccessor( const ViewX& x_view, const ViewY& y_view,
+                          const Scalar a )
+{
+    return AxpyVectorAccessor<ViewX, ViewY, Scalar>{ x_view, y_view, a };
+}
+
+// Operator with explicitly stored stencil entries at every entity.
+template <class StencilView, class ValuesView>
+struct StencilMatrixOperator
+{
+    StencilView stencil;
+    ValuesView values;
+    int width;
+
+    using value_type = typename ValuesView::value_type;
+
+    int stencilWidth() const { return width; }
+
+    // Only apply the stencil entry if it is nonzero.
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION value_type operator()( const VectorType& v,
+                                                  const int i, const int j,
+                                                  const int k ) const
+    {
+        value_type result = 0.0;
+        for ( unsigned c = 0; c < stencil.extent( 0 ); ++c )
+            if ( fabs( values( i, j, k, c ) ) > 0.0 )
+                result += values( i, j, k, c ) *
+                          v( i + stencil( c, Dim::I ), j + stencil( c, Dim::J ),
+                             k + stencil( c, Dim::K ) );
+        return result;
+    }
+
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION value_type operator()( const VectorType& v,
+                                                  const int i,
+                                                  const int j ) const
+    {
+        value_type result = 0.0;
+        for ( unsigned c = 0; c < stencil.extent( 0 ); ++c )
+            if ( fabs( values( i, j, c ) ) > 0.0 )
+                result += values( i, j, c ) * v( i + stencil( c, Dim::I ),
+                                                 j + stencil( c, Dim::J ) );
+        return result;
+    }
+};
+
+// Identity operator.
+template <class Scalar>
+struct IdentityOperator
+{
+    int stencilWidth() const { return 0; }
+
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION Scalar operator()( const VectorType& v,
+                                              const int i, const int j,
+                                              const int k ) const
+    {
+        return v( i, j, k );
+    }
+
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION Scalar operator()( const VectorType& v,
+                                              const int i,
+                                              const int j ) const
+    {
+        return v( i, j );
+    }
+};
+
+template <class StencilView, class ValuesView>
+StencilMatrixOperator<StencilView, ValuesView>
+createStencilMatrixOperator( const StencilView& stencil,
+                             const ValuesView& values, const int width )
+{
+    return StencilMatrixOperator<StencilView, ValuesView>{ stencil, values,
+                                                           width };
+}
+} // end namespace Impl
+//! \endcond
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Constant coefficient stencil operator.
+
+  The stencil coefficients are the same at every entity and are stored once
+  instead of once per entity. Boundary conditions come from the operand
+  ghosts which are zero on non-periodic boundaries (homogeneous Dirichlet).
+
+  \tparam Scalar Scalar value type.
+  \tparam NumSpaceDim Spatial dimension.
+  \tparam DeviceType Kokkos device type.
+*/
+template <class Scalar, std::size_t NumSpaceDim, class DeviceType>
+class ConstantStencilOperator
+{
+  public:
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = NumSpaceDim;
+
+    /*!
+      \brief Constructor.
+      \param stencil The (i,j,k) offsets of the stencil entries.
+      \param coefficients The coefficient of each stencil entry.
+    */
+    ConstantStencilOperator(
+        const std::vector<std::array<int, num_space_dim>>& stencil,
+        const std::vector<Scalar>& coefficients )
+        : _width( 0 )
+    {
+        if ( stencil.size() != coefficients.size() )
+            throw std::logic_error(
+                "Stencil and coefficients must have the same size" );
+
+        // Copy the stencil and coefficients to the device.
+        _stencil = Kokkos::View<int* [num_space_dim], DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "constant_stencil" ),
+            stencil.size() );
+        _coefficients = Kokkos::View<Scalar*, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "constant_coefficients" ),
+            coefficients.size() );
+        auto stencil_mirror =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), _stencil );
+        auto coefficients_mirror =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), _coefficients );
+        for ( unsigned s = 0; s < stencil.size(); ++s )
+        {
+            coefficients_mirror( s ) = coefficients[s];
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+            {
+                stencil_mirror( s, d ) = stencil[s][d];
+                _width = std::max( _width, std::abs( stencil[s][d] ) );
+            }
+        }
+        Kokkos::deep_copy( _stencil, stencil_mirror );
+        Kokkos::deep_copy( _coefficients, coefficients_mirror );
+    }
+
+    //! Get the width of the halo read by the stencil.
+    int stencilWidth() const { return _width; }
+
+    //! Apply the operator to a vector at a 3d entity.
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION Scalar operator()( const VectorType& v,
+                                              const int i, const int j,
+                                              const int k ) const
+    {
+        Scalar result = 0.0;
+        for ( unsigned c = 0; c < _stencil.extent( 0 ); ++c )
+            result += _coefficients( c ) * v( i + _stencil( c, Dim::I ),
+                                              j + _stencil( c, Dim::J ),
+                                              k + _stencil( c, Dim::K ) );
+        return result;
+    }
+
+    //! Apply the operator to a vector at a 2d entity.
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION Scalar operator()( const VectorType& v,
+                                              const int i, const int j ) const
+    {
+        Scalar result = 0.0;
+        for ( unsigned c = 0; c < _stencil.extent( 0 ); ++c )
+            result += _coefficients( c ) * v( i + _stencil( c, Dim::I ),
+                                              j + _stencil( c, Dim::J ) );
+        return result;
+    }
+
+  private:
+    Kokkos::View<int* [num_space_dim], DeviceType> _stencil;
+    Kokkos::View<Scalar*, DeviceType> _coefficients;
+    int _width;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Matrix-free operator defined by a user functor.
+
+  The functor is called as f(v,i,j,k) (3d) or f(v,i,j) (2d) on the device and
+  returns the operator applied to the vector v at the given entity. It may
+  read v at most stencil_width entities away in each dimension.
+
+  \tparam Functor Device functor type.
+*/
+template <class Functor>
+class MatrixFreeOperator
+{
+  public:
+    /*!
+      \brief Constructor.
+      \param functor The device functor applying the operator.
+      \param stencil_width The width of the halo read by the functor.
+    */
+    MatrixFreeOperator( const Functor& functor, const int stencil_width )
+        : _functor( functor )
+        , _width( stencil_width )
+    {
+    }
+
+    //! Get the width of the halo read by the functor.
+    int stencilWidth() const { return _width; }
+
+    //! Apply the operator to a vector at a 3d entity.
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION auto operator()( const VectorType& v, const int i,
+                                            const int j, const int k ) const
+    {
+        return _functor( v, i, j, k );
+    }
+
+    //! Apply the operator to a vector at a 2d entity.
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION auto operator()( const VectorType& v, const int i,
+                                            const int j ) const
+    {
+        return _functor( v, i, j );
+    }
+
+  private:
+    Functor _functor;
+    int _width;
+};
+
+//---------------------------------------------------------------------------//
+//! Creation function for a constant coefficient stencil operator.
+template <class Scalar, class DeviceType, std::size_t NumSpaceDim>
+ConstantStencilOperator<Scalar, NumSpaceDim, DeviceType>
+createConstantStencilOperator(
+    const std::vector<std::array<int, NumSpaceDim>>& stencil,
+    const std::vector<Scalar>& coefficients )
+{
+    return ConstantStencilOperator<Scalar, NumSpaceDim, DeviceType>(
+        stencil, coefficients );
+}
+
+//! Creation function for a matrix-free operator.
+template <class Functor>
+MatrixFreeOperator<Functor> createMatrixFreeOperator( const Functor& functor,
+                                                      const int stencil_width )
+{
+    return MatrixFreeOperator<Functor>( functor, stencil_width );
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Reference structured preconditioner interface.
+
+  A preconditioner applied to a whole vector at once, such as a multigrid
+  cycle, instead of a stencil applied at each entity. It must be a fixed
+  symmetric positive definite linear operator for use with conjugate
+  gradient.
+*/
+template <class Scalar, class EntityType, class MeshType, class DeviceType>
+class ReferenceStructuredPreconditioner
+{
+  public:
+    //! Entity type.
+    using entity_type = EntityType;
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Scalar value type.
+    using value_type = Scalar;
+    //! Array type.
+    using Array_t = Array<Scalar, EntityType, MeshType, DeviceType>;
+    //! Vector type. Vectors are single component subarrays.
+    using Vector_t = typename decltype( createSubarray(
+        std::declval<const Array_t&>(), 0, 1 ) )::element_type;
+
+    // Destructor.
+    virtual ~ReferenceStructuredPreconditioner() {}
+
+    //! Setup the preconditioner.
+    virtual void setup() = 0;
+
+    /*!
+      \brief Apply the preconditioner z = M r.
+      \param r The vector to precondition. Only owned values are read.
+      \param z The preconditioned vector. Only owned values are written.
+    */
+    virtual void apply( const Vector_t& r, Vector_t& z ) = 0;
+};
+
 //---------------------------------------------------------------------------//
 //! Reference preconditioned structured solver interface.
 template <class Scalar, class EntityType, class MeshType, class DeviceType>
@@ -180,6 +581,7 @@ class ReferenceConjugateGradient
         , _print_level( 0 )
         , _num_iter( 0 )
         , _residual_norm( 0.0 )
+        , _pipelined( false )
     {
         // Array layout for vectors (p_old,z,r_old,q,p_new,r_new).
         auto vector_layout =
@@ -200,7 +602,7 @@ class ReferenceConjugateGradient
         const std::vector<std::array<int, num_space_dim>>& stencil,
         const bool is_symmetric = false ) override
     {
-        setStencil( stencil, is_symmetric, _A_stencil, _A_halo, _A );
+        setStencil( stencil, is_symmetric, _A_stencil, _A, _A_halos );
     }
 
     /*!
@@ -225,7 +627,7 @@ class ReferenceConjugateGradient
         const std::vector<std::array<int, num_space_dim>>& stencil,
         const bool is_symmetric = false ) override
     {
-        setStencil( stencil, is_symmetric, _M_stencil, _M_halo, _M );
+        setStencil( stencil, is_symmetric, _M_stencil, _M, _M_halos );
     }
 
     /*!
@@ -250,8 +652,53 @@ class ReferenceConjugateGradient
         _print_level = print_level;
     }
 
+    /*!
+      \brief Use the pipelined conjugate gradient variant.
+
+      The pipelined variant (Ghysels and Vanroose) fuses the dot products of
+      an iteration into a single non-blocking global reduction and overlaps it
+      with the preconditioner and matrix application of the next iteration.
+      The halo gathers of those applications are in turn overlapped with
+      their interior computation. It trades one global synchronization per
+      iteration for four extra vectors and slightly weaker numerical
+      stability. The residual norm is the unpreconditioned |r|_2 / |b|_2.
+
+      \param pipelined If true solve with the pipelined variant.
+    */
+    void setPipelined( const bool pipelined )
+    {
+        _pipelined = pipelined;
+        if ( _pipelined && !_pipelined_vectors )
+        {
+            // Array layout for vectors (r,u,w,m,n,z,q,s,p,x).
+            auto vector_layout = createArrayLayout(
+                _vectors->layout()->localGrid(), 10, EntityType() );
+            _pipelined_vectors = createArray<Scalar, DeviceType>(
+                "pipelined_cg_vectors", vector_layout );
+        }
+    }
+
+    /*!
+      \brief Set a preconditioner applied to whole vectors.
+
+      If set, the preconditioner is used instead of the preconditioner
+      stencil or operator. It is setup with the solver.
+
+      \param preconditioner The preconditioner.
+    */
+    void setPreconditioner(
+        const std::shared_ptr<ReferenceStructuredPreconditioner<
+            Scalar, EntityType, MeshType, DeviceType>>& preconditioner )
+    {
+        _preconditioner = preconditioner;
+    }
+
     //! Setup the problem.
-    void setup() override {}
+    void setup() override
+    {
+        if ( _preconditioner )
+            _preconditioner->setup();
+    }
 
     /*!
       \brief Solve the problem Ax = b for x.
@@ -259,9 +706,75 @@ class ReferenceConjugateGradient
       \param x The solution.
     */
     void solve( const Array_t& b, Array_t& x ) override
+    {
+        auto A = Impl::createStencilMatrixOperator( _A_stencil, _A->view(),
+                                                    _A_halos.width );
+        if ( _preconditioner )
+        {
+            solveImpl( A, _A_halos, Impl::IdentityOperator<Scalar>(),
+                       operatorHalos( 0 ), b, x );
+        }
+        else
+        {
+            auto M = Impl::createStencilMatrixOperator(
+                _M_stencil, _M->view(), _M_halos.width );
+            solveImpl( A, _A_halos, M, _M_halos, b, x );
+        }
+    }
+
+    /*!
+      \brief Solve the problem Ax = b for x with matrix-free operators.
+
+      The matrix and preconditioner are structured operators (see
+      ConstantStencilOperator and MatrixFreeOperator) applied on the fly
+      instead of stencils with values stored at every entity. The ghosts of
+      the LHS on non-periodic boundaries must be zero.
+
+      \param A The matrix operator.
+      \param M The preconditioner operator. Not used if a preconditioner was
+      set with setPreconditioner().
+      \param b The forcing term.
+      \param x The solution.
+    */
+    template <class MatrixOperator, class PreconditionerOperator>
+    void solve( const MatrixOperator& A, const PreconditionerOperator& M,
+                const Array_t& b, Array_t& x )
+    {
+        if ( _preconditioner )
+            solveImpl( A, operatorHalos( A.stencilWidth() ),
+                       Impl::IdentityOperator<Scalar>(), operatorHalos( 0 ),
+                       b, x );
+        else
+            solveImpl( A, operatorHalos( A.stencilWidth() ), M,
+                       operatorHalos( M.stencilWidth() ), b, x );
+    }
+
+    /*!
+      \brief Solve the problem AX = B for a block of right-hand sides.
+
+      Each degree-of-freedom of B is an independent right-hand side with the
+      same matrix and preconditioner. The systems are iterated together with
+      classic preconditioned conjugate gradient: each matrix and
+      preconditioner entry is read once per entity for all systems and the
+      dot products of all systems are combined into a single global
+      reduction. Systems that converge are frozen while the rest continue.
+      The iteration count is that of the slowest system and the residual
+      norm is the largest over all systems.
+
+      \param b The forcing terms.
+      \param x The solutions. Must have the same number of
+      degrees-of-freedom per entity as b.
+    */
+    void solveMultiple( const Array_t& b, Array_t& x )
     {
         Kokkos::Profiling::pushRegion(
-            "Cajita::ReferenceStructuredSolver::solve" );
+            "Cajita::ReferenceStructuredSolver::solveMultiple" );
+
+        // Number of systems.
+        const int num_rhs = b.layout()->dofsPerEntity();
+        if ( x.layout()->dofsPerEntity() != num_rhs )
+            throw std::runtime_error(
+                "Number of LHS and RHS vectors does not match" );
 
         // Get the local grid.
         auto local_grid = _vectors->layout()->localGrid();
@@ -269,92 +782,287 @@ class ReferenceConjugateGradient
         // Print banner
         if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
             std::cout << std::endl
-                      << "Preconditioned conjugate gradient" << std::endl;
+                      << "Preconditioned block conjugate gradient with "
+                      << num_rhs << " right-hand sides" << std::endl;
 
         // Index space.
         auto entity_space =
             local_grid->indexSpace( Own(), EntityType(), Local() );
 
         // Subarrays.
-        auto p_old = createSubarray( *_vectors, 0, 1 );
-        auto z = createSubarray( *_vectors, 1, 2 );
-        auto r_old = createSubarray( *_vectors, 2, 3 );
-        auto q = createSubarray( *_vectors, 3, 4 );
-        auto p_new = createSubarray( *_vectors, 4, 5 );
-        auto r_new = createSubarray( *_vectors, 5, 6 );
-        auto A_halo_vectors = createSubarray( *_vectors, 0, 2 );
-        auto M_halo_vectors = createSubarray( *_vectors, 2, 4 );
+        updateBlockVectors( num_rhs );
+        auto p = createSubarray( *_block_vectors.vectors, 0, num_rhs );
+        auto r = createSubarray( *_block_vectors.vectors, num_rhs,
+                                 2 * num_rhs );
+        auto z = createSubarray( *_block_vectors.vectors, 2 * num_rhs,
+                                 3 * num_rhs );
+        auto q = createSubarray( *_block_vectors.vectors, 3 * num_rhs,
+                                 4 * num_rhs );
 
         // Views.
         auto x_view = x.view();
         auto b_view = b.view();
-        auto M_view = _M->view();
-        auto A_view = _A->view();
-        auto p_old_view = p_old->view();
+        auto p_view = p->view();
+        auto r_view = r->view();
         auto z_view = z->view();
-        auto r_old_view = r_old->view();
         auto q_view = q->view();
-        auto p_new_view = p_new->view();
-        auto r_new_view = r_new->view();
+
+        // Step lengths of each system.
+        Kokkos::View<Scalar*, DeviceType> coeffs( "block_cg_coeffs",
+                                                  num_rhs );
+        auto coeffs_host =
+            Kokkos::create_mirror_view( Kokkos::HostSpace(), coeffs );
 
         // Reset iteration count.
         _num_iter = 0;
 
-        // Compute the norm of the RHS.
-        std::vector<Scalar> b_norm( 1 );
-        ArrayOp::norm2( b, b_norm );
-
         // Copy the LHS into p so we can gather it.
-        Kokkos::deep_copy( p_old_view, x_view );
-
-        // Gather the LHS through gatheing p and z.
-        _A_halo->gather( execution_space(), *A_halo_vectors );
-
-        // Compute the initial residual and norm.
-        _residual_norm = 0.0;
-        auto compute_r0 = createComputeR0( _A_stencil, A_view, p_old_view,
-                                           b_view, r_old_view );
-        grid_parallel_reduce(
-            "compute_r0", execution_space(), entity_space,
-            std::integral_constant<std::size_t, num_space_dim>{}, compute_r0,
-            _residual_norm );
-
-        // Finish the global norm reduction.
-        MPI_Allreduce( MPI_IN_PLACE, &_residual_norm, 1,
-                       MpiTraits<Scalar>::type(), MPI_SUM,
-                       local_grid->globalGrid().comm() );
+        Kokkos::deep_copy( p_view, x_view );
+        _block_vectors.A_halo->gather( execution_space(), *p );
+
+        // Compute the initial residuals along with the norms of the RHS.
+        std::vector<Scalar> r0_dots( 2 * num_rhs );
+        blockReduce( "block_r0",
+                     createBlockResidual( _A_stencil, _A->view(), p_view,
+                                          b_view, r_view, num_rhs ),
+                     r0_dots );
+        std::vector<Scalar> b_norm( num_rhs );
+        std::vector<Scalar> residual_norm( num_rhs );
+        for ( int n = 0; n < num_rhs; ++n )
+        {
+            b_norm[n] = std::sqrt( r0_dots[num_rhs + n] );
+            residual_norm[n] = std::sqrt( r0_dots[n] ) / b_norm[n];
+        }
 
         // If we already have met our criteria then return.
-        _residual_norm = std::sqrt( _residual_norm ) / b_norm[0];
+        _residual_norm = *std::max_element( residual_norm.begin(),
+                                            residual_norm.end() );
         if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
             std::cout << "Iteration " << _num_iter
-                      << ": |r|_2 / |b|_2 = " << _residual_norm << std::endl;
+                      << ": max |r|_2 / |b|_2 = " << _residual_norm
+                      << std::endl;
         if ( _residual_norm <= _tol )
+        {
+            Kokkos::Profiling::popRegion();
             return;
+        }
 
-        // r and q.
-        _M_halo->gather( execution_space(), *M_halo_vectors );
+        // Compute the initial preconditioned residuals and search directions.
+        std::vector<Scalar> zTr_old( num_rhs );
+        applyBlockPreconditioner( *r, *z, zTr_old );
+        Kokkos::deep_copy( p_view, z_view );
 
-        // Compute the initial preconditioned residual.
-        Scalar zTr_old = 0.0;
-        auto compute_z0 = createComputeZ0( _M_stencil, M_view, p_old_view,
-                                           p_new_view, r_old_view, z_view );
-        grid_parallel_reduce(
-            "compute_z0", execution_space(), entity_space,
-            std::integral_constant<std::size_t, num_space_dim>{}, compute_z0,
-            zTr_old );
+        // Iterate.
+        bool converged = false;
+        std::vector<Scalar> zTr_new( num_rhs );
+        std::vector<Scalar> pTAp( num_rhs );
+        while ( _residual_norm > _tol && _num_iter < _max_iter )
+        {
+            // Compute A*p and pT*A*p.
+            _block_vectors.A_halo->gather( execution_space(), *p );
+            blockReduce( "block_cg_q",
+                         createBlockStencilProduct( _A_stencil, _A->view(),
+                                                    p_view, q_view ),
+                         pTAp );
+
+            // Update x and r. Converged systems are not changed.
+            for ( int n = 0; n < num_rhs; ++n )
+                coeffs_host( n ) = ( residual_norm[n] > _tol )
+                                       ? zTr_old[n] / pTAp[n]
+                                       : 0.0;
+            Kokkos::deep_copy( coeffs, coeffs_host );
+            grid_parallel_for(
+                "block_cg_update_x_r", execution_space(), entity_space,
+                createBlockUpdateXR( x_view, r_view, p_view, q_view, coeffs,
+                                     num_rhs ) );
+
+            // Compute the preconditioned residuals and zTr.
+            applyBlockPreconditioner( *r, *z, zTr_new );
+
+            // Update residual norms.
+            for ( int n = 0; n < num_rhs; ++n )
+                if ( residual_norm[n] > _tol )
+                    residual_norm[n] =
+                        std::sqrt( fabs( zTr_new[n] ) ) / b_norm[n];
+            _residual_norm = *std::max_element( residual_norm.begin(),
+                                                residual_norm.end() );
 
-        // Finish computation of zTr
-        MPI_Allreduce( MPI_IN_PLACE, &zTr_old, 1, MpiTraits<Scalar>::type(),
+            // Increment iteration count.
+            _num_iter++;
+
+            // Output result
+            if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+                std::cout << "Iteration " << _num_iter
+                          << ": max |r|_2 / |b|_2 = " << _residual_norm
+                          << std::endl;
+
+            // Check for convergence.
+            if ( _residual_norm <= _tol )
+            {
+                converged = true;
+                break;
+            }
+
+            // Update p.
+            for ( int n = 0; n < num_rhs; ++n )
+                coeffs_host( n ) = ( residual_norm[n] > _tol )
+                                       ? zTr_new[n] / zTr_old[n]
+                                       : 0.0;
+            Kokkos::deep_copy( coeffs, coeffs_host );
+            grid_parallel_for(
+                "block_cg_update_p", execution_space(), entity_space,
+                createBlockUpdateP( p_view, z_view, coeffs, num_rhs ) );
+
+            // Update zTr
+            zTr_old = zTr_new;
+        }
+
+        // Output end state.
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Finished in " << _num_iter
+                      << " iterations, converged to " << _residual_norm
+                      << std::endl
+                      << std::endl;
+
+        Kokkos::Profiling::popRegion();
+
+        // If we didn't converge throw.
+        if ( !converged )
+            throw std::runtime_error( "Block CG solver did not converge" );
+    }
+
+    //! Get the number of iterations taken on the last solve.
+    int getNumIter() override { return _num_iter; }
+
+    //! Get the relative residual norm achieved on the last solve.
+    double getFinalRelativeResidualNorm() override { return _residual_norm; }
+
+  private:
+    // Halos of the solver vectors for applying an operator.
+    struct VectorHalos
+    {
+        // Halo of a pair of contiguous vectors.
+        std::shared_ptr<Halo<memory_space>> pair;
+        // Halo of a single vector.
+        std::shared_ptr<Halo<memory_space>> single;
+        // Width of the halo.
+        int width = 0;
+    };
+
+    // Solve the problem Ax = b for x with the given operators.
+    template <class OperatorA, class OperatorM>
+    void solveImpl( const OperatorA& A, const VectorHalos& A_halos,
+                    const OperatorM& M, const VectorHalos& M_halos,
+                    const Array_t& b, Array_t& x )
+    {
+        if ( _pipelined )
+        {
+            solvePipelined( A, A_halos, M, M_halos, b, x );
+            return;
+        }
+
+        Kokkos::Profiling::pushRegion(
+            "Cajita::ReferenceStructuredSolver::solve" );
+
+        // Get the local grid.
+        auto local_grid = _vectors->layout()->localGrid();
+
+        // Print banner
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << std::endl
+                      << "Preconditioned conjugate gradient" << std::endl;
+
+        // Index space.
+        auto entity_space =
+            local_grid->indexSpace( Own(), EntityType(), Local() );
+
+        // Subarrays.
+        auto p_old = createSubarray( *_vectors, 0, 1 );
+        auto z = createSubarray( *_vectors, 1, 2 );
+        auto r_old = createSubarray( *_vectors, 2, 3 );
+        auto q = createSubarray( *_vectors, 3, 4 );
+        auto p_new = createSubarray( *_vectors, 4, 5 );
+        auto r_new = createSubarray( *_vectors, 5, 6 );
+        auto A_halo_vectors = createSubarray( *_vectors, 0, 2 );
+        auto M_halo_vectors = createSubarray( *_vectors, 2, 4 );
+
+        // Views.
+        auto x_view = x.view();
+        auto b_view = b.view();
+        auto p_old_view = p_old->view();
+        auto z_view = z->view();
+        auto r_old_view = r_old->view();
+        auto q_view = q->view();
+        auto p_new_view = p_new->view();
+        auto r_new_view = r_new->view();
+
+        // Reset iteration count.
+        _num_iter = 0;
+
+        // Compute the norm of the RHS.
+        std::vector<Scalar> b_norm( 1 );
+        ArrayOp::norm2( b, b_norm );
+
+        // Copy the LHS into p so we can gather it.
+        Kokkos::deep_copy( p_old_view, x_view );
+
+        // Gather the LHS through gatheing p and z.
+        A_halos.pair->gather( execution_space(), *A_halo_vectors );
+
+        // Compute the initial residual and norm.
+        _residual_norm = 0.0;
+        auto compute_r0 =
+            createComputeR0( A, p_old_view, b_view, r_old_view );
+        grid_parallel_reduce(
+            "compute_r0", execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{}, compute_r0,
+            _residual_norm );
+
+        // Finish the global norm reduction.
+        MPI_Allreduce( MPI_IN_PLACE, &_residual_norm, 1,
+                       MpiTraits<Scalar>::type(), MPI_SUM,
+                       local_grid->globalGrid().comm() );
+
+        // If we already have met our criteria then return.
+        _residual_norm = std::sqrt( _residual_norm ) / b_norm[0];
+        if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Iteration " << _num_iter
+                      << ": |r|_2 / |b|_2 = " << _residual_norm << std::endl;
+        if ( _residual_norm <= _tol )
+            return;
+
+        // r and q.
+        M_halos.pair->gather( execution_space(), *M_halo_vectors );
+
+        // Compute the initial preconditioned residual.
+        Scalar zTr_old = 0.0;
+        auto compute_z0 =
+            createComputeZ0( M, p_old_view, p_new_view, r_old_view, z_view );
+        grid_parallel_reduce(
+            "compute_z0", execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{}, compute_z0,
+            zTr_old );
+
+        // Apply the whole vector preconditioner. The operator kernel above
+        // applied the identity.
+        if ( _preconditioner )
+        {
+            _preconditioner->apply( *r_old, *z );
+            Kokkos::deep_copy( p_old_view, z_view );
+            Kokkos::deep_copy( p_new_view, z_view );
+            zTr_old = localDot( z_view, r_old_view, entity_space );
+        }
+
+        // Finish computation of zTr
+        MPI_Allreduce( MPI_IN_PLACE, &zTr_old, 1, MpiTraits<Scalar>::type(),
                        MPI_SUM, local_grid->globalGrid().comm() );
 
         // Gather the LHS through gatheing p and z.
-        _A_halo->gather( execution_space(), *A_halo_vectors );
+        A_halos.pair->gather( execution_space(), *A_halo_vectors );
 
         // Compute A*p and pT*A*p.
         Scalar pTAp = 0.0;
-        auto compute_q0 =
-            createComputeQ0( _A_stencil, A_view, p_old_view, q_view );
+        auto compute_q0 = createComputeQ0( A, p_old_view, q_view );
         grid_parallel_reduce(
             "compute_q0", execution_space(), entity_space,
             std::integral_constant<std::size_t, num_space_dim>{}, compute_q0,
@@ -372,19 +1080,26 @@ class ReferenceConjugateGradient
         while ( _residual_norm > _tol && _num_iter < _max_iter )
         {
             // Gather r and q.
-            _M_halo->gather( execution_space(), *M_halo_vectors );
+            M_halos.pair->gather( execution_space(), *M_halo_vectors );
 
             // Kernel 1: Compute x, r, residual norm, and zTr
             alpha = zTr_old / pTAp;
             zTr_new = 0.0;
-            auto cg_kernel_1 = createKernel1(
-                _M_stencil, M_view, x_view, r_new_view, r_old_view, p_new_view,
-                p_old_view, z_view, q_view, alpha );
+            auto cg_kernel_1 =
+                createKernel1( M, x_view, r_new_view, r_old_view, p_new_view,
+                               p_old_view, z_view, q_view, alpha );
             grid_parallel_reduce(
                 "cg_kernel_1", execution_space(), entity_space,
                 std::integral_constant<std::size_t, num_space_dim>{},
                 cg_kernel_1, zTr_new );
 
+            // Apply the whole vector preconditioner.
+            if ( _preconditioner )
+            {
+                _preconditioner->apply( *r_new, *z );
+                zTr_new = localDot( z_view, r_new_view, entity_space );
+            }
+
             // Finish the global reduction on zTr and r_norm.
             MPI_Allreduce( MPI_IN_PLACE, &zTr_new, 1, MpiTraits<Scalar>::type(),
                            MPI_SUM, local_grid->globalGrid().comm() );
@@ -409,14 +1124,14 @@ class ReferenceConjugateGradient
             }
 
             // Gather p and z.
-            _A_halo->gather( execution_space(), *A_halo_vectors );
+            A_halos.pair->gather( execution_space(), *A_halo_vectors );
 
             // Kernel 2: Compute p, A*p, and p^T*A*p
             beta = zTr_new / zTr_old;
             pTAp = 0.0;
-            auto cg_kernel_2 = createKernel2(
-                _A_stencil, A_view, x_view, r_new_view, r_old_view, p_new_view,
-                p_old_view, z_view, q_view, beta );
+            auto cg_kernel_2 =
+                createKernel2( A, x_view, r_new_view, r_old_view, p_new_view,
+                               p_old_view, z_view, q_view, beta );
             grid_parallel_reduce(
                 "cg_kernel_2", execution_space(), entity_space,
                 std::integral_constant<std::size_t, num_space_dim>{},
@@ -444,20 +1159,12 @@ class ReferenceConjugateGradient
         Kokkos::Profiling::popRegion();
     }
 
-    //! Get the number of iterations taken on the last solve.
-    int getNumIter() override { return _num_iter; }
-
-    //! Get the relative residual norm achieved on the last solve.
-    double getFinalRelativeResidualNorm() override { return _residual_norm; }
-
   public:
     //! \cond Impl
-    template <class StencilA, class ViewA, class ViewOldP, class ViewB,
-              class ViewOldR>
+    template <class OperatorA, class ViewOldP, class ViewB, class ViewOldR>
     struct ComputeR0
     {
-        StencilA A_stencil;
-        ViewA A_view;
+        OperatorA A;
         ViewOldP p_old_view;
         ViewB b_view;
         ViewOldR r_old_view;
@@ -470,15 +1177,9 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. Note that we copied x into p for this
-            // operation to easily perform the gather. Only apply the
-            // stencil entry if it is greater than 0.
-            value_type Ax = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, k, c ) ) > 0.0 )
-                    Ax += A_view( i, j, k, c ) *
-                          p_old_view( i + A_stencil( c, Dim::I ),
-                                      j + A_stencil( c, Dim::J ),
-                                      k + A_stencil( c, Dim::K ), 0 );
+            // operation to easily perform the gather.
+            value_type Ax =
+                A( Impl::createVectorAccessor( p_old_view ), i, j, k );
 
             // Compute the residual.
             auto r_new = b_view( i, j, k, 0 ) - Ax;
@@ -496,14 +1197,8 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. Note that we copied x into p for this
-            // operation to easily perform the gather. Only apply the
-            // stencil entry if it is greater than 0.
-            value_type Ax = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, c ) ) > 0.0 )
-                    Ax += A_view( i, j, c ) *
-                          p_old_view( i + A_stencil( c, Dim::I ),
-                                      j + A_stencil( c, Dim::J ), 0 );
+            // operation to easily perform the gather.
+            value_type Ax = A( Impl::createVectorAccessor( p_old_view ), i, j );
 
             // Compute the residual.
             auto r_new = b_view( i, j, 0 ) - Ax;
@@ -516,22 +1211,19 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilA, class ViewA, class ViewOldP, class ViewB,
-              class ViewOldR>
-    auto createComputeR0( const StencilA& A_stencil, const ViewA& A_view,
-                          const ViewOldP& p_old_view, const ViewB& b_view,
-                          const ViewOldR& r_old_view )
+    template <class OperatorA, class ViewOldP, class ViewB, class ViewOldR>
+    auto createComputeR0( const OperatorA& A, const ViewOldP& p_old_view,
+                          const ViewB& b_view, const ViewOldR& r_old_view )
     {
-        return ComputeR0<StencilA, ViewA, ViewOldP, ViewB, ViewOldR>{
-            A_stencil, A_view, p_old_view, b_view, r_old_view };
+        return ComputeR0<OperatorA, ViewOldP, ViewB, ViewOldR>{
+            A, p_old_view, b_view, r_old_view };
     }
 
-    template <class StencilM, class ViewM, class ViewOldP, class ViewNewP,
-              class ViewOldR, class ViewZ>
+    template <class OperatorM, class ViewOldP, class ViewNewP, class ViewOldR,
+              class ViewZ>
     struct ComputeZ0
     {
-        StencilM M_stencil;
-        ViewM M_view;
+        OperatorM M;
         ViewOldP p_old_view;
         ViewNewP p_new_view;
         ViewOldR r_old_view;
@@ -544,15 +1236,10 @@ class ReferenceConjugateGradient
                     const int j, const int k, value_type& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. Only apply the stencil entry if it is
-            // greater than 0.
-            value_type Mr = 0.0;
-            for ( unsigned c = 0; c < M_stencil.extent( 0 ); ++c )
-                if ( fabs( M_view( i, j, k, c ) ) > 0.0 )
-                    Mr += M_view( i, j, k, c ) *
-                          r_old_view( i + M_stencil( c, Dim::I ),
-                                      j + M_stencil( c, Dim::J ),
-                                      k + M_stencil( c, Dim::K ), 0 );
+            // multiplication.
+            value_type Mr =
+                M( Impl::createVectorAccessor( r_old_view ), i, j, k );
+
             // Write values.
             z_view( i, j, k, 0 ) = Mr;
             p_old_view( i, j, k, 0 ) = Mr;
@@ -567,14 +1254,9 @@ class ReferenceConjugateGradient
                     const int j, value_type& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. Only apply the stencil entry if it is
-            // greater than 0.
-            value_type Mr = 0.0;
-            for ( unsigned c = 0; c < M_stencil.extent( 0 ); ++c )
-                if ( fabs( M_view( i, j, c ) ) > 0.0 )
-                    Mr += M_view( i, j, c ) *
-                          r_old_view( i + M_stencil( c, Dim::I ),
-                                      j + M_stencil( c, Dim::J ), 0 );
+            // multiplication.
+            value_type Mr = M( Impl::createVectorAccessor( r_old_view ), i, j );
+
             // Write values.
             z_view( i, j, 0 ) = Mr;
             p_old_view( i, j, 0 ) = Mr;
@@ -585,22 +1267,20 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilM, class ViewM, class ViewOldP, class ViewNewP,
-              class ViewOldR, class ViewZ>
-    auto createComputeZ0( const StencilM& M_stencil, const ViewM& M_view,
-                          const ViewOldP& p_old_view,
+    template <class OperatorM, class ViewOldP, class ViewNewP, class ViewOldR,
+              class ViewZ>
+    auto createComputeZ0( const OperatorM& M, const ViewOldP& p_old_view,
                           const ViewNewP& p_new_view,
                           const ViewOldR& r_old_view, const ViewZ& z_view )
     {
-        return ComputeZ0<StencilM, ViewM, ViewOldP, ViewNewP, ViewOldR, ViewZ>{
-            M_stencil, M_view, p_old_view, p_new_view, r_old_view, z_view };
+        return ComputeZ0<OperatorM, ViewOldP, ViewNewP, ViewOldR, ViewZ>{
+            M, p_old_view, p_new_view, r_old_view, z_view };
     }
 
-    template <class StencilA, class ViewA, class ViewOldP, class ViewQ>
+    template <class OperatorA, class ViewOldP, class ViewQ>
     struct ComputeQ0
     {
-        StencilA A_stencil;
-        ViewA A_view;
+        OperatorA A;
         ViewOldP p_old_view;
         ViewQ q_view;
 
@@ -611,16 +1291,9 @@ class ReferenceConjugateGradient
                     const int j, const int k, value_type& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. This computes the updated p vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            value_type Ap = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, k, c ) ) > 0.0 )
-                    Ap += A_view( i, j, k, c ) *
-                          ( p_old_view( i + A_stencil( c, Dim::I ),
-                                        j + A_stencil( c, Dim::J ),
-                                        k + A_stencil( c, Dim::K ), 0 ) );
+            // multiplication.
+            value_type Ap =
+                A( Impl::createVectorAccessor( p_old_view ), i, j, k );
 
             // Write values.
             q_view( i, j, k, 0 ) = Ap;
@@ -634,15 +1307,8 @@ class ReferenceConjugateGradient
                     const int j, value_type& result ) const
         {
             // Compute the local contribution from matrix-vector
-            // multiplication. This computes the updated p vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            value_type Ap = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, c ) ) > 0.0 )
-                    Ap += A_view( i, j, c ) *
-                          ( p_old_view( i + A_stencil( c, Dim::I ),
-                                        j + A_stencil( c, Dim::J ), 0 ) );
+            // multiplication.
+            value_type Ap = A( Impl::createVectorAccessor( p_old_view ), i, j );
 
             // Write values.
             q_view( i, j, 0 ) = Ap;
@@ -652,21 +1318,19 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilA, class ViewA, class ViewOldP, class ViewQ>
-    auto createComputeQ0( const StencilA& A_stencil, const ViewA& A_view,
-                          const ViewOldP& p_old_view, const ViewQ& q_view )
+    template <class OperatorA, class ViewOldP, class ViewQ>
+    auto createComputeQ0( const OperatorA& A, const ViewOldP& p_old_view,
+                          const ViewQ& q_view )
     {
-        return ComputeQ0<StencilA, ViewA, ViewOldP, ViewQ>{
-            A_stencil, A_view, p_old_view, q_view };
+        return ComputeQ0<OperatorA, ViewOldP, ViewQ>{ A, p_old_view, q_view };
     }
 
-    template <class StencilM, class ViewM, class ViewX, class ViewNewR,
-              class ViewOldR, class ViewOldP, class ViewNewP, class ViewZ,
-              class ViewQ, class ValueType>
+    template <class OperatorM, class ViewX, class ViewNewR, class ViewOldR,
+              class ViewOldP, class ViewNewP, class ViewZ, class ViewQ,
+              class ValueType>
     struct Kernel1
     {
-        StencilM M_stencil;
-        ViewM M_view;
+        OperatorM M;
         ViewX x_view;
         ViewNewR r_new_view;
         ViewOldR r_old_view;
@@ -682,18 +1346,10 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. This computes the updated q vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            ValueType Mr = 0.0;
-            for ( unsigned c = 0; c < M_stencil.extent( 0 ); ++c )
-                if ( fabs( M_view( i, j, k, c ) ) > 0.0 )
-                    Mr += M_view( i, j, k, c ) *
-                          ( r_old_view( i + M_stencil( c, Dim::I ),
-                                        j + M_stencil( c, Dim::J ),
-                                        k + M_stencil( c, Dim::K ), 0 ) -
-                            alpha * q_view( i + M_stencil( c, Dim::I ),
-                                            j + M_stencil( c, Dim::J ),
-                                            k + M_stencil( c, Dim::K ), 0 ) );
+            // in-line to avoid another kernel launch.
+            ValueType Mr = M( Impl::createAxpyVectorAccessor( r_old_view,
+                                                              q_view, -alpha ),
+                              i, j, k );
 
             // Compute the updated x.
             ValueType x_new =
@@ -721,16 +1377,10 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. This computes the updated q vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            ValueType Mr = 0.0;
-            for ( unsigned c = 0; c < M_stencil.extent( 0 ); ++c )
-                if ( fabs( M_view( i, j, c ) ) > 0.0 )
-                    Mr += M_view( i, j, c ) *
-                          ( r_old_view( i + M_stencil( c, Dim::I ),
-                                        j + M_stencil( c, Dim::J ), 0 ) -
-                            alpha * q_view( i + M_stencil( c, Dim::I ),
-                                            j + M_stencil( c, Dim::J ), 0 ) );
+            // in-line to avoid another kernel launch.
+            ValueType Mr = M( Impl::createAxpyVectorAccessor( r_old_view,
+                                                              q_view, -alpha ),
+                              i, j );
 
             // Compute the updated x.
             ValueType x_new = x_view( i, j, 0 ) + alpha * p_new_view( i, j, 0 );
@@ -751,28 +1401,27 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilM, class ViewM, class ViewX, class ViewNewR,
-              class ViewOldR, class ViewOldP, class ViewNewP, class ViewZ,
-              class ViewQ, class ValueType>
-    auto createKernel1( const StencilM& M_stencil, const ViewM& M_view,
-                        const ViewX& x_view, const ViewNewR& r_new_view,
-                        const ViewOldR& r_old_view, const ViewNewP& p_new_view,
-                        const ViewOldP& p_old_view, const ViewZ& z_view,
-                        const ViewQ& q_view, const ValueType& alpha )
+    template <class OperatorM, class ViewX, class ViewNewR, class ViewOldR,
+              class ViewOldP, class ViewNewP, class ViewZ, class ViewQ,
+              class ValueType>
+    auto createKernel1( const OperatorM& M, const ViewX& x_view,
+                        const ViewNewR& r_new_view, const ViewOldR& r_old_view,
+                        const ViewNewP& p_new_view, const ViewOldP& p_old_view,
+                        const ViewZ& z_view, const ViewQ& q_view,
+                        const ValueType& alpha )
     {
-        return Kernel1<StencilM, ViewM, ViewX, ViewNewR, ViewOldR, ViewOldP,
+        return Kernel1<OperatorM, ViewX, ViewNewR, ViewOldR, ViewOldP,
                        ViewNewP, ViewZ, ViewQ, ValueType>{
-            M_stencil,  M_view,     x_view, r_new_view, r_old_view,
-            p_new_view, p_old_view, z_view, q_view,     alpha };
+            M,          x_view, r_new_view, r_old_view, p_new_view,
+            p_old_view, z_view, q_view,     alpha };
     }
 
-    template <class StencilA, class ViewA, class ViewX, class ViewNewR,
-              class ViewOldR, class ViewOldP, class ViewNewP, class ViewZ,
-              class ViewQ, class ValueType>
+    template <class OperatorA, class ViewX, class ViewNewR, class ViewOldR,
+              class ViewOldP, class ViewNewP, class ViewZ, class ViewQ,
+              class ValueType>
     struct Kernel2
     {
-        StencilA A_stencil;
-        ViewA A_view;
+        OperatorA A;
         ViewX x_view;
         ViewNewR r_new_view;
         ViewOldR r_old_view;
@@ -788,19 +1437,10 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. This computes the updated p vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            ValueType Ap = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, k, c ) ) > 0.0 )
-                    Ap +=
-                        A_view( i, j, k, c ) *
-                        ( z_view( i + A_stencil( c, Dim::I ),
-                                  j + A_stencil( c, Dim::J ),
-                                  k + A_stencil( c, Dim::K ), 0 ) +
-                          beta * p_old_view( i + A_stencil( c, Dim::I ),
-                                             j + A_stencil( c, Dim::J ),
-                                             k + A_stencil( c, Dim::K ), 0 ) );
+            // in-line to avoid another kernel launch.
+            ValueType Ap = A(
+                Impl::createAxpyVectorAccessor( z_view, p_old_view, beta ),
+                i, j, k );
 
             // Compute the updated p.
             ValueType p_new =
@@ -823,17 +1463,10 @@ class ReferenceConjugateGradient
         {
             // Compute the local contribution from matrix-vector
             // multiplication. This computes the updated p vector
-            // in-line to avoid another kernel launch. Only apply the
-            // stencil entry if it is greater than 0.
-            ValueType Ap = 0.0;
-            for ( unsigned c = 0; c < A_stencil.extent( 0 ); ++c )
-                if ( fabs( A_view( i, j, c ) ) > 0.0 )
-                    Ap +=
-                        A_view( i, j, c ) *
-                        ( z_view( i + A_stencil( c, Dim::I ),
-                                  j + A_stencil( c, Dim::J ), 0 ) +
-                          beta * p_old_view( i + A_stencil( c, Dim::I ),
-                                             j + A_stencil( c, Dim::J ), 0 ) );
+            // in-line to avoid another kernel launch.
+            ValueType Ap = A(
+                Impl::createAxpyVectorAccessor( z_view, p_old_view, beta ),
+                i, j );
 
             // Compute the updated p.
             ValueType p_new = z_view( i, j, 0 ) + beta * p_old_view( i, j, 0 );
@@ -850,30 +1483,719 @@ class ReferenceConjugateGradient
         }
     };
 
-    template <class StencilA, class ViewA, class ViewX, class ViewNewR,
-              class ViewOldR, class ViewOldP, class ViewNewP, class ViewZ,
-              class ViewQ, class ValueType>
-    auto createKernel2( const StencilA& A_stencil, const ViewA& A_view,
-                        const ViewX& x_view, const ViewNewR& r_new_view,
-                        const ViewOldR& r_old_view, const ViewNewP& p_new_view,
-                        const ViewOldP& p_old_view, const ViewZ& z_view,
-                        const ViewQ& q_view, const ValueType& beta )
+    template <class OperatorA, class ViewX, class ViewNewR, class ViewOldR,
+              class ViewOldP, class ViewNewP, class ViewZ, class ViewQ,
+              class ValueType>
+    auto createKernel2( const OperatorA& A, const ViewX& x_view,
+                        const ViewNewR& r_new_view, const ViewOldR& r_old_view,
+                        const ViewNewP& p_new_view, const ViewOldP& p_old_view,
+                        const ViewZ& z_view, const ViewQ& q_view,
+                        const ValueType& beta )
     {
-        return Kernel2<StencilA, ViewA, ViewX, ViewNewR, ViewOldR, ViewOldP,
+        return Kernel2<OperatorA, ViewX, ViewNewR, ViewOldR, ViewOldP,
                        ViewNewP, ViewZ, ViewQ, ValueType>{
-            A_stencil,  A_view,     x_view, r_new_view, r_old_view,
-            p_new_view, p_old_view, z_view, q_view,     beta };
+            A,          x_view, r_new_view, r_old_view, p_new_view,
+            p_old_view, z_view, q_view,     beta };
+    }
+
+    template <class OperatorS, class ViewIn, class ViewOut>
+    struct OperatorProduct
+    {
+        OperatorS S;
+        ViewIn in_view;
+        ViewOut out_view;
+
+        KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                                const int k ) const
+        {
+            out_view( i, j, k, 0 ) =
+                S( Impl::createVectorAccessor( in_view ), i, j, k );
+        }
+
+        KOKKOS_INLINE_FUNCTION void operator()( const int i,
+                                                const int j ) const
+        {
+            out_view( i, j, 0 ) =
+                S( Impl::createVectorAccessor( in_view ), i, j );
+        }
+    };
+
+    template <class OperatorS, class ViewIn, class ViewOut>
+    auto createOperatorProduct( const OperatorS& S, const ViewIn& in_view,
+                                const ViewOut& out_view )
+    {
+        return OperatorProduct<OperatorS, ViewIn, ViewOut>{ S, in_view,
+                                                            out_view };
+    }
+
+    template <class ViewA, class ViewB>
+    struct LocalDot
+    {
+        ViewA a_view;
+        ViewB b_view;
+
+        using value_type = typename ViewA::value_type;
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, value_type& result ) const
+        {
+            result += a_view( i, j, k, 0 ) * b_view( i, j, k, 0 );
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, value_type& result ) const
+        {
+            result += a_view( i, j, 0 ) * b_view( i, j, 0 );
+        }
+    };
+
+    template <class ViewA, class ViewB>
+    auto createLocalDot( const ViewA& a_view, const ViewB& b_view )
+    {
+        return LocalDot<ViewA, ViewB>{ a_view, b_view };
+    }
+
+    template <class StencilView, class ValuesView, class ViewX, class ViewB,
+              class ViewR>
+    struct BlockResidual
+    {
+        typedef Scalar value_type[];
+        unsigned value_count;
+        StencilView stencil;
+        ValuesView values;
+        ViewX x_view;
+        ViewB b_view;
+        ViewR r_view;
+        int num_rhs;
+
+        BlockResidual( const StencilView& stencil_, const ValuesView& values_,
+                       const ViewX& x_view_, const ViewB& b_view_,
+                       const ViewR& r_view_, const int num_rhs_ )
+            : value_count( 2 * num_rhs_ )
+            , stencil( stencil_ )
+            , values( values_ )
+            , x_view( x_view_ )
+            , b_view( b_view_ )
+            , r_view( r_view_ )
+            , num_rhs( num_rhs_ )
+        {
+        }
+
+        // Reduces (r,r) into the first num_rhs entries and (b,b) into the
+        // rest. Each matrix entry is read once for all systems.
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, value_type result ) const
+        {
+            for ( int n = 0; n < num_rhs; ++n )
+                r_view( i, j, k, n ) = b_view( i, j, k, n );
+            for ( unsigned c = 0; c < stencil.extent( 0 ); ++c )
+            {
+                auto a = values( i, j, k, c );
+                if ( fabs( a ) > 0.0 )
+                    for ( int n = 0; n < num_rhs; ++n )
+                        r_view( i, j, k, n ) -=
+                            a * x_view( i + stencil( c, Dim::I ),
+                                        j + stencil( c, Dim::J ),
+                                        k + stencil( c, Dim::K ), n );
+            }
+            for ( int n = 0; n < num_rhs; ++n )
+            {
+                result[n] += r_view( i, j, k, n ) * r_view( i, j, k, n );
+                result[num_rhs + n] +=
+                    b_view( i, j, k, n ) * b_view( i, j, k, n );
+            }
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, value_type result ) const
+        {
+            for ( int n = 0; n < num_rhs; ++n )
+                r_view( i, j, n ) = b_view( i, j, n );
+            for ( unsigned c = 0; c < stencil.extent( 0 ); ++c )
+            {
+                auto a = values( i, j, c );
+                if ( fabs( a ) > 0.0 )
+                    for ( int n = 0; n < num_rhs; ++n )
+                        r_view( i, j, n ) -=
+                            a * x_view( i + stencil( c, Dim::I ),
+                                        j + stencil( c, Dim::J ), n );
+            }
+            for ( int n = 0; n < num_rhs; ++n )
+            {
+                result[n] += r_view( i, j, n ) * r_view( i, j, n );
+                result[num_rhs + n] += b_view( i, j, n ) * b_view( i, j, n );
+            }
+        }
+
+        KOKKOS_INLINE_FUNCTION
+        void join( value_type dst, const value_type src ) const
+        {
+            for ( unsigned n = 0; n < value_count; ++n )
+                dst[n] += src[n];
+        }
+
+        KOKKOS_INLINE_FUNCTION
+        void join( volatile value_type dst,
+                   const volatile value_type src ) const
+        {
+            for ( unsigned n = 0; n < value_count; ++n )
+                dst[n] += src[n];
+        }
+
+        KOKKOS_INLINE_FUNCTION void init( value_type sum ) const
+        {
+            for ( unsigned n = 0; n < value_count; ++n )
+                sum[n] = 0.0;
+        }
+    };
+
+    template <class StencilView, class ValuesView, class ViewX, class ViewB,
+              class ViewR>
+    auto createBlockResidual( const StencilView& stencil,
+                              const ValuesView& values, const ViewX& x_view,
+                              const ViewB& b_view, const ViewR& r_view,
+                              const int num_rhs )
+    {
+        return BlockResidual<StencilView, ValuesView, ViewX, ViewB, ViewR>(
+            stencil, values, x_view, b_view, r_view, num_rhs );
+    }
+
+    template <class StencilView, class ValuesView, class ViewIn, class ViewOut>
+    struct BlockStencilProduct
+    {
+        typedef Scalar value_type[];
+        unsigned value_count;
+        StencilView stencil;
+        ValuesView values;
+        ViewIn in_view;
+        ViewOut out_view;
+
+        BlockStencilProduct( const StencilView& stencil_,
+                             const ValuesView& values_, const ViewIn& in_view_,
+                             const ViewOut& out_view_ )
+            : value_count( in_view_.extent( ViewIn::rank - 1 ) )
+            , stencil( stencil_ )
+            , values( values_ )
+            , in_view( in_view_ )
+            , out_view( out_view_ )
+        {
+        }
+
+        // Computes out = S*in and reduces (out,in) for each system. Each
+        // stencil entry is read once for all systems.
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, value_type result ) const
+        {
+            const int num_rhs = value_count;
+            for ( int n = 0; n < num_rhs; ++n )
+                out_view( i, j, k, n ) = 0.0;
+            for ( unsigned c = 0; c < stencil.extent( 0 ); ++c )
+            {
+                auto a = values( i, j, k, c );
+                if ( fabs( a ) > 0.0 )
+                    for ( int n = 0; n < num_rhs; ++n )
+                        out_view( i, j, k, n ) +=
+                            a * in_view( i + stencil( c, Dim::I ),
+                                         j + stencil( c, Dim::J ),
+                                         k + stencil( c, Dim::K ), n );
+            }
+            for ( int n = 0; n < num_rhs; ++n )
+                result[n] += out_view( i, j, k, n ) * in_view( i, j, k, n );
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, value_type result ) const
+        {
+            const int num_rhs = value_count;
+            for ( int n = 0; n < num_rhs; ++n )
+                out_view( i, j, n ) = 0.0;
+            for ( unsigned c = 0; c < stencil.extent( 0 ); ++c )
+            {
+                auto a = values( i, j, c );
+                if ( fabs( a ) > 0.0 )
+                    for ( int n = 0; n < num_rhs; ++n )
+                        out_view( i, j, n ) +=
+                            a * in_view( i + stencil( c, Dim::I ),
+                                         j + stencil( c, Dim::J ), n );
+            }
+            for ( int n = 0; n < num_rhs; ++n )
+                result[n] += out_view( i, j, n ) * in_view( i, j, n );
+        }
+
+        KOKKOS_INLINE_FUNCTION
+        void join( value_type dst, const value_type src ) const
+        {
+            for ( unsigned n = 0; n < value_count; ++n )
+                dst[n] += src[n];
+        }
+
+        KOKKOS_INLINE_FUNCTION
+        void join( volatile value_type dst,
+                   const volatile value_type src ) const
+        {
+            for ( unsigned n = 0; n < value_count; ++n )
+                dst[n] += src[n];
+        }
+
+        KOKKOS_INLINE_FUNCTION void init( value_type sum ) const
+        {
+            for ( unsigned n = 0; n < value_count; ++n )
+                sum[n] = 0.0;
+        }
+    };
+
+    template <class StencilView, class ValuesView, class ViewIn, class ViewOut>
+    auto createBlockStencilProduct( const StencilView& stencil,
+                                    const ValuesView& values,
+                                    const ViewIn& in_view,
+                                    const ViewOut& out_view )
+    {
+        return BlockStencilProduct<StencilView, ValuesView, ViewIn, ViewOut>(
+            stencil, values, in_view, out_view );
+    }
+
+    template <class ViewX, class ViewR, class ViewP, class ViewQ,
+              class ViewCoeffs>
+    struct BlockUpdateXR
+    {
+        ViewX x_view;
+        ViewR r_view;
+        ViewP p_view;
+        ViewQ q_view;
+        ViewCoeffs alpha;
+        int num_rhs;
+
+        KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                                const int k ) const
+        {
+            for ( int n = 0; n < num_rhs; ++n )
+            {
+                x_view( i, j, k, n ) += alpha( n ) * p_view( i, j, k, n );
+                r_view( i, j, k, n ) -= alpha( n ) * q_view( i, j, k, n );
+            }
+        }
+
+        KOKKOS_INLINE_FUNCTION void operator()( const int i,
+                                                const int j ) const
+        {
+            for ( int n = 0; n < num_rhs; ++n )
+            {
+                x_view( i, j, n ) += alpha( n ) * p_view( i, j, n );
+                r_view( i, j, n ) -= alpha( n ) * q_view( i, j, n );
+            }
+        }
+    };
+
+    template <class ViewX, class ViewR, class ViewP, class ViewQ,
+              class ViewCoeffs>
+    auto createBlockUpdateXR( const ViewX& x_view, const ViewR& r_view,
+                              const ViewP& p_view, const ViewQ& q_view,
+                              const ViewCoeffs& alpha, const int num_rhs )
+    {
+        return BlockUpdateXR<ViewX, ViewR, ViewP, ViewQ, ViewCoeffs>{
+            x_view, r_view, p_view, q_view, alpha, num_rhs };
+    }
+
+    template <class ViewP, class ViewZ, class ViewCoeffs>
+    struct BlockUpdateP
+    {
+        ViewP p_view;
+        ViewZ z_view;
+        ViewCoeffs beta;
+        int num_rhs;
+
+        KOKKOS_INLINE_FUNCTION void operator()( const int i, const int j,
+                                                const int k ) const
+        {
+            for ( int n = 0; n < num_rhs; ++n )
+                p_view( i, j, k, n ) =
+                    z_view( i, j, k, n ) + beta( n ) * p_view( i, j, k, n );
+        }
+
+        KOKKOS_INLINE_FUNCTION void operator()( const int i,
+                                                const int j ) const
+        {
+            for ( int n = 0; n < num_rhs; ++n )
+                p_view( i, j, n ) =
+                    z_view( i, j, n ) + beta( n ) * p_view( i, j, n );
+        }
+    };
+
+    template <class ViewP, class ViewZ, class ViewCoeffs>
+    auto createBlockUpdateP( const ViewP& p_view, const ViewZ& z_view,
+                             const ViewCoeffs& beta, const int num_rhs )
+    {
+        return BlockUpdateP<ViewP, ViewZ, ViewCoeffs>{ p_view, z_view, beta,
+                                                       num_rhs };
+    }
+
+    template <class ViewR, class ViewU, class ViewW>
+    struct PipelinedDots
+    {
+        ViewR r_view;
+        ViewU u_view;
+        ViewW w_view;
+
+        using value_type = Impl::PipelinedCGDots<typename ViewR::value_type>;
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, value_type& result ) const
+        {
+            result.gamma += r_view( i, j, k, 0 ) * u_view( i, j, k, 0 );
+            result.delta += w_view( i, j, k, 0 ) * u_view( i, j, k, 0 );
+            result.rr += r_view( i, j, k, 0 ) * r_view( i, j, k, 0 );
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, value_type& result ) const
+        {
+            result.gamma += r_view( i, j, 0 ) * u_view( i, j, 0 );
+            result.delta += w_view( i, j, 0 ) * u_view( i, j, 0 );
+            result.rr += r_view( i, j, 0 ) * r_view( i, j, 0 );
+        }
+
+        KOKKOS_INLINE_FUNCTION
+        void join( value_type& dst, const value_type& src ) const
+        {
+            dst.gamma += src.gamma;
+            dst.delta += src.delta;
+            dst.rr += src.rr;
+        }
+
+        KOKKOS_INLINE_FUNCTION
+        void join( volatile value_type& dst,
+                   const volatile value_type& src ) const
+        {
+            dst.gamma += src.gamma;
+            dst.delta += src.delta;
+            dst.rr += src.rr;
+        }
+
+        KOKKOS_INLINE_FUNCTION void init( value_type& sum ) const
+        {
+            sum.gamma = 0.0;
+            sum.delta = 0.0;
+            sum.rr = 0.0;
+        }
+    };
+
+    template <class ViewR, class ViewU, class ViewW>
+    auto createPipelinedDots( const ViewR& r_view, const ViewU& u_view,
+                              const ViewW& w_view )
+    {
+        return PipelinedDots<ViewR, ViewU, ViewW>{ r_view, u_view, w_view };
+    }
+
+    template <class ViewVectors, class ViewX, class ValueType>
+    struct PipelinedUpdate
+    {
+        ViewVectors vectors_view;
+        ViewX x_view;
+        ValueType alpha;
+        ValueType beta;
+
+        using value_type = Impl::PipelinedCGDots<ValueType>;
+
+        // Update the recurrences of an entity in place given its vector
+        // components (r,u,w,m,n,z,q,s,p).
+        KOKKOS_INLINE_FUNCTION void update( ValueType v[9],
+                                            ValueType& x ) const
+        {
+            ValueType& r = v[0];
+            ValueType& u = v[1];
+            ValueType& w = v[2];
+            ValueType& z = v[5];
+            ValueType& q = v[6];
+            ValueType& s = v[7];
+            ValueType& p = v[8];
+            z = v[4] + beta * z;
+            q = v[3] + beta * q;
+            s = w + beta * s;
+            p = u + beta * p;
+            x += alpha * p;
+            r -= alpha * s;
+            u -= alpha * q;
+            w -= alpha * z;
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 3>&, const int i,
+                    const int j, const int k, value_type& result ) const
+        {
+            ValueType v[9];
+            for ( int l = 0; l < 9; ++l )
+                v[l] = vectors_view( i, j, k, l );
+            update( v, x_view( i, j, k, 0 ) );
+            for ( int l = 0; l < 9; ++l )
+                if ( l < 3 || l > 4 )
+                    vectors_view( i, j, k, l ) = v[l];
+
+            // Compute contributions to the dot products of the next
+            // iteration.
+            result.gamma += v[0] * v[1];
+            result.delta += v[2] * v[1];
+            result.rr += v[0] * v[0];
+        }
+
+        KOKKOS_INLINE_FUNCTION void
+        operator()( const std::integral_constant<std::size_t, 2>&, const int i,
+                    const int j, value_type& result ) const
+        {
+            ValueType v[9];
+            for ( int l = 0; l < 9; ++l )
+                v[l] = vectors_view( i, j, l );
+            update( v, x_view( i, j, 0 ) );
+            for ( int l = 0; l < 9; ++l )
+                if ( l < 3 || l > 4 )
+                    vectors_view( i, j, l ) = v[l];
+
+            // Compute contributions to the dot products of the next
+            // iteration.
+            result.gamma += v[0] * v[1];
+            result.delta += v[2] * v[1];
+            result.rr += v[0] * v[0];
+        }
+
+        KOKKOS_INLINE_FUNCTION
+        void join( value_type& dst, const value_type& src ) const
+        {
+            dst.gamma += src.gamma;
+            dst.delta += src.delta;
+            dst.rr += src.rr;
+        }
+
+        KOKKOS_INLINE_FUNCTION
+        void join( volatile value_type& dst,
+                   const volatile value_type& src ) const
+        {
+            dst.gamma += src.gamma;
+            dst.delta += src.delta;
+            dst.rr += src.rr;
+        }
+
+        KOKKOS_INLINE_FUNCTION void init( value_type& sum ) const
+        {
+            sum.gamma = 0.0;
+            sum.delta = 0.0;
+            sum.rr = 0.0;
+        }
+    };
+
+    template <class ViewVectors, class ViewX, class ValueType>
+    auto createPipelinedUpdate( const ViewVectors& vectors_view,
+                                const ViewX& x_view, const ValueType& alpha,
+                                const ValueType& beta )
+    {
+        return PipelinedUpdate<ViewVectors, ViewX, ValueType>{
+            vectors_view, x_view, alpha, beta };
     }
     //! \endcond
 
   private:
+    // Solve the problem Ax = b for x with pipelined conjugate gradient.
+    template <class OperatorA, class OperatorM>
+    void solvePipelined( const OperatorA& A, const VectorHalos& A_halos,
+                         const OperatorM& M, const VectorHalos& M_halos,
+                         const Array_t& b, Array_t& x )
+    {
+        Kokkos::Profiling::pushRegion(
+            "Cajita::ReferenceStructuredSolver::solvePipelined" );
+
+        // Get the local grid.
+        auto local_grid = _vectors->layout()->localGrid();
+        auto comm = local_grid->globalGrid().comm();
+
+        // Print banner
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << std::endl
+                      << "Pipelined preconditioned conjugate gradient"
+                      << std::endl;
+
+        // Index space.
+        auto entity_space =
+            local_grid->indexSpace( Own(), EntityType(), Local() );
+
+        // Subarrays.
+        auto r = createSubarray( *_pipelined_vectors, 0, 1 );
+        auto u = createSubarray( *_pipelined_vectors, 1, 2 );
+        auto w = createSubarray( *_pipelined_vectors, 2, 3 );
+        auto m = createSubarray( *_pipelined_vectors, 3, 4 );
+        auto n = createSubarray( *_pipelined_vectors, 4, 5 );
+        auto x_gather = createSubarray( *_pipelined_vectors, 9, 10 );
+
+        // Views.
+        auto x_view = x.view();
+        auto b_view = b.view();
+        auto vectors_view = _pipelined_vectors->view();
+
+        // Reset the vectors and the iteration count. The search direction
+        // recurrences start from zero.
+        ArrayOp::assign( *_pipelined_vectors, 0.0, Ghost() );
+        _num_iter = 0;
+
+        // Compute the norm of the RHS.
+        std::vector<Scalar> b_norm( 1 );
+        ArrayOp::norm2( b, b_norm );
+
+        // Copy the LHS so we can gather it.
+        Kokkos::deep_copy( x_gather->view(), x_view );
+        A_halos.single->gather( execution_space(), *x_gather );
+
+        // Compute the initial residual r = b - Ax.
+        Scalar r_norm = 0.0;
+        auto compute_r0 =
+            createComputeR0( A, x_gather->view(), b_view, r->view() );
+        grid_parallel_reduce(
+            "compute_r0", execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{}, compute_r0,
+            r_norm );
+
+        // Compute u = M*r.
+        if ( _preconditioner )
+        {
+            _preconditioner->apply( *r, *u );
+        }
+        else
+        {
+            M_halos.single->gather( execution_space(), *r );
+            grid_parallel_for(
+                "compute_u0", execution_space(), entity_space,
+                createOperatorProduct( M, r->view(), u->view() ) );
+        }
+
+        // Compute w = A*u.
+        A_halos.single->gather( execution_space(), *u );
+        grid_parallel_for( "compute_w0", execution_space(), entity_space,
+                           createOperatorProduct( A, u->view(), w->view() ) );
+
+        // Compute the local dot products of the first iteration.
+        Impl::PipelinedCGDots<Scalar> dots;
+        grid_parallel_reduce(
+            "compute_dots0", execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{},
+            createPipelinedDots( r->view(), u->view(), w->view() ), dots );
+
+        // Iterate.
+        bool converged = false;
+        Scalar gamma_old = 0.0;
+        Scalar alpha = 0.0;
+        Scalar beta = 0.0;
+        while ( true )
+        {
+            // Start the global reduction of the dot products.
+            static_assert( sizeof( dots ) == 3 * sizeof( Scalar ),
+                           "Dot products must be contiguous" );
+            MPI_Request dots_request;
+            MPI_Iallreduce( MPI_IN_PLACE, &dots, 3, MpiTraits<Scalar>::type(),
+                            MPI_SUM, comm, &dots_request );
+
+            // Compute m = M*w while the reduction is in flight. The halo
+            // gather of w is overlapped with the interior.
+            if ( _preconditioner )
+            {
+                _preconditioner->apply( *w, *m );
+            }
+            else
+            {
+                auto w_request =
+                    M_halos.single->gatherBegin( execution_space(), *w );
+                grid_parallel_for(
+                    "pipelined_cg_m", execution_space(), *local_grid, Own(),
+                    EntityType(), M_halos.width,
+                    [&]() {
+                        M_halos.single->gatherEnd( execution_space(),
+                                                   w_request, *w );
+                    },
+                    createOperatorProduct( M, w->view(), m->view() ) );
+            }
+
+            // Compute n = A*m while the reduction is in flight.
+            auto m_request =
+                A_halos.single->gatherBegin( execution_space(), *m );
+            grid_parallel_for(
+                "pipelined_cg_n", execution_space(), *local_grid, Own(),
+                EntityType(), A_halos.width,
+                [&]() {
+                    A_halos.single->gatherEnd( execution_space(), m_request,
+                                               *m );
+                },
+                createOperatorProduct( A, m->view(), n->view() ) );
+
+            // Finish the global reduction.
+            MPI_Wait( &dots_request, MPI_STATUS_IGNORE );
+
+            // Update residual norm
+            _residual_norm = std::sqrt( fabs( dots.rr ) ) / b_norm[0];
+
+            // Output result
+            if ( 2 == _print_level && 0 == local_grid->globalGrid().blockId() )
+                std::cout << "Iteration " << _num_iter
+                          << ": |r|_2 / |b|_2 = " << _residual_norm
+                          << std::endl;
+
+            // Check for convergence.
+            if ( _residual_norm <= _tol )
+            {
+                converged = true;
+                break;
+            }
+            if ( _num_iter >= _max_iter )
+                break;
+
+            // Compute the step sizes.
+            if ( 0 == _num_iter )
+            {
+                beta = 0.0;
+                alpha = dots.gamma / dots.delta;
+            }
+            else
+            {
+                beta = dots.gamma / gamma_old;
+                alpha = dots.gamma / ( dots.delta - beta * dots.gamma / alpha );
+            }
+            gamma_old = dots.gamma;
+
+            // Update the recurrences and compute the local dot products of
+            // the next iteration in a single pass.
+            dots = Impl::PipelinedCGDots<Scalar>();
+            grid_parallel_reduce(
+                "pipelined_cg_update", execution_space(), entity_space,
+                std::integral_constant<std::size_t, num_space_dim>{},
+                createPipelinedUpdate( vectors_view, x_view, alpha, beta ),
+                dots );
+
+            // Increment iteration count.
+            _num_iter++;
+        }
+
+        // Output end state.
+        if ( 1 <= _print_level && 0 == local_grid->globalGrid().blockId() )
+            std::cout << "Finished in " << _num_iter
+                      << " iterations, converged to " << _residual_norm
+                      << std::endl
+                      << std::endl;
+
+        Kokkos::Profiling::popRegion();
+
+        // If we didn't converge throw.
+        if ( !converged )
+            throw std::runtime_error( "CG solver did not converge" );
+    }
+
     // Set the stencil of a matrix.
     void
     setStencil( const std::vector<std::array<int, num_space_dim>>& stencil,
                 const bool is_symmetric,
                 Kokkos::View<int* [num_space_dim], DeviceType>& device_stencil,
-                std::shared_ptr<Halo<memory_space>>& halo,
-                std::shared_ptr<Array_t>& matrix )
+                std::shared_ptr<Array_t>& matrix, VectorHalos& halos )
     {
         // For now we don't support symmetry.
         if ( is_symmetric )
@@ -922,12 +2244,145 @@ class ReferenceConjugateGradient
         // Allocate the matrix.
         matrix = createArray<Scalar, DeviceType>( "matrix", matrix_layout );
 
-        // Build the halo.
+        // Build the halos.
         HaloPattern<num_space_dim> pattern;
         pattern.setNeighbors( halo_neighbors );
-        halo = createHalo( pattern, width, *matrix );
+        halos = createVectorHalos( pattern, width );
+    }
+
+    // Compute the local contribution to the dot product of two vectors.
+    template <class ViewA, class ViewB>
+    Scalar localDot( const ViewA& a_view, const ViewB& b_view,
+                     const IndexSpace<num_space_dim>& entity_space )
+    {
+        Scalar result = 0.0;
+        grid_parallel_reduce(
+            "local_dot", execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{},
+            createLocalDot( a_view, b_view ), result );
+        return result;
+    }
+
+    // Allocate the vectors of a block solve (p,r,z,q) for each system and
+    // their halos. They are rebuilt if the number of systems or the stencil
+    // widths changed since the last block solve.
+    void updateBlockVectors( const int num_rhs )
+    {
+        int A_width = _A_halos.width;
+        int M_width = _preconditioner ? 0 : _M_halos.width;
+        if ( num_rhs == _block_vectors.num_rhs &&
+             A_width == _block_vectors.A_width &&
+             M_width == _block_vectors.M_width )
+            return;
+
+        auto vector_layout = createArrayLayout(
+            _vectors->layout()->localGrid(), 4 * num_rhs, EntityType() );
+        _block_vectors.vectors = createArray<Scalar, DeviceType>(
+            "block_cg_vectors", vector_layout );
+
+        // The halos are shared by p and r.
+        auto p = createSubarray( *_block_vectors.vectors, 0, num_rhs );
+        _block_vectors.A_halo =
+            createHalo( NodeHaloPattern<num_space_dim>(), A_width, *p );
+        _block_vectors.M_halo =
+            createHalo( NodeHaloPattern<num_space_dim>(), M_width, *p );
+        _block_vectors.num_rhs = num_rhs;
+        _block_vectors.A_width = A_width;
+        _block_vectors.M_width = M_width;
     }
 
+    // Reduce a block functor over the owned entities and finish the global
+    // reduction of all systems at once.
+    template <class FunctorType>
+    void blockReduce( const std::string& label, const FunctorType& functor,
+                      std::vector<Scalar>& result )
+    {
+        auto local_grid = _vectors->layout()->localGrid();
+        auto entity_space =
+            local_grid->indexSpace( Own(), EntityType(), Local() );
+        Kokkos::View<Scalar*, Kokkos::HostSpace> result_view( result.data(),
+                                                              result.size() );
+        grid_parallel_reduce(
+            label, execution_space(), entity_space,
+            std::integral_constant<std::size_t, num_space_dim>{}, functor,
+            result_view );
+        execution_space().fence();
+        MPI_Allreduce( MPI_IN_PLACE, result.data(), result.size(),
+                       MpiTraits<Scalar>::type(), MPI_SUM,
+                       local_grid->globalGrid().comm() );
+    }
+
+    // Apply the preconditioner to the residuals of a block solve and compute
+    // zTr for each system.
+    template <class BlockVector_t>
+    void applyBlockPreconditioner( BlockVector_t& r, BlockVector_t& z,
+                                   std::vector<Scalar>& zTr )
+    {
+        if ( _preconditioner )
+        {
+            // Apply the whole vector preconditioner to each system.
+            const int num_rhs = _block_vectors.num_rhs;
+            for ( int n = 0; n < num_rhs; ++n )
+            {
+                auto r_n = createSubarray( *_block_vectors.vectors,
+                                           num_rhs + n, num_rhs + n + 1 );
+                auto z_n = createSubarray( *_block_vectors.vectors,
+                                           2 * num_rhs + n,
+                                           2 * num_rhs + n + 1 );
+                _preconditioner->apply( *r_n, *z_n );
+            }
+            ArrayOp::dot( z, r, zTr );
+        }
+        else
+        {
+            _block_vectors.M_halo->gather( execution_space(), r );
+            blockReduce( "block_cg_z",
+                         createBlockStencilProduct( _M_stencil, _M->view(),
+                                                    r.view(), z.view() ),
+                         zTr );
+        }
+    }
+
+    // Build the halos of the solver vectors for a halo pattern and width.
+    VectorHalos createVectorHalos( const HaloPattern<num_space_dim>& pattern,
+                                   const int width )
+    {
+        VectorHalos halos;
+        halos.pair =
+            createHalo( pattern, width, *createSubarray( *_vectors, 0, 2 ) );
+        halos.single =
+            createHalo( pattern, width, *createSubarray( *_vectors, 0, 1 ) );
+        halos.width = width;
+        return halos;
+    }
+
+    // Get the halos of a matrix-free operator with the given stencil
+    // width. The operator may access any neighbor so the full node pattern
+    // is used. Halos are cached by width.
+    const VectorHalos& operatorHalos( const int width )
+    {
+        auto it = _operator_halos.find( width );
+        if ( it == _operator_halos.end() )
+            it = _operator_halos
+                     .emplace( width, createVectorHalos(
+                                          NodeHaloPattern<num_space_dim>(),
+                                          width ) )
+                     .first;
+        return it->second;
+    }
+
+  private:
+    // Vectors and halos of block solves.
+    struct BlockVectors
+    {
+        std::shared_ptr<Array_t> vectors;
+        std::shared_ptr<Halo<memory_space>> A_halo;
+        std::shared_ptr<Halo<memory_space>> M_halo;
+        int num_rhs = 0;
+        int A_width = -1;
+        int M_width = -1;
+    };
+
   private:
     Scalar _tol;
     int _max_iter;
@@ -937,11 +2392,18 @@ class ReferenceConjugateGradient
     int _diag_entry;
     Kokkos::View<int* [num_space_dim], DeviceType> _A_stencil;
     Kokkos::View<int* [num_space_dim], DeviceType> _M_stencil;
-    std::shared_ptr<Halo<memory_space>> _A_halo;
-    std::shared_ptr<Halo<memory_space>> _M_halo;
+    VectorHalos _A_halos;
+    VectorHalos _M_halos;
+    std::map<int, VectorHalos> _operator_halos;
     std::shared_ptr<Array_t> _A;
     std::shared_ptr<Array_t> _M;
     std::shared_ptr<Array_t> _vectors;
+    bool _pipelined;
+    std::shared_ptr<ReferenceStructuredPreconditioner<Scalar, EntityType,
+                                                      MeshType, DeviceType>>
+        _preconditioner;
+    std::shared_ptr<Array_t> _pipelined_vectors;
+    BlockVectors _block_vectors;
 };
 
 //---------------------------------------------------------------------------//
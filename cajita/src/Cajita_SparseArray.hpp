@@ -104,6 +104,17 @@ class SparseArrayLayout
 
     //! get reference of sparse map
     SparseMapType& sparseMap() { return _map; }
+    //! get const reference of sparse map
+    const SparseMapType& sparseMap() const { return _map; }
+
+    //! get the physical cell size in each dimension
+    const Kokkos::Array<scalar_type, 3>& cellSize() const { return _cell_size; }
+
+    //! get the physical global low corner of the sparse mesh
+    const Kokkos::Array<scalar_type, 3>& globalLowCorner() const
+    {
+        return _global_low_corner;
+    }
 
     //! array size in cell
     inline uint64_t sizeCell() const { return _map.sizeCell(); }
@@ -356,6 +367,8 @@ class SparseArray
     // AoSoA-related interfaces
     //! Get AoSoA reference
     aosoa_type& aosoa() { return _data; }
+    //! Get AoSoA const reference
+    const aosoa_type& aosoa() const { return _data; }
     /*!
       \brief Get array label (description)
       \return Array label (description)
@@ -363,6 +376,9 @@ class SparseArray
     std::string label() const { return _data.label(); }
     //! Get array layout reference
     array_layout& layout() { return _layout; }
+    //! Get array layout const reference
+    KOKKOS_FUNCTION
+    const array_layout& layout() const { return _layout; }
 
     /*!
       \brief Resize the AoSoA array according to the input.
@@ -0,0 +1,637 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_SparseHalo.hpp
+  \brief Multi-node sparse grid scatter/gather
+*/
+#ifndef CAJITA_SPARSE_HALO_HPP
+#define CAJITA_SPARSE_HALO_HPP
+
+#include <Cajita_Halo.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_SparseIndexSpace.hpp>
+#include <Cajita_SparseLocalGrid.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Cabana_MemberTypes.hpp>
+#include <Cabana_SoA.hpp>
+#include <Cabana_Tuple.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace Cajita
+{
+namespace Experimental
+{
+//---------------------------------------------------------------------------//
+/*!
+  \brief Halo communication plan for sparse arrays.
+
+  Tiles are only exchanged with a neighbor if they are allocated in the
+  sparse maps of both ranks. The set of exchanged tiles is negotiated with
+  each neighbor by trading the lists of allocated tiles in the shared tile
+  index spaces. The negotiation must be repeated with updateSharedTiles()
+  whenever the sparse map of the array changes.
+
+  Entire tiles of all array members are exchanged. Only non-periodic
+  boundaries are supported as the sparse map uses global tile indices.
+
+  \tparam SparseArrayType The sparse array type.
+*/
+template <class SparseArrayType>
+class SparseHalo
+{
+  public:
+    //! Sparse array type.
+    using array_type = SparseArrayType;
+    //! Memory space.
+    using memory_space = typename array_type::memory_space;
+    //! Array entity type.
+    using entity_type = typename array_type::entity_type;
+    //! Mesh type.
+    using mesh_type = typename array_type::mesh_type;
+    //! AoSoA type.
+    using aosoa_type = typename array_type::aosoa_type;
+    //! SoA (tile) type.
+    using soa_type = typename array_type::soa_type;
+    //! Tuple (cell) type.
+    using tuple_type = typename array_type::tuple_type;
+    //! Array member types.
+    using member_types = typename array_type::member_types;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim = 3;
+    //! Least bits required to represent the cells inside a tile per dimension.
+    static constexpr unsigned long long cell_bits_per_tile_dim =
+        array_type::sparse_map_type::cell_bits_per_tile_dim;
+    //! Number of cells inside a tile.
+    static constexpr int cell_num_per_tile = array_type::vector_length;
+    //! Shared tile index space type.
+    using tile_space_type =
+        TileIndexSpace<num_space_dim, cell_bits_per_tile_dim>;
+
+    /*!
+      \brief Constructor.
+      \param pattern The halo pattern to use for halo communication.
+      \param width Halo cell width. Must be less than or equal to the halo
+      width of the local grid. Rounded up to a whole number of tiles.
+      \param local_grid The sparse local grid of the array.
+      \param array The sparse array to build the halo for.
+    */
+    template <class Pattern>
+    SparseHalo( const Pattern& pattern, const int width,
+                const std::shared_ptr<LocalGrid<mesh_type>>& local_grid,
+                const array_type& array )
+    {
+        static_assert( 3 == Pattern::num_space_dim,
+                       "SparseHalo requires a 3d halo pattern" );
+
+        // Sparse maps use global tile indices so periodic images of tiles
+        // cannot be represented.
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            if ( local_grid->globalGrid().isPeriodic( d ) )
+                throw std::logic_error(
+                    "SparseHalo does not support periodic boundaries" );
+
+        // Duplicate the communicator so we have our own communication space.
+        MPI_Comm_dup( local_grid->globalGrid().comm(), &_comm );
+
+        // Function to get the tag of a neighbor.
+        auto neighbor_id = []( const std::array<int, num_space_dim>& ijk )
+        {
+            return ( ijk[0] + 1 ) +
+                   3 * ( ( ijk[1] + 1 ) + 3 * ( ijk[2] + 1 ) );
+        };
+
+        // Get the neighbor ranks we will exchange with in the halo and the
+        // tile index spaces we share with them.
+        auto neighbors = pattern.getNeighbors();
+        for ( const auto& n : neighbors )
+        {
+            int rank = local_grid->neighborRank( n );
+            if ( rank >= 0 )
+            {
+                _neighbor_ranks.push_back( rank );
+
+                // The receiving rank sees us at the flipped offset.
+                std::array<int, num_space_dim> flip_n;
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    flip_n[d] = -n[d];
+                _send_tags.push_back( neighbor_id( n ) );
+                _receive_tags.push_back( neighbor_id( flip_n ) );
+
+                _owned_spaces.push_back(
+                    local_grid->template sharedTileIndexSpace<
+                        cell_bits_per_tile_dim>( Own(), entity_type(), n,
+                                                 width ) );
+                _ghosted_spaces.push_back(
+                    local_grid->template sharedTileIndexSpace<
+                        cell_bits_per_tile_dim>( Ghost(), entity_type(), n,
+                                                 width ) );
+            }
+        }
+
+        // Negotiate the initial set of shared tiles.
+        updateSharedTiles( typename array_type::execution_space(), array );
+    }
+
+    // Destructor.
+    ~SparseHalo() { MPI_Comm_free( &_comm ); }
+
+    /*!
+      \brief Negotiate the tiles exchanged with each neighbor. Only tiles
+      allocated on both sides of a shared tile index space are exchanged.
+      This is a collective operation over the neighbors of the halo.
+
+      \param exec_space The execution space to use for listing the tiles.
+
+      \param array The sparse array whose sparse map gives the allocated
+      tiles.
+    */
+    template <class ExecutionSpace>
+    void updateSharedTiles( const ExecutionSpace& exec_space,
+                            const array_type& array )
+    {
+        Kokkos::Profiling::pushRegion(
+            "Cajita::SparseHalo::updateSharedTiles" );
+
+        // List the allocated tiles as (tile_i,tile_j,tile_k,tile_id).
+        const auto& map = array.layout().sparseMap();
+        Kokkos::View<int* [4], memory_space> tiles(
+            Kokkos::ViewAllocateWithoutInitializing( "sparse_halo_tiles" ),
+            map.sizeTile() );
+        Kokkos::View<int, memory_space> tile_count( "sparse_halo_tile_count" );
+        Kokkos::parallel_for(
+            "Cajita::SparseHalo::list_tiles",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 map.capacity() ),
+            KOKKOS_LAMBDA( const int index ) {
+                if ( map.valid_at( index ) )
+                {
+                    auto tile_key = map.key_at( index );
+                    int n = Kokkos::atomic_fetch_add( &tile_count(), 1 );
+                    map.key2ijk( tile_key, tiles( n, 0 ), tiles( n, 1 ),
+                                 tiles( n, 2 ) );
+                    tiles( n, 3 ) = map.value_at( index );
+                }
+            } );
+        auto tiles_host =
+            Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), tiles );
+
+        // For each neighbor, collect the allocated tiles in the shared index
+        // spaces in lexicographic tile order.
+        int num_n = _neighbor_ranks.size();
+        std::vector<std::vector<std::array<int, 4>>> owned( num_n );
+        std::vector<std::vector<std::array<int, 4>>> ghosted( num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            for ( std::size_t t = 0; t < tiles_host.extent( 0 ); ++t )
+            {
+                std::array<int, 4> tile = { tiles_host( t, 0 ),
+                                            tiles_host( t, 1 ),
+                                            tiles_host( t, 2 ),
+                                            tiles_host( t, 3 ) };
+                if ( _owned_spaces[n].tileInRange( tile[0], tile[1],
+                                                   tile[2] ) )
+                    owned[n].push_back( tile );
+                if ( _ghosted_spaces[n].tileInRange( tile[0], tile[1],
+                                                     tile[2] ) )
+                    ghosted[n].push_back( tile );
+            }
+            std::sort( owned[n].begin(), owned[n].end() );
+            std::sort( ghosted[n].begin(), ghosted[n].end() );
+        }
+
+        // Exchange the number of owned and ghosted shared tiles.
+        std::vector<std::array<int, 2>> send_counts( num_n );
+        std::vector<std::array<int, 2>> receive_counts( num_n );
+        std::vector<MPI_Request> requests( 2 * num_n, MPI_REQUEST_NULL );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            MPI_Irecv( receive_counts[n].data(), 2, MPI_INT,
+                       _neighbor_ranks[n], _negotiate_tag + _receive_tags[n],
+                       _comm, &requests[n] );
+        }
+        for ( int n = 0; n < num_n; ++n )
+        {
+            send_counts[n] = { static_cast<int>( owned[n].size() ),
+                               static_cast<int>( ghosted[n].size() ) };
+            MPI_Isend( send_counts[n].data(), 2, MPI_INT, _neighbor_ranks[n],
+                       _negotiate_tag + _send_tags[n], _comm,
+                       &requests[num_n + n] );
+        }
+        MPI_Waitall( 2 * num_n, requests.data(), MPI_STATUSES_IGNORE );
+
+        // Exchange the owned and ghosted shared tile indices.
+        std::vector<std::vector<int>> send_tiles( num_n );
+        std::vector<std::vector<int>> receive_tiles( num_n );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            receive_tiles[n].resize(
+                3 * ( receive_counts[n][0] + receive_counts[n][1] ) );
+            MPI_Irecv( receive_tiles[n].data(), receive_tiles[n].size(),
+                       MPI_INT, _neighbor_ranks[n],
+                       _negotiate_tag + _receive_tags[n], _comm,
+                       &requests[n] );
+        }
+        for ( int n = 0; n < num_n; ++n )
+        {
+            for ( const auto& tile : owned[n] )
+                send_tiles[n].insert( send_tiles[n].end(), tile.begin(),
+                                      tile.begin() + 3 );
+            for ( const auto& tile : ghosted[n] )
+                send_tiles[n].insert( send_tiles[n].end(), tile.begin(),
+                                      tile.begin() + 3 );
+            MPI_Isend( send_tiles[n].data(), send_tiles[n].size(), MPI_INT,
+                       _neighbor_ranks[n], _negotiate_tag + _send_tags[n],
+                       _comm, &requests[num_n + n] );
+        }
+        MPI_Waitall( 2 * num_n, requests.data(), MPI_STATUSES_IGNORE );
+
+        // The tiles we own and send to a neighbor are the ones it also
+        // ghosts. The tiles we ghost and receive from a neighbor are the ones
+        // it also owns.
+        _owned_tiles.clear();
+        _ghosted_tiles.clear();
+        _owned_buffers.clear();
+        _ghosted_buffers.clear();
+        for ( int n = 0; n < num_n; ++n )
+        {
+            const int* neighbor_owned = receive_tiles[n].data();
+            const int* neighbor_ghosted =
+                receive_tiles[n].data() + 3 * receive_counts[n][0];
+            buildCommData( owned[n], neighbor_ghosted, receive_counts[n][1],
+                           _owned_tiles, _owned_buffers );
+            buildCommData( ghosted[n], neighbor_owned, receive_counts[n][0],
+                           _ghosted_tiles, _ghosted_buffers );
+        }
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Gather data into our ghosted tiles from their owners.
+
+      \param exec_space The execution space to use for pack/unpack.
+
+      \param array The sparse array to gather. The sparse map of the array
+      must not have changed since the shared tiles were last negotiated.
+    */
+    template <class ExecutionSpace>
+    void gather( const ExecutionSpace& exec_space,
+                 const array_type& array ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::SparseHalo::gather" );
+        exchange( ScatterReduce::Replace(), exec_space, _gather_tag,
+                  _owned_buffers, _owned_tiles, _ghosted_buffers,
+                  _ghosted_tiles, array.aosoa() );
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Scatter data from our ghosted tiles to their owners using the
+      given type of reduce operation.
+
+      \param exec_space The execution space to use for pack/unpack.
+
+      \param reduce_op The functor used to reduce the results.
+
+      \param array The sparse array to scatter. The sparse map of the array
+      must not have changed since the shared tiles were last negotiated.
+    */
+    template <class ExecutionSpace, class ReduceOp>
+    void scatter( const ExecutionSpace& exec_space, const ReduceOp& reduce_op,
+                  const array_type& array ) const
+    {
+        Kokkos::Profiling::pushRegion( "Cajita::SparseHalo::scatter" );
+        exchange( reduce_op, exec_space, _scatter_tag, _ghosted_buffers,
+                  _ghosted_tiles, _owned_buffers, _owned_tiles,
+                  array.aosoa() );
+        Kokkos::Profiling::popRegion();
+    }
+
+    //! Get the number of tiles sent to each neighbor in a gather.
+    std::vector<int> numOwnedTile() const
+    {
+        std::vector<int> num_tile;
+        for ( const auto& t : _owned_tiles )
+            num_tile.push_back( t.size() );
+        return num_tile;
+    }
+
+    //! Get the number of tiles received from each neighbor in a gather.
+    std::vector<int> numGhostedTile() const
+    {
+        std::vector<int> num_tile;
+        for ( const auto& t : _ghosted_tiles )
+            num_tile.push_back( t.size() );
+        return num_tile;
+    }
+
+  public:
+    //! Member type at a given index.
+    template <std::size_t M>
+    using member_type =
+        typename Cabana::MemberTypeAtIndex<M, member_types>::type;
+
+    //! Intersect our sorted shared tiles with the sorted tile indices of a
+    //! neighbor and allocate the buffer for the common tiles.
+    void buildCommData(
+        const std::vector<std::array<int, 4>>& tiles,
+        const int* neighbor_tiles, const int num_neighbor_tile,
+        std::vector<Kokkos::View<int*, memory_space>>& tile_ids,
+        std::vector<Kokkos::View<tuple_type*, memory_space>>& buffers )
+    {
+        std::vector<int> common_ids;
+        std::size_t t = 0;
+        int nt = 0;
+        while ( t < tiles.size() && nt < num_neighbor_tile )
+        {
+            std::array<int, 3> tile = { tiles[t][0], tiles[t][1],
+                                        tiles[t][2] };
+            std::array<int, 3> neighbor_tile = { neighbor_tiles[3 * nt],
+                                                 neighbor_tiles[3 * nt + 1],
+                                                 neighbor_tiles[3 * nt + 2] };
+            if ( tile < neighbor_tile )
+            {
+                ++t;
+            }
+            else if ( neighbor_tile < tile )
+            {
+                ++nt;
+            }
+            else
+            {
+                common_ids.push_back( tiles[t][3] );
+                ++t;
+                ++nt;
+            }
+        }
+
+        Kokkos::View<int*, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>
+            host_ids( common_ids.data(), common_ids.size() );
+        tile_ids.push_back( Kokkos::View<int*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "sparse_halo_tile_ids" ),
+            common_ids.size() ) );
+        Kokkos::deep_copy( tile_ids.back(), host_ids );
+        buffers.push_back( Kokkos::View<tuple_type*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "sparse_halo_buffer" ),
+            common_ids.size() * cell_num_per_tile ) );
+    }
+
+    //! Send the given tiles to each neighbor and reduce the tiles received
+    //! from each neighbor as they arrive.
+    template <class ReduceOp, class ExecutionSpace>
+    void exchange(
+        const ReduceOp& reduce_op, const ExecutionSpace& exec_space,
+        const int tag,
+        const std::vector<Kokkos::View<tuple_type*, memory_space>>&
+            send_buffers,
+        const std::vector<Kokkos::View<int*, memory_space>>& send_tiles,
+        const std::vector<Kokkos::View<tuple_type*, memory_space>>&
+            receive_buffers,
+        const std::vector<Kokkos::View<int*, memory_space>>& receive_tiles,
+        const aosoa_type& aosoa ) const
+    {
+        // Get the number of neighbors. Return if we have none.
+        int num_n = _neighbor_ranks.size();
+        if ( 0 == num_n )
+            return;
+
+        // Post receives.
+        std::vector<MPI_Request> requests( 2 * num_n, MPI_REQUEST_NULL );
+        for ( int n = 0; n < num_n; ++n )
+        {
+            // Only process this neighbor if there is work to do.
+            if ( 0 < receive_buffers[n].size() )
+            {
+                MPI_Irecv( receive_buffers[n].data(),
+                           receive_buffers[n].size() * sizeof( tuple_type ),
+                           MPI_BYTE, _neighbor_ranks[n],
+                           tag + _receive_tags[n], _comm, &requests[n] );
+            }
+        }
+
+        // Pack send buffers and post sends.
+        for ( int n = 0; n < num_n; ++n )
+        {
+            // Only process this neighbor if there is work to do.
+            if ( 0 < send_buffers[n].size() )
+            {
+                packBuffer( exec_space, send_buffers[n], send_tiles[n],
+                            aosoa );
+                MPI_Isend( send_buffers[n].data(),
+                           send_buffers[n].size() * sizeof( tuple_type ),
+                           MPI_BYTE, _neighbor_ranks[n], tag + _send_tags[n],
+                           _comm, &requests[num_n + n] );
+            }
+        }
+
+        // Unpack receive buffers as they arrive.
+        bool unpack_complete = false;
+        while ( !unpack_complete )
+        {
+            int unpack_index = MPI_UNDEFINED;
+            MPI_Waitany( num_n, requests.data(), &unpack_index,
+                         MPI_STATUS_IGNORE );
+            if ( MPI_UNDEFINED == unpack_index )
+                unpack_complete = true;
+            else
+                unpackBuffer( reduce_op, exec_space,
+                              receive_buffers[unpack_index],
+                              receive_tiles[unpack_index], aosoa );
+        }
+
+        // Wait on send requests.
+        MPI_Waitall( num_n, requests.data() + num_n, MPI_STATUSES_IGNORE );
+    }
+
+    //! Pack the cells of the given tiles into a buffer.
+    template <class ExecutionSpace>
+    void packBuffer( const ExecutionSpace& exec_space,
+                     const Kokkos::View<tuple_type*, memory_space>& buffer,
+                     const Kokkos::View<int*, memory_space>& tile_ids,
+                     const aosoa_type& aosoa ) const
+    {
+        Kokkos::parallel_for(
+            "Cajita::SparseHalo::pack_buffer",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 buffer.extent( 0 ) ),
+            KOKKOS_LAMBDA( const int i ) {
+                int t = i / cell_num_per_tile;
+                int c = i - t * cell_num_per_tile;
+                buffer( i ) =
+                    aosoa.getTuple( tile_ids( t ) * cell_num_per_tile + c );
+            } );
+        exec_space.fence();
+    }
+
+    //! Reduce a scalar member of a buffer cell into a tile cell.
+    template <std::size_t M, class ReduceOp>
+    KOKKOS_INLINE_FUNCTION static std::enable_if_t<
+        0 == std::rank<member_type<M>>::value, void>
+    unpackMember( const ReduceOp& reduce_op, const tuple_type& tuple,
+                  soa_type& soa, const int c )
+    {
+        Halo<memory_space>::unpackOp( reduce_op, Cabana::get<M>( tuple ),
+                                      Cabana::get<M>( soa, c ) );
+    }
+
+    //! Reduce a vector member of a buffer cell into a tile cell.
+    template <std::size_t M, class ReduceOp>
+    KOKKOS_INLINE_FUNCTION static std::enable_if_t<
+        1 == std::rank<member_type<M>>::value, void>
+    unpackMember( const ReduceOp& reduce_op, const tuple_type& tuple,
+                  soa_type& soa, const int c )
+    {
+        for ( std::size_t d0 = 0; d0 < std::extent<member_type<M>, 0>::value;
+              ++d0 )
+            Halo<memory_space>::unpackOp( reduce_op,
+                                          Cabana::get<M>( tuple, d0 ),
+                                          Cabana::get<M>( soa, c, d0 ) );
+    }
+
+    //! Reduce a matrix member of a buffer cell into a tile cell.
+    template <std::size_t M, class ReduceOp>
+    KOKKOS_INLINE_FUNCTION static std::enable_if_t<
+        2 == std::rank<member_type<M>>::value, void>
+    unpackMember( const ReduceOp& reduce_op, const tuple_type& tuple,
+                  soa_type& soa, const int c )
+    {
+        for ( std::size_t d0 = 0; d0 < std::extent<member_type<M>, 0>::value;
+              ++d0 )
+            for ( std::size_t d1 = 0;
+                  d1 < std::extent<member_type<M>, 1>::value; ++d1 )
+                Halo<memory_space>::unpackOp(
+                    reduce_op, Cabana::get<M>( tuple, d0, d1 ),
+                    Cabana::get<M>( soa, c, d0, d1 ) );
+    }
+
+    //! Reduce all members of a buffer cell into a tile cell.
+    template <class ReduceOp>
+    KOKKOS_INLINE_FUNCTION static void
+    unpackTuple( const ReduceOp& reduce_op, const tuple_type& tuple,
+                 soa_type& soa, const int c,
+                 const std::integral_constant<std::size_t, 0> )
+    {
+        unpackMember<0>( reduce_op, tuple, soa, c );
+    }
+
+    //! Reduce all members of a buffer cell into a tile cell.
+    template <class ReduceOp, std::size_t M>
+    KOKKOS_INLINE_FUNCTION static void
+    unpackTuple( const ReduceOp& reduce_op, const tuple_type& tuple,
+                 soa_type& soa, const int c,
+                 const std::integral_constant<std::size_t, M> )
+    {
+        unpackMember<M>( reduce_op, tuple, soa, c );
+        unpackTuple( reduce_op, tuple, soa, c,
+                     std::integral_constant<std::size_t, M - 1>() );
+    }
+
+    //! Reduce the cells of a buffer into the given tiles.
+    template <class ReduceOp, class ExecutionSpace>
+    void unpackBuffer( const ReduceOp& reduce_op,
+                       const ExecutionSpace& exec_space,
+                       const Kokkos::View<tuple_type*, memory_space>& buffer,
+                       const Kokkos::View<int*, memory_space>& tile_ids,
+                       const aosoa_type& aosoa ) const
+    {
+        Kokkos::parallel_for(
+            "Cajita::SparseHalo::unpack_buffer",
+            Kokkos::RangePolicy<ExecutionSpace>( exec_space, 0,
+                                                 buffer.extent( 0 ) ),
+            KOKKOS_LAMBDA( const int i ) {
+                int t = i / cell_num_per_tile;
+                int c = i - t * cell_num_per_tile;
+                unpackTuple( reduce_op, buffer( i ),
+                             aosoa.access( tile_ids( t ) ), c,
+                             std::integral_constant<std::size_t,
+                                                    member_types::size - 1>() );
+            } );
+        exec_space.fence();
+    }
+
+  private:
+    // MPI communicator.
+    MPI_Comm _comm;
+
+    // Base tags for negotiation, gathers, and scatters. This object has its
+    // own communication space so any tags will do.
+    static constexpr int _negotiate_tag = 3456;
+    static constexpr int _gather_tag = 1234;
+    static constexpr int _scatter_tag = 2345;
+
+    // The ranks we will send/receive from.
+    std::vector<int> _neighbor_ranks;
+
+    // The tag we use for sending to each neighbor.
+    std::vector<int> _send_tags;
+
+    // The tag we use for receiving from each neighbor.
+    std::vector<int> _receive_tags;
+
+    // For each neighbor, the owned tile index space shared with it.
+    std::vector<tile_space_type> _owned_spaces;
+
+    // For each neighbor, the ghosted tile index space shared with it.
+    std::vector<tile_space_type> _ghosted_spaces;
+
+    // For each neighbor, ids of the owned tiles allocated on both sides.
+    std::vector<Kokkos::View<int*, memory_space>> _owned_tiles;
+
+    // For each neighbor, ids of the ghosted tiles allocated on both sides.
+    std::vector<Kokkos::View<int*, memory_space>> _ghosted_tiles;
+
+    // For each neighbor, send/receive buffers for tiles we own.
+    std::vector<Kokkos::View<tuple_type*, memory_space>> _owned_buffers;
+
+    // For each neighbor, send/receive buffers for tiles we ghost.
+    std::vector<Kokkos::View<tuple_type*, memory_space>> _ghosted_buffers;
+};
+
+//---------------------------------------------------------------------------//
+// Creation function.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Sparse halo creation function.
+  \param pattern The pattern to build the halo from.
+  \param width Must be less than or equal to the halo width of the local grid.
+  \param local_grid The sparse local grid of the array.
+  \param array The sparse array over which to build the halo.
+*/
+template <class Pattern, class MeshType, class SparseArrayType>
+std::shared_ptr<SparseHalo<SparseArrayType>>
+createSparseHalo( const Pattern& pattern, const int width,
+                  const std::shared_ptr<LocalGrid<MeshType>>& local_grid,
+                  const SparseArrayType& array )
+{
+    static_assert( is_sparse_array<SparseArrayType>::value,
+                   "createSparseHalo requires a SparseArray" );
+    return std::make_shared<SparseHalo<SparseArrayType>>( pattern, width,
+                                                          local_grid, array );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Experimental
+} // end namespace Cajita
+
+#endif // end CAJITA_SPARSE_HALO_HPP
@@ -0,0 +1,394 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+/*!
+  \file Cajita_SparseInterpolation.hpp
+  \brief Particle-grid interpolation on sparse arrays
+*/
+#ifndef CAJITA_SPARSE_INTERPOLATION_HPP
+#define CAJITA_SPARSE_INTERPOLATION_HPP
+
+#include <Cajita_Interpolation.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_Splines.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Cabana_MemberTypes.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <type_traits>
+
+namespace Cajita
+{
+namespace Experimental
+{
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+//---------------------------------------------------------------------------//
+// Logical offset of an entity from the sparse mesh low corner in units of the
+// cell size. Sparse map indices are registered about the nearest mesh node.
+template <class EntityType>
+struct SparseEntityOffset;
+
+template <>
+struct SparseEntityOffset<Node>
+{
+    static constexpr double value = 0.0;
+};
+
+template <>
+struct SparseEntityOffset<Cell>
+{
+    static constexpr double value = 0.5;
+};
+
+//---------------------------------------------------------------------------//
+// Evaluate spline data at a point in a sparse mesh. The spline stencil is
+// given in global sparse map indices.
+template <typename Scalar, int Order, class EntityType, class DataTags>
+KOKKOS_INLINE_FUNCTION void
+evaluateSparseSpline( const Kokkos::Array<Scalar, 3>& low_corner,
+                      const Kokkos::Array<Scalar, 3>& cell_size,
+                      const Scalar p[3],
+                      SplineData<Scalar, Order, 3, EntityType, DataTags>& data )
+{
+    using spline_type = Spline<Order>;
+
+    Scalar low_x[3];
+    Scalar dx[3];
+    Scalar rdx[3];
+    Scalar x[3];
+    for ( std::size_t d = 0; d < 3; ++d )
+    {
+        dx[d] = cell_size[d];
+        rdx[d] = 1.0 / dx[d];
+        low_x[d] =
+            low_corner[d] + SparseEntityOffset<EntityType>::value * dx[d];
+        setSplineData( SplinePhysicalCellSize(), data, d, dx[d] );
+
+        x[d] = spline_type::mapToLogicalGrid( p[d], rdx[d], low_x[d] );
+        setSplineData( SplineLogicalPosition(), data, d, x[d] );
+
+        spline_type::stencil( x[d], data.s[d] );
+    }
+
+    setSplineData( SplineWeightValues(), data, x );
+    setSplineData( SplineWeightPhysicalGradients(), data, x, rdx );
+    setSplineData( SplinePhysicalDistance(), data, low_x, p, dx );
+}
+
+//---------------------------------------------------------------------------//
+// Grid view of a sparse array member over the interpolation stencil of a
+// single point. A stencil spans at most two tiles per dimension so the tile
+// ids are queried from the sparse map once at construction and every
+// stencil entry is then addressed directly within its tile.
+template <class SparseArrayType, std::size_t M>
+struct SparseStencilView
+{
+    using member_type =
+        typename Cabana::MemberTypeAtIndex<M, typename SparseArrayType::
+                                                  member_types>::type;
+    using value_type = typename std::remove_all_extents<member_type>::type;
+
+    static constexpr int cell_bits_per_tile_dim =
+        SparseArrayType::sparse_map_type::cell_bits_per_tile_dim;
+
+    static_assert( std::rank<member_type>::value <= 1,
+                   "Sparse interpolation requires scalar or vector members" );
+
+    const SparseArrayType& _array;
+    Kokkos::Array<int, 3> _tile_origin;
+    int _tile_id[2][2][2];
+
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION SparseStencilView( const SparseArrayType& array,
+                                              const SplineDataType& sd )
+        : _array( array )
+    {
+        static_assert( SplineDataType::num_knot <=
+                           ( 1 << cell_bits_per_tile_dim ) + 1,
+                       "Spline stencil must span at most two tiles" );
+
+        int num_tile[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            _tile_origin[d] = sd.s[d][0] >> cell_bits_per_tile_dim;
+            num_tile[d] = ( sd.s[d][SplineDataType::num_knot - 1] >>
+                            cell_bits_per_tile_dim ) -
+                          _tile_origin[d] + 1;
+        }
+
+        const auto& layout = _array.layout();
+        for ( int i = 0; i < num_tile[Dim::I]; ++i )
+            for ( int j = 0; j < num_tile[Dim::J]; ++j )
+                for ( int k = 0; k < num_tile[Dim::K]; ++k )
+                    _tile_id[i][j][k] = layout.queryTileFromTileId(
+                        _tile_origin[Dim::I] + i, _tile_origin[Dim::J] + j,
+                        _tile_origin[Dim::K] + k );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    value_type& operator()( const int i, const int j, const int k,
+                            const int l ) const
+    {
+        int tile_id =
+            _tile_id[( i >> cell_bits_per_tile_dim ) - _tile_origin[Dim::I]]
+                    [( j >> cell_bits_per_tile_dim ) - _tile_origin[Dim::J]]
+                    [( k >> cell_bits_per_tile_dim ) - _tile_origin[Dim::K]];
+        return entry( tile_id, { i, j, k }, l );
+    }
+
+    // Scalar members ignore the component index.
+    template <class T = member_type>
+    KOKKOS_INLINE_FUNCTION
+        std::enable_if_t<0 == std::rank<T>::value, value_type&>
+        entry( const int tile_id, const Kokkos::Array<int, 3> ijk,
+               const int ) const
+    {
+        return _array.template get<M>( tile_id, ijk );
+    }
+
+    template <class T = member_type>
+    KOKKOS_INLINE_FUNCTION
+        std::enable_if_t<1 == std::rank<T>::value, value_type&>
+        entry( const int tile_id, const Kokkos::Array<int, 3> ijk,
+               const int l ) const
+    {
+        return _array.template get<M>( tile_id, ijk, l );
+    }
+};
+
+// Sparse stencil view with the access semantics of a scatter view.
+// Contributions are accumulated with atomics.
+template <class SparseArrayType, std::size_t M>
+struct SparseStencilScatterView : public SparseStencilView<SparseArrayType, M>
+{
+    using base_type = SparseStencilView<SparseArrayType, M>;
+    using value_type = typename base_type::value_type;
+
+    template <class SplineDataType>
+    KOKKOS_INLINE_FUNCTION
+    SparseStencilScatterView( const SparseArrayType& array,
+                              const SplineDataType& sd )
+        : base_type( array, sd )
+    {
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    const SparseStencilScatterView& access() const { return *this; }
+
+    KOKKOS_INLINE_FUNCTION
+    P2G::ScratchTileReference<value_type>
+    operator()( const int i, const int j, const int k, const int l ) const
+    {
+        return { &base_type::operator()( i, j, k, l ) };
+    }
+};
+
+} // end namespace Impl
+//! \endcond
+} // end namespace Experimental
+
+//! \cond Impl
+namespace P2G
+{
+template <class SparseArrayType, std::size_t M>
+struct is_scatter_view_impl<
+    Experimental::Impl::SparseStencilScatterView<SparseArrayType, M>>
+    : public std::true_type
+{
+};
+} // end namespace P2G
+//! \endcond
+
+namespace Experimental
+{
+//---------------------------------------------------------------------------//
+// Sparse grid-to-point.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Local Grid-to-Point interpolation from a sparse array.
+
+  Each point resolves the sparse map tiles covered by its interpolation
+  stencil once and then reads the stencil entries directly from those tiles.
+  There is no sparse halo gather: all stencil entries must be registered in
+  the sparse map of this rank, e.g. with registerSparseGrid() using a radius
+  that covers the spline stencil.
+
+  \tparam M The index of the sparse array member to interpolate from.
+
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \tparam SplineOrder The order of spline interpolation to use.
+
+  \tparam DataTypes Sparse array member types (Cabana::MemberTypes).
+
+  \tparam DeviceType The device type to use for interplation.
+
+  \tparam EntityType The entity type from which the points will interpolate.
+  Either Node or Cell.
+
+  \tparam MeshType The sparse mesh type.
+
+  \tparam SparseMapType The sparse map type.
+
+  \param array The sparse array from which the point data will be
+  interpolated.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim).
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param functor A functor that interpolates from a given entity to a given
+  point.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <std::size_t M, class PointEvalFunctor, class PointCoordinates,
+          int SplineOrder, class DataTypes, class DeviceType, class EntityType,
+          class MeshType, class SparseMapType>
+void g2p( const SparseArray<DataTypes, DeviceType, EntityType, MeshType,
+                            SparseMapType>& array,
+          const PointCoordinates& points, const std::size_t num_point,
+          Spline<SplineOrder>, const PointEvalFunctor& functor )
+{
+    using array_type =
+        SparseArray<DataTypes, DeviceType, EntityType, MeshType, SparseMapType>;
+    using scalar_type = typename MeshType::scalar_type;
+    using execution_space = typename DeviceType::execution_space;
+
+    // Sparse mesh geometry.
+    auto low_corner = array.layout().globalLowCorner();
+    auto cell_size = array.layout().cellSize();
+
+    // Loop over points and interpolate from the grid.
+    Kokkos::parallel_for(
+        "sparse_g2p", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Get the point coordinates.
+            scalar_type px[3];
+            for ( std::size_t d = 0; d < 3; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Create the local spline data.
+            using sd_type = SplineData<scalar_type, SplineOrder, 3, EntityType>;
+            sd_type sd;
+            Impl::evaluateSparseSpline( low_corner, cell_size, px, sd );
+
+            // Evaluate the functor over the tiles of the stencil.
+            Impl::SparseStencilView<array_type, M> view( array, sd );
+            functor( sd, p, view );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+// Sparse point-to-grid.
+//---------------------------------------------------------------------------//
+/*!
+  \brief Local Point-to-Grid interpolation to a sparse array.
+
+  Each point resolves the sparse map tiles covered by its interpolation
+  stencil once and then accumulates into the stencil entries of those tiles
+  with atomics. There is no sparse halo scatter: all stencil entries must be
+  registered in the sparse map of this rank, e.g. with registerSparseGrid()
+  using a radius that covers the spline stencil.
+
+  \tparam M The index of the sparse array member to interpolate to.
+
+  \tparam PointEvalFunctor Functor type used to evaluate the interpolated data
+  for a given point at a given entity.
+
+  \tparam PointCoordinates Container type with view traits containing the
+  point coordinates. Will be indexed as (point,dim).
+
+  \tparam SplineOrder The order of spline interpolation to use.
+
+  \tparam DataTypes Sparse array member types (Cabana::MemberTypes).
+
+  \tparam DeviceType The device type to use for interplation.
+
+  \tparam EntityType The entity type to which the points will interpolate.
+  Either Node or Cell.
+
+  \tparam MeshType The sparse mesh type.
+
+  \tparam SparseMapType The sparse map type.
+
+  \param functor A functor that interpolates from a given point to a given
+  entity.
+
+  \param points The points over which to perform the interpolation. Will be
+  indexed as (point,dim).
+
+  \param num_point The number of points. This is the size of the first
+  dimension of points.
+
+  \param array The sparse array to which the point data will be interpolated.
+
+  \note Spline of SplineOrder passed for interpolation.
+*/
+template <std::size_t M, class PointEvalFunctor, class PointCoordinates,
+          int SplineOrder, class DataTypes, class DeviceType, class EntityType,
+          class MeshType, class SparseMapType>
+void p2g(
+    const PointEvalFunctor& functor, const PointCoordinates& points,
+    const std::size_t num_point, Spline<SplineOrder>,
+    SparseArray<DataTypes, DeviceType, EntityType, MeshType, SparseMapType>&
+        array )
+{
+    using array_type =
+        SparseArray<DataTypes, DeviceType, EntityType, MeshType, SparseMapType>;
+    using scalar_type = typename MeshType::scalar_type;
+    using execution_space = typename DeviceType::execution_space;
+
+    // Sparse mesh geometry.
+    auto low_corner = array.layout().globalLowCorner();
+    auto cell_size = array.layout().cellSize();
+
+    // Loop over points and interpolate to the grid.
+    Kokkos::parallel_for(
+        "sparse_p2g", Kokkos::RangePolicy<execution_space>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            // Get the point coordinates.
+            scalar_type px[3];
+            for ( std::size_t d = 0; d < 3; ++d )
+            {
+                px[d] = points( p, d );
+            }
+
+            // Create the local spline data.
+            using sd_type = SplineData<scalar_type, SplineOrder, 3, EntityType>;
+            sd_type sd;
+            Impl::evaluateSparseSpline( low_corner, cell_size, px, sd );
+
+            // Evaluate the functor over the tiles of the stencil.
+            Impl::SparseStencilScatterView<array_type, M> view( array, sd );
+            functor( sd, p, view );
+        } );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Experimental
+} // end namespace Cajita
+
+#endif // end CAJITA_SPARSE_INTERPOLATION_HPP
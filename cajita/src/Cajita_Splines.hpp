@@ -21,6 +21,7 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <string>
 #include <type_traits>
 
 namespace Cajita
@@ -449,6 +450,424 @@ struct Spline<3>
     }
 };
 
+//---------------------------------------------------------------------------//
+//! Quartic. Defined on the dual grid.
+template <>
+struct Spline<4>
+{
+    //! Order.
+    static constexpr int order = 4;
+
+    //! The number of non-zero knots in the spline.
+    static constexpr int num_knot = 5;
+
+    /*!
+      \brief Map a physical location to the logical space of the dual grid in a
+      single dimension.
+      \param xp The coordinate to map to the logical space.
+      \param rdx The inverse of the physical distance between grid locations.
+      \param low_x The physical location of the low corner of the dual grid.
+      \return The coordinate in the logical dual grid space.
+
+      \note Casting this result to an integer yields the index at the center
+      of the stencil.
+      \note A quartic spline uses the dual grid.
+    */
+    template <class Scalar>
+    KOKKOS_INLINE_FUNCTION static Scalar
+    mapToLogicalGrid( const Scalar xp, const Scalar rdx, const Scalar low_x )
+    {
+        return ( xp - low_x ) * rdx + 0.5;
+    }
+
+    /*!
+      \brief Get the logical space stencil offsets of the spline. The stencil
+      defines the offsets into a grid field about a logical coordinate.
+      \param indices The stencil index offsets.
+    */
+    KOKKOS_INLINE_FUNCTION
+    static void offsets( int indices[num_knot] )
+    {
+        indices[0] = -2;
+        indices[1] = -1;
+        indices[2] = 0;
+        indices[3] = 1;
+        indices[4] = 2;
+    }
+
+    /*!
+      \brief Compute the stencil indices for a given logical space location.
+      \param x0 The coordinate at which to evaluate the spline stencil.
+      \param indices The indices of the stencil.
+    */
+    template <class Scalar>
+    KOKKOS_INLINE_FUNCTION static void stencil( const Scalar x0,
+                                                int indices[num_knot] )
+    {
+        indices[0] = static_cast<int>( x0 ) - 2;
+        indices[1] = indices[0] + 1;
+        indices[2] = indices[1] + 1;
+        indices[3] = indices[2] + 1;
+        indices[4] = indices[3] + 1;
+    }
+
+    /*!
+       \brief Calculate the value of the spline at all knots.
+       \param x0 The coordinate at which to evaluate the spline in the logical
+       grid space.
+       \param values Basis values at the knots. Ordered from lowest to highest
+       in terms of knot location.
+    */
+    template <typename Scalar>
+    KOKKOS_INLINE_FUNCTION static void value( const Scalar x0,
+                                              Scalar values[num_knot] )
+    {
+        // Constants
+        Scalar one_24th = 1.0 / 24.0;
+        Scalar one_96th = 1.0 / 96.0;
+        Scalar center = 115.0 / 192.0;
+
+        // Knot at i - 2
+        Scalar xn = x0 - static_cast<int>( x0 ) + 1.5;
+        Scalar xr = 2.5 - xn;
+        Scalar xr2 = xr * xr;
+        values[0] = xr2 * xr2 * one_24th;
+
+        // Knot at i - 1
+        xn -= 1.0;
+        Scalar xn2 = xn * xn;
+        values[1] =
+            ( 55.0 + 20.0 * xn - 120.0 * xn2 + 80.0 * xn * xn2 -
+              16.0 * xn2 * xn2 ) *
+            one_96th;
+
+        // Knot at i
+        xn -= 1.0;
+        xn2 = xn * xn;
+        values[2] = center - 0.625 * xn2 + 0.25 * xn2 * xn2;
+
+        // Knot at i + 1
+        xn -= 1.0;
+        xn2 = xn * xn;
+        values[3] =
+            ( 55.0 - 20.0 * xn - 120.0 * xn2 - 80.0 * xn * xn2 -
+              16.0 * xn2 * xn2 ) *
+            one_96th;
+
+        // Knot at i + 2
+        xn -= 1.0;
+        xr = 2.5 + xn;
+        xr2 = xr * xr;
+        values[4] = xr2 * xr2 * one_24th;
+    }
+
+    /*!
+      \brief Calculate the value of the gradient of the spline in the
+      physical frame.
+      \param x0 The coordinate at which to evaluate the spline in the logical
+      grid space.
+      \param rdx The inverse of the physical distance between grid locations.
+      \param gradients Basis gradient values at the knots in the physical
+      frame. Ordered from lowest to highest in terms of knot location.
+    */
+    template <typename Scalar>
+    KOKKOS_INLINE_FUNCTION static void
+    gradient( const Scalar x0, const Scalar rdx, Scalar gradients[num_knot] )
+    {
+        // Constants
+        Scalar one_sixth = 1.0 / 6.0;
+        Scalar one_24th = 1.0 / 24.0;
+
+        // Knot at i - 2
+        Scalar xn = x0 - static_cast<int>( x0 ) + 1.5;
+        Scalar xr = 2.5 - xn;
+        gradients[0] = -xr * xr * xr * one_sixth * rdx;
+
+        // Knot at i - 1
+        xn -= 1.0;
+        Scalar xn2 = xn * xn;
+        gradients[1] =
+            ( 5.0 - 60.0 * xn + 60.0 * xn2 - 16.0 * xn * xn2 ) * one_24th *
+            rdx;
+
+        // Knot at i
+        xn -= 1.0;
+        gradients[2] = ( -1.25 * xn + xn * xn * xn ) * rdx;
+
+        // Knot at i + 1
+        xn -= 1.0;
+        xn2 = xn * xn;
+        gradients[3] =
+            ( -5.0 - 60.0 * xn - 60.0 * xn2 - 16.0 * xn * xn2 ) * one_24th *
+            rdx;
+
+        // Knot at i + 2
+        xn -= 1.0;
+        xr = 2.5 + xn;
+        gradients[4] = xr * xr * xr * one_sixth * rdx;
+    }
+};
+
+//---------------------------------------------------------------------------//
+//! Quintic. Defined on the primal grid.
+template <>
+struct Spline<5>
+{
+    //! Order.
+    static constexpr int order = 5;
+
+    //! The number of non-zero knots in the spline.
+    static constexpr int num_knot = 6;
+
+    /*!
+      \brief Map a physical location to the logical space of the primal grid in
+      a single dimension.
+      \param xp The coordinate to map to the logical space.
+      \param rdx The inverse of the physical distance between grid locations.
+      \param low_x The physical location of the low corner of the primal
+      grid.
+      \return The coordinate in the logical primal grid space.
+
+      \note Casting this result to an integer yields the index at the center
+      of the stencil.
+      \note A quintic spline uses the primal grid.
+    */
+    template <class Scalar>
+    KOKKOS_INLINE_FUNCTION static Scalar
+    mapToLogicalGrid( const Scalar xp, const Scalar rdx, const Scalar low_x )
+    {
+        return ( xp - low_x ) * rdx;
+    }
+
+    /*!
+      \brief Get the logical space stencil offsets of the spline. The stencil
+      defines the offsets into a grid field about a logical coordinate.
+      \param indices The stencil index offsets.
+    */
+    KOKKOS_INLINE_FUNCTION
+    static void offsets( int indices[num_knot] )
+    {
+        indices[0] = -2;
+        indices[1] = -1;
+        indices[2] = 0;
+        indices[3] = 1;
+        indices[4] = 2;
+        indices[5] = 3;
+    }
+
+    /*!
+      \brief Compute the stencil indices for a given logical space location.
+      \param x0 The coordinate at which to evaluate the spline stencil.
+      \param indices The indices of the stencil.
+    */
+    template <class Scalar>
+    KOKKOS_INLINE_FUNCTION static void stencil( const Scalar x0,
+                                                int indices[num_knot] )
+    {
+        indices[0] = static_cast<int>( x0 ) - 2;
+        indices[1] = indices[0] + 1;
+        indices[2] = indices[1] + 1;
+        indices[3] = indices[2] + 1;
+        indices[4] = indices[3] + 1;
+        indices[5] = indices[4] + 1;
+    }
+
+    /*!
+       \brief Calculate the value of the spline at all knots.
+       \param x0 The coordinate at which to evaluate the spline in the logical
+       grid space.
+       \param values Basis values at the knots. Ordered from lowest to highest
+       in terms of knot location.
+    */
+    template <typename Scalar>
+    KOKKOS_INLINE_FUNCTION static void value( const Scalar x0,
+                                              Scalar values[num_knot] )
+    {
+        // Constants
+        Scalar one_12th = 1.0 / 12.0;
+        Scalar one_24th = 1.0 / 24.0;
+        Scalar one_120th = 1.0 / 120.0;
+
+        // Knot at i - 2
+        Scalar xn = x0 - static_cast<int>( x0 ) + 2.0;
+        Scalar xr = 3.0 - xn;
+        Scalar xr2 = xr * xr;
+        values[0] = xr2 * xr2 * xr * one_120th;
+
+        // Knot at i - 1
+        xn -= 1.0;
+        Scalar xn2 = xn * xn;
+        values[1] = 0.425 + 0.625 * xn - 1.75 * xn2 + 1.25 * xn * xn2 -
+                    0.375 * xn2 * xn2 + xn2 * xn2 * xn * one_24th;
+
+        // Knot at i
+        xn -= 1.0;
+        xn2 = xn * xn;
+        values[2] =
+            0.55 - 0.5 * xn2 + 0.25 * xn2 * xn2 - xn2 * xn2 * xn * one_12th;
+
+        // Knot at i + 1
+        xn -= 1.0;
+        xn2 = xn * xn;
+        values[3] =
+            0.55 - 0.5 * xn2 + 0.25 * xn2 * xn2 + xn2 * xn2 * xn * one_12th;
+
+        // Knot at i + 2
+        xn -= 1.0;
+        xn2 = xn * xn;
+        values[4] = 0.425 - 0.625 * xn - 1.75 * xn2 - 1.25 * xn * xn2 -
+                    0.375 * xn2 * xn2 - xn2 * xn2 * xn * one_24th;
+
+        // Knot at i + 3
+        xn -= 1.0;
+        xr = 3.0 + xn;
+        xr2 = xr * xr;
+        values[5] = xr2 * xr2 * xr * one_120th;
+    }
+
+    /*!
+      \brief Calculate the value of the gradient of the spline in the
+      physical frame.
+      \param x0 The coordinate at which to evaluate the spline in the logical
+      grid space.
+      \param rdx The inverse of the physical distance between grid locations.
+      \param gradients Basis gradient values at the knots in the physical
+      frame. Ordered from lowest to highest in terms of knot location.
+    */
+    template <typename Scalar>
+    KOKKOS_INLINE_FUNCTION static void
+    gradient( const Scalar x0, const Scalar rdx, Scalar gradients[num_knot] )
+    {
+        // Constants
+        Scalar five_12ths = 5.0 / 12.0;
+        Scalar five_24ths = 5.0 / 24.0;
+        Scalar one_24th = 1.0 / 24.0;
+
+        // Knot at i - 2
+        Scalar xn = x0 - static_cast<int>( x0 ) + 2.0;
+        Scalar xr = 3.0 - xn;
+        Scalar xr2 = xr * xr;
+        gradients[0] = -xr2 * xr2 * one_24th * rdx;
+
+        // Knot at i - 1
+        xn -= 1.0;
+        Scalar xn2 = xn * xn;
+        gradients[1] = ( 0.625 - 3.5 * xn + 3.75 * xn2 - 1.5 * xn * xn2 +
+                         five_24ths * xn2 * xn2 ) *
+                       rdx;
+
+        // Knot at i
+        xn -= 1.0;
+        xn2 = xn * xn;
+        gradients[2] =
+            ( -xn + xn * xn2 - five_12ths * xn2 * xn2 ) * rdx;
+
+        // Knot at i + 1
+        xn -= 1.0;
+        xn2 = xn * xn;
+        gradients[3] =
+            ( -xn + xn * xn2 + five_12ths * xn2 * xn2 ) * rdx;
+
+        // Knot at i + 2
+        xn -= 1.0;
+        xn2 = xn * xn;
+        gradients[4] = ( -0.625 - 3.5 * xn - 3.75 * xn2 - 1.5 * xn * xn2 -
+                         five_24ths * xn2 * xn2 ) *
+                       rdx;
+
+        // Knot at i + 3
+        xn -= 1.0;
+        xr = 3.0 + xn;
+        xr2 = xr * xr;
+        gradients[5] = xr2 * xr2 * one_24th * rdx;
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Spline Stencil Loops
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Apply a functor to the knot indices [Begin,End). The recursion is resolved
+// at compile time so the loop is fully unrolled.
+template <int Begin, int End>
+struct SplineKnotLoop
+{
+    template <class Functor>
+    KOKKOS_FORCEINLINE_FUNCTION static void apply( const Functor& functor )
+    {
+        functor( Begin );
+        SplineKnotLoop<Begin + 1, End>::apply( functor );
+    }
+};
+
+template <int End>
+struct SplineKnotLoop<End, End>
+{
+    template <class Functor>
+    KOKKOS_FORCEINLINE_FUNCTION static void apply( const Functor& )
+    {
+    }
+};
+} // end namespace Impl
+//! \endcond
+
+/*!
+  \brief Apply a functor to each knot of a one dimensional spline stencil.
+  \tparam NumKnot The number of knots in the stencil.
+  \param functor The functor to apply. Called as functor(n) for each knot n.
+
+  The loop is unrolled at compile time through template recursion over the
+  stencil width.
+*/
+template <int NumKnot, class Functor>
+KOKKOS_FORCEINLINE_FUNCTION void splineKnotLoop( const Functor& functor )
+{
+    Impl::SplineKnotLoop<0, NumKnot>::apply( functor );
+}
+
+/*!
+  \brief Apply a functor to each knot of a spline stencil. 3D specialization.
+  \tparam SplineDataType The spline data type defining the stencil.
+  \param functor The functor to apply. Called as functor(i,j,k) for each
+  stencil entry.
+
+  All three stencil loops are unrolled at compile time.
+*/
+template <class SplineDataType, class Functor>
+KOKKOS_FORCEINLINE_FUNCTION
+    std::enable_if_t<3 == SplineDataType::num_space_dim, void>
+    splineStencilLoop( const Functor& functor )
+{
+    constexpr int num_knot = SplineDataType::num_knot;
+    splineKnotLoop<num_knot>( [&]( const int i ) {
+        splineKnotLoop<num_knot>( [&]( const int j ) {
+            splineKnotLoop<num_knot>(
+                [&]( const int k ) { functor( i, j, k ); } );
+        } );
+    } );
+}
+
+/*!
+  \brief Apply a functor to each knot of a spline stencil. 2D specialization.
+  \tparam SplineDataType The spline data type defining the stencil.
+  \param functor The functor to apply. Called as functor(i,j) for each
+  stencil entry.
+
+  Both stencil loops are unrolled at compile time.
+*/
+template <class SplineDataType, class Functor>
+KOKKOS_FORCEINLINE_FUNCTION
+    std::enable_if_t<2 == SplineDataType::num_space_dim, void>
+    splineStencilLoop( const Functor& functor )
+{
+    constexpr int num_knot = SplineDataType::num_knot;
+    splineKnotLoop<num_knot>( [&]( const int i ) {
+        splineKnotLoop<num_knot>( [&]( const int j ) { functor( i, j ); } );
+    } );
+}
+
 //---------------------------------------------------------------------------//
 // Spline Data
 //---------------------------------------------------------------------------//
@@ -769,12 +1188,12 @@ KOKKOS_INLINE_FUNCTION
 {
     using spline_type = typename SplineData<Scalar, Order, NumSpaceDim,
                                             EntityType, DataTags>::spline_type;
-    Scalar offset;
     for ( std::size_t d = 0; d < NumSpaceDim; ++d )
     {
-        offset = low_x[d] - p[d];
-        for ( int n = 0; n < spline_type::num_knot; ++n )
+        Scalar offset = low_x[d] - p[d];
+        splineKnotLoop<spline_type::num_knot>( [&]( const int n ) {
             data.d[d][n] = offset + data.s[d][n] * dx[d];
+        } );
     }
 }
 //! Physical distance spline data template helper.
@@ -854,6 +1273,635 @@ KOKKOS_INLINE_FUNCTION void evaluateSpline(
     setSplineData( SplinePhysicalDistance(), data, low_x, p, dx );
 }
 
+//---------------------------------------------------------------------------//
+//! Assign physical distance to the spline data in a non-uniform mesh.
+template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+          class EntityType, class DataTags>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<SplineData<Scalar, Order, NumSpaceDim, EntityType,
+                                DataTags>::has_physical_distance>
+    setSplineData(
+        SplinePhysicalDistance,
+        SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>& data,
+        const LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>&
+            local_mesh,
+        const Scalar p[NumSpaceDim] )
+{
+    using spline_type = typename SplineData<Scalar, Order, NumSpaceDim,
+                                            EntityType, DataTags>::spline_type;
+    int knot_id[NumSpaceDim];
+    Scalar knot_x[NumSpaceDim];
+    for ( int n = 0; n < spline_type::num_knot; ++n )
+    {
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            knot_id[d] = data.s[d][n];
+        local_mesh.coordinates( EntityType(), knot_id, knot_x );
+        for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+            data.d[d][n] = knot_x[d] - p[d];
+    }
+}
+//! Physical distance spline data template helper for a non-uniform mesh.
+template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+          class EntityType, class DataTags>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<!SplineData<
+    Scalar, Order, NumSpaceDim, EntityType, DataTags>::has_physical_distance>
+setSplineData( SplinePhysicalDistance,
+               SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>&,
+               const LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>&,
+               const Scalar[NumSpaceDim] )
+{
+}
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Evaluate spline data at a point in a non-uniform mesh.
+
+  The point is located in each dimension by a binary search over the local
+  node coordinates. The logical position is mapped linearly within the
+  interval between the two entities bracketing the point and the spline is
+  evaluated in that logical space. Physical gradients and the cell size use
+  the width of the bracketing interval. Linear interpolation is exact in
+  physical space. Higher orders are exact on uniform regions of the mesh.
+*/
+template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+          class EntityType, class DataTags>
+KOKKOS_INLINE_FUNCTION void evaluateSpline(
+    const LocalMesh<Device, NonUniformMesh<Scalar, NumSpaceDim>>& local_mesh,
+    const Scalar p[NumSpaceDim],
+    SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>& data )
+{
+    // data type
+    using sd_type =
+        SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>;
+
+    // Locate the cell containing the point.
+    int cell_id[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        cell_id[d] = local_mesh.locateCell( d, p[d] );
+
+    // Find the entities bracketing the point. Entities at cell centers in a
+    // given dimension may lie above the point.
+    Scalar cell_x[NumSpaceDim];
+    local_mesh.coordinates( EntityType(), cell_id, cell_x );
+    int low_id[NumSpaceDim];
+    int low_id_p1[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        low_id[d] = ( p[d] < cell_x[d] ) ? cell_id[d] - 1 : cell_id[d];
+        low_id_p1[d] = low_id[d] + 1;
+    }
+    Scalar low_x[NumSpaceDim];
+    Scalar low_x_p1[NumSpaceDim];
+    local_mesh.coordinates( EntityType(), low_id, low_x );
+    local_mesh.coordinates( EntityType(), low_id_p1, low_x_p1 );
+
+    // Compute the physical size of the bracketing interval.
+    Scalar dx[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        dx[d] = low_x_p1[d] - low_x[d];
+        setSplineData( SplinePhysicalCellSize(), data, d, dx[d] );
+    }
+
+    // Compute the inverse physical cell size.
+    Scalar rdx[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+        rdx[d] = 1.0 / dx[d];
+
+    // Compute the reference coordinates.
+    Scalar x[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        x[d] = low_id[d] + sd_type::spline_type::mapToLogicalGrid(
+                               p[d], rdx[d], low_x[d] );
+        setSplineData( SplineLogicalPosition(), data, d, x[d] );
+    }
+
+    // Compute the stencil.
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        sd_type::spline_type::stencil( x[d], data.s[d] );
+    }
+
+    // Compute the weight values.
+    setSplineData( SplineWeightValues(), data, x );
+
+    // Compute the weight gradients.
+    setSplineData( SplineWeightPhysicalGradients(), data, x, rdx );
+
+    // Compute the physical distance.
+    setSplineData( SplinePhysicalDistance(), data, local_mesh, p );
+}
+
+//---------------------------------------------------------------------------//
+// Spline Data Cache
+//---------------------------------------------------------------------------//
+//! \cond Impl
+namespace Impl
+{
+// Flat access to the spline data members. Absent members give a null pointer.
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<SplineDataType::has_physical_cell_size,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplinePhysicalCellSize, SplineDataType& sd )
+{
+    return &sd.dx[0];
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<!SplineDataType::has_physical_cell_size,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplinePhysicalCellSize, SplineDataType& )
+{
+    return nullptr;
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<SplineDataType::has_logical_position,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplineLogicalPosition, SplineDataType& sd )
+{
+    return &sd.x[0];
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<!SplineDataType::has_logical_position,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplineLogicalPosition, SplineDataType& )
+{
+    return nullptr;
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<SplineDataType::has_physical_distance,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplinePhysicalDistance, SplineDataType& sd )
+{
+    return &sd.d[0][0];
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<!SplineDataType::has_physical_distance,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplinePhysicalDistance, SplineDataType& )
+{
+    return nullptr;
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<SplineDataType::has_weight_values,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplineWeightValues, SplineDataType& sd )
+{
+    return &sd.w[0][0];
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<!SplineDataType::has_weight_values,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplineWeightValues, SplineDataType& )
+{
+    return nullptr;
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<SplineDataType::has_weight_physical_gradients,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplineWeightPhysicalGradients, SplineDataType& sd )
+{
+    return &sd.g[0][0];
+}
+
+template <class SplineDataType>
+KOKKOS_INLINE_FUNCTION
+    std::enable_if_t<!SplineDataType::has_weight_physical_gradients,
+                     typename SplineDataType::scalar_type*>
+    splineMemberData( SplineWeightPhysicalGradients, SplineDataType& )
+{
+    return nullptr;
+}
+
+} // end namespace Impl
+//! \endcond
+
+/*!
+  \brief Per-point cache of spline data.
+
+  Stores the spline data of a set of points so that it can be evaluated once
+  and consumed by several interpolations while the points do not move. Each
+  data member present in the spline data type is stored in its own
+  (point,component) view. The interpolation stencil is contiguous and is
+  stored as its first index only, and the uniform cell size is stored once.
+
+  \tparam SplineDataType The spline data type to cache.
+  \tparam DeviceType The device type in which the cache is stored.
+*/
+template <class SplineDataType, class DeviceType>
+class SplineDataCache
+{
+  public:
+    //! Spline data type.
+    using spline_data_type = SplineDataType;
+    //! Scalar type.
+    using scalar_type = typename spline_data_type::scalar_type;
+    //! Entity type.
+    using entity_type = typename spline_data_type::entity_type;
+    //! Spline order.
+    static constexpr int order = spline_data_type::order;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim =
+        spline_data_type::num_space_dim;
+    //! The number of non-zero knots in the spline.
+    static constexpr int num_knot = spline_data_type::num_knot;
+
+    //! Kokkos device type.
+    using device_type = DeviceType;
+    //! Kokkos memory space.
+    using memory_space = typename device_type::memory_space;
+    //! Kokkos execution space.
+    using execution_space = typename device_type::execution_space;
+
+    //! Per-point data view type.
+    using data_view_type = Kokkos::View<scalar_type**, device_type>;
+    //! Per-point stencil view type.
+    using stencil_view_type = Kokkos::View<int**, device_type>;
+
+    /*!
+      \brief Constructor. Evaluates the spline data of the given points.
+      \param local_mesh The local mesh in which the points are located.
+      \param points The point coordinates. Will be indexed as (point,dim).
+      \param num_point The number of points.
+    */
+    template <class LocalMeshType, class PointCoordinates>
+    SplineDataCache( const LocalMeshType& local_mesh,
+                     const PointCoordinates& points,
+                     const std::size_t num_point )
+        : _num_point( 0 )
+    {
+        update( local_mesh, points, num_point );
+    }
+
+    //! Get the number of cached points.
+    std::size_t size() const { return _num_point; }
+
+    /*!
+      \brief Re-evaluate the spline data of the given points.
+      \param local_mesh The local mesh in which the points are located.
+      \param points The point coordinates. Will be indexed as (point,dim).
+      \param num_point The number of points.
+    */
+    template <class LocalMeshType, class PointCoordinates>
+    void update( const LocalMeshType& local_mesh,
+                 const PointCoordinates& points, const std::size_t num_point )
+    {
+        // Allocate storage for the members present in the spline data.
+        if ( num_point != _num_point )
+        {
+            spline_data_type sd;
+            _num_point = num_point;
+            _stencil = stencil_view_type(
+                Kokkos::ViewAllocateWithoutInitializing( "spline_stencil" ),
+                num_point, num_space_dim );
+            _x = allocateMember( "spline_logical_position",
+                                 Impl::splineMemberData(
+                                     SplineLogicalPosition(), sd ),
+                                 num_space_dim );
+            _d = allocateMember( "spline_physical_distance",
+                                 Impl::splineMemberData(
+                                     SplinePhysicalDistance(), sd ),
+                                 num_space_dim * num_knot );
+            _w = allocateMember( "spline_weight_values",
+                                 Impl::splineMemberData(
+                                     SplineWeightValues(), sd ),
+                                 num_space_dim * num_knot );
+            _g = allocateMember( "spline_weight_gradients",
+                                 Impl::splineMemberData(
+                                     SplineWeightPhysicalGradients(), sd ),
+                                 num_space_dim * num_knot );
+        }
+
+        // The cell size is uniform. Get it from the first entity.
+        int low_id[num_space_dim];
+        int low_id_p1[num_space_dim];
+        scalar_type low_x[num_space_dim];
+        scalar_type low_x_p1[num_space_dim];
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+        {
+            low_id[d] = 0;
+            low_id_p1[d] = 1;
+        }
+        local_mesh.coordinates( entity_type(), low_id, low_x );
+        local_mesh.coordinates( entity_type(), low_id_p1, low_x_p1 );
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            _dx[d] = low_x_p1[d] - low_x[d];
+
+        // Evaluate and store the spline data.
+        auto stencil = _stencil;
+        auto x = _x;
+        auto dist = _d;
+        auto w = _w;
+        auto g = _g;
+        Kokkos::parallel_for(
+            "Cajita::SplineDataCache::update",
+            Kokkos::RangePolicy<execution_space>( 0, num_point ),
+            KOKKOS_LAMBDA( const int p ) {
+                scalar_type px[num_space_dim];
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    px[d] = points( p, d );
+
+                spline_data_type sd;
+                evaluateSpline( local_mesh, px, sd );
+
+                for ( std::size_t d = 0; d < num_space_dim; ++d )
+                    stencil( p, d ) = sd.s[d][0];
+                storeMember( Impl::splineMemberData( SplineLogicalPosition(),
+                                                     sd ),
+                             x, p );
+                storeMember( Impl::splineMemberData( SplinePhysicalDistance(),
+                                                     sd ),
+                             dist, p );
+                storeMember(
+                    Impl::splineMemberData( SplineWeightValues(), sd ), w,
+                    p );
+                storeMember( Impl::splineMemberData(
+                                 SplineWeightPhysicalGradients(), sd ),
+                             g, p );
+            } );
+    }
+
+    /*!
+      \brief Load the cached spline data of a point.
+      \param p The point index.
+      \param sd The spline data to fill.
+    */
+    KOKKOS_INLINE_FUNCTION
+    void load( const int p, spline_data_type& sd ) const
+    {
+        for ( std::size_t d = 0; d < num_space_dim; ++d )
+            for ( int n = 0; n < num_knot; ++n )
+                sd.s[d][n] = _stencil( p, d ) + n;
+
+        auto dx = Impl::splineMemberData( SplinePhysicalCellSize(), sd );
+        if ( dx )
+            for ( std::size_t d = 0; d < num_space_dim; ++d )
+                dx[d] = _dx[d];
+
+        loadMember( Impl::splineMemberData( SplineLogicalPosition(), sd ), _x,
+                    p );
+        loadMember( Impl::splineMemberData( SplinePhysicalDistance(), sd ),
+                    _d, p );
+        loadMember( Impl::splineMemberData( SplineWeightValues(), sd ), _w,
+                    p );
+        loadMember(
+            Impl::splineMemberData( SplineWeightPhysicalGradients(), sd ), _g,
+            p );
+    }
+
+  private:
+    //! Allocate a member view. Absent members get no storage.
+    data_view_type allocateMember( const std::string& label,
+                                   const scalar_type* member,
+                                   const std::size_t num_comp ) const
+    {
+        return data_view_type( Kokkos::ViewAllocateWithoutInitializing( label ),
+                               member ? _num_point : 0,
+                               member ? num_comp : 0 );
+    }
+
+    //! Store a member of a point's spline data.
+    KOKKOS_INLINE_FUNCTION
+    static void storeMember( const scalar_type* member,
+                             const data_view_type& view, const int p )
+    {
+        if ( member )
+            for ( std::size_t c = 0; c < view.extent( 1 ); ++c )
+                view( p, c ) = member[c];
+    }
+
+    //! Load a member of a point's spline data.
+    KOKKOS_INLINE_FUNCTION
+    static void loadMember( scalar_type* member, const data_view_type& view,
+                            const int p )
+    {
+        if ( member )
+            for ( std::size_t c = 0; c < view.extent( 1 ); ++c )
+                member[c] = view( p, c );
+    }
+
+    std::size_t _num_point;
+    Kokkos::Array<scalar_type, num_space_dim> _dx;
+    stencil_view_type _stencil;
+    data_view_type _x;
+    data_view_type _d;
+    data_view_type _w;
+    data_view_type _g;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Create a cache of the full spline data of a set of points.
+  \param local_mesh The local mesh in which the points are located.
+  \param points The point coordinates. Will be indexed as (point,dim).
+  \param num_point The number of points.
+  \note Spline of SplineOrder and EntityType passed for the spline data.
+*/
+template <class Device, class Scalar, std::size_t NumSpaceDim,
+          class PointCoordinates, int SplineOrder, class EntityType>
+SplineDataCache<SplineData<Scalar, SplineOrder, NumSpaceDim, EntityType>,
+                Device>
+createSplineDataCache(
+    const LocalMesh<Device, UniformMesh<Scalar, NumSpaceDim>>& local_mesh,
+    const PointCoordinates& points, const std::size_t num_point,
+    Spline<SplineOrder>, EntityType )
+{
+    return SplineDataCache<
+        SplineData<Scalar, SplineOrder, NumSpaceDim, EntityType>, Device>(
+        local_mesh, points, num_point );
+}
+
+//---------------------------------------------------------------------------//
+// Batched Spline Data
+//---------------------------------------------------------------------------//
+/*!
+  \brief Spline data of a batch of points with the point index innermost.
+
+  Holds the spline data of up to VectorLength points, typically the lanes of
+  one SoA of an AoSoA. Members are laid out as [dim][knot][lane] so that the
+  batched evaluation runs over contiguous lanes and can be vectorized. The
+  interpolation stencil is contiguous and is stored as its first index only.
+  Use load() to extract the spline data of a single lane.
+
+  \tparam SplineDataType The spline data type of a single point.
+  \tparam VectorLength The number of points in the batch.
+*/
+template <class SplineDataType, int VectorLength>
+struct SplineDataBatch
+{
+    //! Spline data type.
+    using spline_data_type = SplineDataType;
+    //! Scalar type.
+    using scalar_type = typename spline_data_type::scalar_type;
+    //! Spline type.
+    using spline_type = typename spline_data_type::spline_type;
+    //! Entity type.
+    using entity_type = typename spline_data_type::entity_type;
+    //! Number of points in the batch.
+    static constexpr int vector_length = VectorLength;
+    //! Spatial dimension.
+    static constexpr std::size_t num_space_dim =
+        spline_data_type::num_space_dim;
+    //! The number of non-zero knots in the spline.
+    static constexpr int num_knot = spline_data_type::num_knot;
+
+    //! Physical cell size.
+    scalar_type dx[num_space_dim];
+    //! Logical position.
+    scalar_type x[num_space_dim][VectorLength];
+    //! Physical distance.
+    scalar_type d[num_space_dim][num_knot][VectorLength];
+    //! Weight values.
+    scalar_type w[num_space_dim][num_knot][VectorLength];
+    //! Weight physical gradients.
+    scalar_type g[num_space_dim][num_knot][VectorLength];
+    //! First logical index of the stencil.
+    int s[num_space_dim][VectorLength];
+
+    /*!
+      \brief Load the spline data of a single point in the batch.
+      \param a The lane index of the point.
+      \param sd The spline data to fill. Only the members present in the
+      spline data type are assigned.
+    */
+    KOKKOS_INLINE_FUNCTION
+    void load( const int a, spline_data_type& sd ) const
+    {
+        for ( std::size_t i = 0; i < num_space_dim; ++i )
+            for ( int n = 0; n < num_knot; ++n )
+                sd.s[i][n] = s[i][a] + n;
+
+        auto sd_dx = Impl::splineMemberData( SplinePhysicalCellSize(), sd );
+        if ( sd_dx )
+            for ( std::size_t i = 0; i < num_space_dim; ++i )
+                sd_dx[i] = dx[i];
+
+        auto sd_x = Impl::splineMemberData( SplineLogicalPosition(), sd );
+        if ( sd_x )
+            for ( std::size_t i = 0; i < num_space_dim; ++i )
+                sd_x[i] = x[i][a];
+
+        loadKnotMember(
+            Impl::splineMemberData( SplinePhysicalDistance(), sd ), d, a );
+        loadKnotMember( Impl::splineMemberData( SplineWeightValues(), sd ), w,
+                        a );
+        loadKnotMember(
+            Impl::splineMemberData( SplineWeightPhysicalGradients(), sd ), g,
+            a );
+    }
+
+  private:
+    //! Load a per-knot member of a single point.
+    KOKKOS_INLINE_FUNCTION
+    static void
+    loadKnotMember( scalar_type* member,
+                    const scalar_type data[num_space_dim][num_knot]
+                                          [VectorLength],
+                    const int a )
+    {
+        if ( member )
+            for ( std::size_t i = 0; i < num_space_dim; ++i )
+                for ( int n = 0; n < num_knot; ++n )
+                    member[i * num_knot + n] = data[i][n][a];
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+  \brief Evaluate the spline data of a batch of points in a uniform mesh.
+
+  All lanes share the mesh geometry so it is computed once per batch. Each
+  stage then loops over the lanes innermost, writing lane-contiguous data, so
+  that the weight computations vectorize across points.
+
+  \param local_mesh The local mesh in which the points are located.
+  \param px The point coordinates indexed as [dim][lane].
+  \param num_lane The number of valid lanes in the batch.
+  \param batch The batch spline data to fill.
+*/
+template <typename Scalar, int Order, std::size_t NumSpaceDim, class Device,
+          class EntityType, class DataTags, int VectorLength>
+KOKKOS_INLINE_FUNCTION void evaluateSpline(
+    const LocalMesh<Device, UniformMesh<Scalar, NumSpaceDim>>& local_mesh,
+    const Scalar px[NumSpaceDim][VectorLength], const int num_lane,
+    SplineDataBatch<
+        SplineData<Scalar, Order, NumSpaceDim, EntityType, DataTags>,
+        VectorLength>& batch )
+{
+    using spline_type = Spline<Order>;
+    constexpr int num_knot = spline_type::num_knot;
+
+    // Get the low corner and cell size of the mesh.
+    Scalar low_x[NumSpaceDim];
+    Scalar low_x_p1[NumSpaceDim];
+    int low_id[NumSpaceDim];
+    int low_id_p1[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        low_id[d] = 0;
+        low_id_p1[d] = 1;
+    }
+    local_mesh.coordinates( EntityType(), low_id, low_x );
+    local_mesh.coordinates( EntityType(), low_id_p1, low_x_p1 );
+
+    Scalar rdx[NumSpaceDim];
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        batch.dx[d] = low_x_p1[d] - low_x[d];
+        rdx[d] = 1.0 / batch.dx[d];
+    }
+
+    for ( std::size_t d = 0; d < NumSpaceDim; ++d )
+    {
+        // Compute the reference coordinates and stencils.
+        for ( int a = 0; a < num_lane; ++a )
+        {
+            batch.x[d][a] =
+                spline_type::mapToLogicalGrid( px[d][a], rdx[d], low_x[d] );
+            int stencil[num_knot];
+            spline_type::stencil( batch.x[d][a], stencil );
+            batch.s[d][a] = stencil[0];
+        }
+
+        // Compute the weight values and gradients.
+        for ( int a = 0; a < num_lane; ++a )
+        {
+            Scalar values[num_knot];
+            Scalar gradients[num_knot];
+            spline_type::value( batch.x[d][a], values );
+            spline_type::gradient( batch.x[d][a], rdx[d], gradients );
+            splineKnotLoop<num_knot>( [&]( const int n ) {
+                batch.w[d][n][a] = values[n];
+                batch.g[d][n][a] = gradients[n];
+            } );
+        }
+
+        // Compute the physical distance.
+        splineKnotLoop<num_knot>( [&]( const int n ) {
+            for ( int a = 0; a < num_lane; ++a )
+                batch.d[d][n][a] =
+                    low_x[d] - px[d][a] + ( batch.s[d][a] + n ) * batch.dx[d];
+        } );
+    }
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cajita
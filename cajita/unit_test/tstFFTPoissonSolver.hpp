@@ -0,0 +1,120 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Array.hpp>
+#include <Cajita_FFTPoissonSolver.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+using namespace Cajita;
+
+namespace Test
+{
+
+//---------------------------------------------------------------------------//
+// Solve for a single Fourier mode for which the exact solution is known for
+// both the continuous and the finite difference Laplacian.
+void poissonTest( const bool finite_difference )
+{
+    // Create the global mesh.
+    double cell_size = 0.125;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_grid = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+
+    // The solution is x = cos(2 pi gi / ni) * cos(2 pi gk / nk) and b is
+    // its negative Laplacian.
+    const double pi = 4.0 * std::atan( 1.0 );
+    int ni = global_grid->globalNumEntity( Cell(), Dim::I );
+    int nk = global_grid->globalNumEntity( Cell(), Dim::K );
+    double lambda = 0.0;
+    for ( int n : { ni, nk } )
+    {
+        double k = finite_difference
+                       ? 2.0 * std::sin( pi / n ) / cell_size
+                       : 2.0 * pi / ( n * cell_size );
+        lambda += k * k;
+    }
+
+    auto layout = createArrayLayout( local_grid, 1, Cell() );
+    auto b = createArray<double, TEST_DEVICE>( "b", layout );
+    auto x = createArray<double, TEST_DEVICE>( "x", layout );
+    auto b_host = Kokkos::create_mirror_view( Kokkos::HostSpace(), b->view() );
+    auto x_exact = Kokkos::create_mirror_view( Kokkos::HostSpace(), b->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+            {
+                int gi = i - owned_space.min( Dim::I ) +
+                         global_space.min( Dim::I );
+                int gk = k - owned_space.min( Dim::K ) +
+                         global_space.min( Dim::K );
+                x_exact( i, j, k, 0 ) = std::cos( 2.0 * pi * gi / ni ) *
+                                        std::cos( 2.0 * pi * gk / nk );
+                b_host( i, j, k, 0 ) = lambda * x_exact( i, j, k, 0 );
+            }
+    Kokkos::deep_copy( b->view(), b_host );
+
+    // Solve.
+    auto solver =
+        Experimental::createFFTPoissonSolver<double, TEST_DEVICE>( *layout );
+    solver->setFiniteDifferenceLaplacian( finite_difference );
+    solver->solve( *b, *x );
+
+    // Check the results.
+    auto x_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), x->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_NEAR( x_host( i, j, k, 0 ), x_exact( i, j, k, 0 ),
+                             1.0e-10 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( fft_poisson_solver, spectral_test ) { poissonTest( false ); }
+
+TEST( fft_poisson_solver, finite_difference_test ) { poissonTest( true ); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -226,6 +227,422 @@ void forwardReverseTest2d( bool use_default, bool use_params )
         }
 }
 
+//---------------------------------------------------------------------------//
+void batchTest3d()
+{
+    // Create the global mesh.
+    double cell_size = 0.1;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid with a halo so the transforms are staged through
+    // the work buffers.
+    auto local_grid = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+
+    // Create a batch of two different fields and a copy of the second.
+    auto vector_layout = createArrayLayout( local_grid, 2, Cell() );
+    auto a = createArray<double, TEST_DEVICE>( "a", vector_layout );
+    auto b = createArray<double, TEST_DEVICE>( "b", vector_layout );
+    auto c = createArray<double, TEST_DEVICE>( "c", vector_layout );
+    ArrayOp::assign( *a, 1.0, Own() );
+    auto b_view = b->view();
+    Kokkos::parallel_for(
+        "fill_b", createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            b_view( i, j, k, 0 ) = i + 2 * j + 3 * k;
+            b_view( i, j, k, 1 ) = i - j;
+        } );
+    ArrayOp::copy( *c, *b, Own() );
+
+    auto fft =
+        Experimental::createHeffteFastFourierTransform<double, TEST_DEVICE>(
+            *vector_layout );
+
+    // The batched transform of the second field matches the single
+    // transform of its copy.
+    using array_type = decltype( a )::element_type;
+    std::vector<std::shared_ptr<array_type>> batch = { a, b };
+    fft->forward( batch, Experimental::FFTScaleFull() );
+    fft->forward( *c, Experimental::FFTScaleFull() );
+    auto b_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), b->view() );
+    auto c_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), c->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                for ( int n = 0; n < 2; ++n )
+                    EXPECT_NEAR( b_host( i, j, k, n ), c_host( i, j, k, n ),
+                                 1.0e-10 );
+
+    // The batched reverse transform recovers the fields.
+    fft->reverse( batch, Experimental::FFTScaleNone() );
+    auto a_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), a->view() );
+    b_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), b->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+            {
+                EXPECT_NEAR( a_host( i, j, k, 0 ), 1.0, 1.0e-10 );
+                EXPECT_NEAR( a_host( i, j, k, 1 ), 1.0, 1.0e-10 );
+                EXPECT_NEAR( b_host( i, j, k, 0 ), i + 2 * j + 3 * k,
+                             1.0e-10 );
+                EXPECT_NEAR( b_host( i, j, k, 1 ), i - j, 1.0e-10 );
+            }
+}
+
+//---------------------------------------------------------------------------//
+void inPlaceTest3d()
+{
+    // Create the global mesh.
+    double cell_size = 0.1;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid without a halo, whose owned data is transformed in
+    // place, and one with a halo, whose owned data is staged through the work
+    // buffer.
+    auto local_grid = createLocalGrid( global_grid, 0 );
+    auto halo_grid = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto halo_owned_space = halo_grid->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+
+    // Create the same field on both grids.
+    auto layout = createArrayLayout( local_grid, 2, Cell() );
+    auto halo_layout = createArrayLayout( halo_grid, 2, Cell() );
+    auto x =
+        createArray<double, Kokkos::LayoutRight, TEST_DEVICE>( "x", layout );
+    auto y = createArray<double, Kokkos::LayoutRight, TEST_DEVICE>(
+        "y", halo_layout );
+    EXPECT_TRUE( isContiguousLayoutRight(
+        createSubview( x->view(), layout->indexSpace( Own(), Local() ) ) ) );
+    EXPECT_FALSE( isContiguousLayoutRight( createSubview(
+        y->view(), halo_layout->indexSpace( Own(), Local() ) ) ) );
+    auto x_view = x->view();
+    auto y_view = y->view();
+    Kokkos::parallel_for(
+        "fill", createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int gi = i + global_space.min( Dim::I );
+            int gj = j + global_space.min( Dim::J );
+            int gk = k + global_space.min( Dim::K );
+            int hi = i + halo_owned_space.min( Dim::I );
+            int hj = j + halo_owned_space.min( Dim::J );
+            int hk = k + halo_owned_space.min( Dim::K );
+            x_view( i, j, k, 0 ) = 1.0 + 0.1 * ( ( 5 * gi + 3 * gj + gk ) % 7 );
+            x_view( i, j, k, 1 ) = 0.2 * ( ( gi + 2 * gj + 3 * gk ) % 5 );
+            y_view( hi, hj, hk, 0 ) = x_view( i, j, k, 0 );
+            y_view( hi, hj, hk, 1 ) = x_view( i, j, k, 1 );
+        } );
+    auto x_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), x->view() );
+
+    // The in place transform matches the staged transform.
+    auto fft =
+        Experimental::createHeffteFastFourierTransform<double, TEST_DEVICE>(
+            *layout );
+    auto halo_fft =
+        Experimental::createHeffteFastFourierTransform<double, TEST_DEVICE>(
+            *halo_layout );
+    fft->forward( *x, Experimental::FFTScaleFull() );
+    halo_fft->forward( *y, Experimental::FFTScaleFull() );
+    auto x_spectrum =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), x->view() );
+    auto y_spectrum =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), y->view() );
+    for ( int i = 0; i < owned_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < owned_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < owned_space.extent( Dim::K ); ++k )
+                for ( int n = 0; n < 2; ++n )
+                    EXPECT_NEAR( x_spectrum( i, j, k, n ),
+                                 y_spectrum( halo_owned_space.min( Dim::I ) + i,
+                                             halo_owned_space.min( Dim::J ) + j,
+                                             halo_owned_space.min( Dim::K ) + k,
+                                             n ),
+                                 1.0e-10 );
+
+    // The in place reverse transform recovers the field.
+    fft->reverse( *x, Experimental::FFTScaleNone() );
+    auto x_result =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), x->view() );
+    for ( int i = 0; i < owned_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < owned_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < owned_space.extent( Dim::K ); ++k )
+                for ( int n = 0; n < 2; ++n )
+                    EXPECT_NEAR( x_result( i, j, k, n ), x_host( i, j, k, n ),
+                                 1.0e-10 );
+}
+
+//---------------------------------------------------------------------------//
+void realForwardReverseTest3d( const int halo_width )
+{
+    // Create the global mesh.
+    double cell_size = 0.1;
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    int ni = global_grid->globalNumEntity( Cell(), Dim::I );
+    int nj = global_grid->globalNumEntity( Cell(), Dim::J );
+    int nk = global_grid->globalNumEntity( Cell(), Dim::K );
+
+    // Create a local grid.
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+
+    // Create a real field and a complex copy of it with zero imaginary part.
+    auto scalar_layout = createArrayLayout( local_grid, 1, Cell() );
+    auto x = createArray<double, TEST_DEVICE>( "x", scalar_layout );
+    auto x_view = x->view();
+    auto complex_layout = createArrayLayout( local_grid, 2, Cell() );
+    auto z = createArray<double, TEST_DEVICE>( "z", complex_layout );
+    auto z_view = z->view();
+    Kokkos::parallel_for(
+        "fill_x", createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int gi = i - owned_space.min( Dim::I ) + global_space.min( Dim::I );
+            int gj = j - owned_space.min( Dim::J ) + global_space.min( Dim::J );
+            int gk = k - owned_space.min( Dim::K ) + global_space.min( Dim::K );
+            x_view( i, j, k, 0 ) =
+                2.0 + 0.1 * ( ( 7 * gi + 3 * gj + gk ) % 11 );
+            z_view( i, j, k, 0 ) = x_view( i, j, k, 0 );
+            z_view( i, j, k, 1 ) = 0.0;
+        } );
+    auto x_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), x->view() );
+
+    // The exact mean of the field.
+    double mean = 0.0;
+    for ( int gi = 0; gi < ni; ++gi )
+        for ( int gj = 0; gj < nj; ++gj )
+            for ( int gk = 0; gk < nk; ++gk )
+                mean += 2.0 + 0.1 * ( ( 7 * gi + 3 * gj + gk ) % 11 );
+    mean /= double( ni ) * nj * nk;
+
+    // Compute the full complex spectrum and gather it on every rank.
+    auto complex_fft =
+        Experimental::createHeffteFastFourierTransform<double, TEST_DEVICE>(
+            *complex_layout );
+    complex_fft->forward( *z, Experimental::FFTScaleFull() );
+    auto z_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), z->view() );
+    Kokkos::View<double****, Kokkos::LayoutRight, Kokkos::HostSpace>
+        full_spectrum( "full_spectrum", ni, nj, nk, 2 );
+    for ( int i = 0; i < owned_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < owned_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < owned_space.extent( Dim::K ); ++k )
+                for ( int c = 0; c < 2; ++c )
+                    full_spectrum( global_space.min( Dim::I ) + i,
+                                   global_space.min( Dim::J ) + j,
+                                   global_space.min( Dim::K ) + k, c ) =
+                        z_host( owned_space.min( Dim::I ) + i,
+                                owned_space.min( Dim::J ) + j,
+                                owned_space.min( Dim::K ) + k, c );
+    MPI_Allreduce( MPI_IN_PLACE, full_spectrum.data(), full_spectrum.size(),
+                   MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+
+    // The half-spectrum tiles n/2+1 entries of the last dimension.
+    auto fft =
+        Experimental::createHeffteRealFastFourierTransform<double,
+                                                           TEST_DEVICE>(
+            *scalar_layout );
+    auto spectral_space = fft->spectralIndexSpace( Global() );
+    long num_spectral = spectral_space.size();
+    MPI_Allreduce( MPI_IN_PLACE, &num_spectral, 1, MPI_LONG, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_EQ( num_spectral, long( ni ) * nj * ( nk / 2 + 1 ) );
+
+    // Forward transform.
+    auto spectrum = fft->createSpectralView( "spectrum" );
+    fft->forward( *x, spectrum, Experimental::FFTScaleFull() );
+
+    // The half-spectrum matches the complex spectrum of the same field.
+    auto spectrum_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), spectrum );
+    for ( int i = 0; i < spectral_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < spectral_space.extent( Dim::J ); ++j )
+            for ( int k = 0; k < spectral_space.extent( Dim::K ); ++k )
+            {
+                int gi = spectral_space.min( Dim::I ) + i;
+                int gj = spectral_space.min( Dim::J ) + j;
+                int gk = spectral_space.min( Dim::K ) + k;
+                for ( int c = 0; c < 2; ++c )
+                    EXPECT_NEAR( spectrum_host( i, j, k, c ),
+                                 full_spectrum( gi, gj, gk, c ), 1.0e-10 );
+            }
+
+    // The zero mode is the mean of the field.
+    if ( spectral_space.min( Dim::I ) == 0 &&
+         spectral_space.min( Dim::J ) == 0 &&
+         spectral_space.min( Dim::K ) == 0 && spectral_space.size() > 0 )
+    {
+        EXPECT_NEAR( spectrum_host( 0, 0, 0, 0 ), mean, 1.0e-12 );
+        EXPECT_NEAR( spectrum_host( 0, 0, 0, 1 ), 0.0, 1.0e-12 );
+    }
+
+    // Reverse transform recovers the field.
+    ArrayOp::assign( *x, 0.0, Own() );
+    fft->reverse( spectrum, *x, Experimental::FFTScaleNone() );
+    auto x_result =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), x->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_NEAR( x_host( i, j, k, 0 ), x_result( i, j, k, 0 ),
+                             1.0e-10 );
+}
+
+//---------------------------------------------------------------------------//
+void realForwardReverseTest2d( const int halo_width )
+{
+    // Create the global mesh.
+    double cell_size = 0.1;
+    std::array<bool, 2> is_dim_periodic = { true, true };
+    std::array<double, 2> global_low_corner = { -1.0, -2.0 };
+    std::array<double, 2> global_high_corner = { 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<2> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    int ni = global_grid->globalNumEntity( Cell(), Dim::I );
+    int nj = global_grid->globalNumEntity( Cell(), Dim::J );
+
+    // Create a local grid.
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+
+    // Create a real field and a complex copy of it with zero imaginary part.
+    auto scalar_layout = createArrayLayout( local_grid, 1, Cell() );
+    auto x = createArray<double, TEST_DEVICE>( "x", scalar_layout );
+    auto x_view = x->view();
+    auto complex_layout = createArrayLayout( local_grid, 2, Cell() );
+    auto z = createArray<double, TEST_DEVICE>( "z", complex_layout );
+    auto z_view = z->view();
+    Kokkos::parallel_for(
+        "fill_x", createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j ) {
+            int gi = i - owned_space.min( Dim::I ) + global_space.min( Dim::I );
+            int gj = j - owned_space.min( Dim::J ) + global_space.min( Dim::J );
+            x_view( i, j, 0 ) = 2.0 + 0.1 * ( ( 7 * gi + 3 * gj ) % 11 );
+            z_view( i, j, 0 ) = x_view( i, j, 0 );
+            z_view( i, j, 1 ) = 0.0;
+        } );
+    auto x_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), x->view() );
+
+    // The exact mean of the field.
+    double mean = 0.0;
+    for ( int gi = 0; gi < ni; ++gi )
+        for ( int gj = 0; gj < nj; ++gj )
+            mean += 2.0 + 0.1 * ( ( 7 * gi + 3 * gj ) % 11 );
+    mean /= double( ni ) * nj;
+
+    // Compute the full complex spectrum and gather it on every rank.
+    auto complex_fft =
+        Experimental::createHeffteFastFourierTransform<double, TEST_DEVICE>(
+            *complex_layout );
+    complex_fft->forward( *z, Experimental::FFTScaleFull() );
+    auto z_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), z->view() );
+    Kokkos::View<double***, Kokkos::LayoutRight, Kokkos::HostSpace>
+        full_spectrum( "full_spectrum", ni, nj, 2 );
+    for ( int i = 0; i < owned_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < owned_space.extent( Dim::J ); ++j )
+            for ( int c = 0; c < 2; ++c )
+                full_spectrum( global_space.min( Dim::I ) + i,
+                               global_space.min( Dim::J ) + j, c ) =
+                    z_host( owned_space.min( Dim::I ) + i,
+                            owned_space.min( Dim::J ) + j, c );
+    MPI_Allreduce( MPI_IN_PLACE, full_spectrum.data(), full_spectrum.size(),
+                   MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+
+    // The half-spectrum tiles n/2+1 entries of the last dimension.
+    auto fft =
+        Experimental::createHeffteRealFastFourierTransform<double,
+                                                           TEST_DEVICE>(
+            *scalar_layout );
+    auto spectral_space = fft->spectralIndexSpace( Global() );
+    long num_spectral = spectral_space.size();
+    MPI_Allreduce( MPI_IN_PLACE, &num_spectral, 1, MPI_LONG, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_EQ( num_spectral, long( ni ) * ( nj / 2 + 1 ) );
+
+    // Forward transform.
+    auto spectrum = fft->createSpectralView( "spectrum" );
+    fft->forward( *x, spectrum, Experimental::FFTScaleFull() );
+
+    // The half-spectrum matches the complex spectrum of the same field.
+    auto spectrum_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), spectrum );
+    for ( int i = 0; i < spectral_space.extent( Dim::I ); ++i )
+        for ( int j = 0; j < spectral_space.extent( Dim::J ); ++j )
+            for ( int c = 0; c < 2; ++c )
+                EXPECT_NEAR( spectrum_host( i, j, c ),
+                             full_spectrum( spectral_space.min( Dim::I ) + i,
+                                            spectral_space.min( Dim::J ) + j,
+                                            c ),
+                             1.0e-10 );
+
+    // The zero mode is the mean of the field.
+    if ( spectral_space.min( Dim::I ) == 0 &&
+         spectral_space.min( Dim::J ) == 0 && spectral_space.size() > 0 )
+    {
+        EXPECT_NEAR( spectrum_host( 0, 0, 0 ), mean, 1.0e-12 );
+        EXPECT_NEAR( spectrum_host( 0, 0, 1 ), 0.0, 1.0e-12 );
+    }
+
+    // Reverse transform recovers the field.
+    ArrayOp::assign( *x, 0.0, Own() );
+    fft->reverse( spectrum, *x, Experimental::FFTScaleNone() );
+    auto x_result =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), x->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            EXPECT_NEAR( x_host( i, j, 0 ), x_result( i, j, 0 ), 1.0e-10 );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -260,6 +677,23 @@ TEST( fast_fourier_transform, forward_reverse_2d_test )
     forwardReverseTest2d<Experimental::FFTBackendMKL>( false, false );
 #endif
 }
+
+TEST( fast_fourier_transform, batch_3d_test ) { batchTest3d(); }
+
+TEST( fast_fourier_transform, in_place_3d_test ) { inPlaceTest3d(); }
+
+TEST( fast_fourier_transform, real_forward_reverse_3d_test )
+{
+    realForwardReverseTest3d( 0 );
+    realForwardReverseTest3d( 1 );
+}
+
+TEST( fast_fourier_transform, real_forward_reverse_2d_test )
+{
+    realForwardReverseTest2d( 0 );
+    realForwardReverseTest2d( 1 );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -223,6 +223,19 @@ void gatherScatterTest( const ManualBlockPartitioner<3>& partitioner,
 
         // Check the scatter.
         checkScatter( is_dim_periodic, halo_width, *array );
+
+        // Repeat with the split-phase gather and scatter.
+        ArrayOp::assign( *array, 0.0, Ghost() );
+        ArrayOp::assign( *array, 1.0, Own() );
+        auto gather_request = halo->gatherBegin( TEST_EXECSPACE(), *array );
+        halo->gatherEnd( TEST_EXECSPACE(), gather_request, *array );
+        EXPECT_TRUE( gather_request.complete() );
+        checkGather( is_dim_periodic, halo_width, *array );
+        auto scatter_request = halo->scatterBegin( TEST_EXECSPACE(), *array );
+        halo->scatterEnd( TEST_EXECSPACE(), ScatterReduce::Sum(),
+                          scatter_request, *array );
+        EXPECT_TRUE( scatter_request.complete() );
+        checkScatter( is_dim_periodic, halo_width, *array );
     }
 
     // Repeat the process but this time with multiple arrays in a Halo
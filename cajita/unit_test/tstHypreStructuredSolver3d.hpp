@@ -22,6 +22,8 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 using namespace Cajita;
@@ -36,14 +38,15 @@ namespace Test
 // time. Once they have a run-time switch we can use that instead.
 template <class MemorySpace>
 std::enable_if_t<!HypreIsCompatibleWithMemorySpace<MemorySpace>::value, void>
-poissonTest( const std::string&, const std::string&, MemorySpace )
+poissonTest( const std::string&, const std::string&, MemorySpace,
+             const int = 1 )
 {
 }
 
 template <class MemorySpace>
 std::enable_if_t<HypreIsCompatibleWithMemorySpace<MemorySpace>::value, void>
 poissonTest( const std::string& solver_type, const std::string& precond_type,
-             MemorySpace )
+             MemorySpace, const int halo_width = 1 )
 {
     // Create the global grid.
     double cell_size = 0.25;
@@ -58,8 +61,9 @@ poissonTest( const std::string& solver_type, const std::string& precond_type,
     auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
                                          is_dim_periodic, partitioner );
 
-    // Create a local grid.
-    auto local_mesh = createLocalGrid( global_grid, 1 );
+    // Create a local grid. Without a halo HYPRE uses the values of the
+    // arrays directly.
+    auto local_mesh = createLocalGrid( global_grid, halo_width );
     auto owned_space = local_mesh->indexSpace( Own(), Cell(), Local() );
 
     // Create the RHS.
@@ -71,6 +75,17 @@ poissonTest( const std::string& solver_type, const std::string& precond_type,
     auto lhs = createArray<double, MemorySpace>( "lhs", vector_layout );
     ArrayOp::assign( *lhs, 0.0, Own() );
 
+    // Check that the owned values are passed to HYPRE directly exactly when
+    // they are a contiguous layout-right block.
+    using view_type = typename decltype( rhs )::element_type::view_type;
+    bool is_direct =
+        ( 0 == halo_width ) &&
+        std::is_same<typename view_type::array_layout,
+                     Kokkos::LayoutRight>::value;
+    auto rhs_owned = createSubview(
+        rhs->view(), vector_layout->indexSpace( Own(), Local() ) );
+    EXPECT_EQ( nullptr != Impl::hypreDirectPointer( rhs_owned ), is_direct );
+
     // Create a solver.
     auto solver = createHypreStructuredSolver<double, MemorySpace>(
         solver_type, *vector_layout );
@@ -124,26 +139,35 @@ poissonTest( const std::string& solver_type, const std::string& precond_type,
     // Solve the problem.
     solver->solve( *rhs, *lhs );
 
-    // Create a solver reference for comparison.
-    auto lhs_ref = createArray<double, MemorySpace>( "lhs_ref", vector_layout );
+    // Create a solver reference for comparison. The reference solver reads
+    // a halo so it uses its own grid.
+    auto ref_mesh = createLocalGrid( global_grid, 1 );
+    auto ref_owned_space = ref_mesh->indexSpace( Own(), Cell(), Local() );
+    auto ref_layout = createArrayLayout( ref_mesh, 1, Cell() );
+    auto rhs_ref = createArray<double, MemorySpace>( "rhs_ref", ref_layout );
+    ArrayOp::assign( *rhs_ref, 1.0, Own() );
+    auto lhs_ref = createArray<double, MemorySpace>( "lhs_ref", ref_layout );
     ArrayOp::assign( *lhs_ref, 0.0, Own() );
 
     auto ref_solver =
-        createReferenceConjugateGradient<double, MemorySpace>( *vector_layout );
+        createReferenceConjugateGradient<double, MemorySpace>( *ref_layout );
     ref_solver->setMatrixStencil( stencil );
     const auto& ref_entries = ref_solver->getMatrixValues();
     auto matrix_view = ref_entries.view();
-    auto global_space = local_mesh->indexSpace( Own(), Cell(), Global() );
+    auto global_space = ref_mesh->indexSpace( Own(), Cell(), Global() );
     int ncell_i = global_grid->globalNumEntity( Cell(), Dim::I );
     int ncell_j = global_grid->globalNumEntity( Cell(), Dim::J );
     int ncell_k = global_grid->globalNumEntity( Cell(), Dim::K );
     Kokkos::parallel_for(
         "fill_ref_entries",
-        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        createExecutionPolicy( ref_owned_space, TEST_EXECSPACE() ),
         KOKKOS_LAMBDA( const int i, const int j, const int k ) {
-            int gi = i + global_space.min( Dim::I ) - owned_space.min( Dim::I );
-            int gj = j + global_space.min( Dim::J ) - owned_space.min( Dim::J );
-            int gk = k + global_space.min( Dim::K ) - owned_space.min( Dim::K );
+            int gi =
+                i + global_space.min( Dim::I ) - ref_owned_space.min( Dim::I );
+            int gj =
+                j + global_space.min( Dim::J ) - ref_owned_space.min( Dim::J );
+            int gk =
+                k + global_space.min( Dim::K ) - ref_owned_space.min( Dim::K );
             matrix_view( i, j, k, 0 ) = 6.0;
             matrix_view( i, j, k, 1 ) = ( gi - 1 >= 0 ) ? -1.0 : 0.0;
             matrix_view( i, j, k, 2 ) = ( gi + 1 < ncell_i ) ? -1.0 : 0.0;
@@ -159,7 +183,7 @@ poissonTest( const std::string& solver_type, const std::string& precond_type,
     auto preconditioner_view = preconditioner_entries.view();
     Kokkos::parallel_for(
         "fill_preconditioner_entries",
-        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        createExecutionPolicy( ref_owned_space, TEST_EXECSPACE() ),
         KOKKOS_LAMBDA( const int i, const int j, const int k ) {
             preconditioner_view( i, j, k, 0 ) = 1.0 / 6.0;
         } );
@@ -167,21 +191,28 @@ poissonTest( const std::string& solver_type, const std::string& precond_type,
     ref_solver->setTolerance( 1.0e-11 );
     ref_solver->setPrintLevel( 1 );
     ref_solver->setup();
-    ref_solver->solve( *rhs, *lhs_ref );
-
-    // Check the results.
-    auto lhs_host =
-        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
-    auto lhs_ref_host = Kokkos::create_mirror_view_and_copy(
-        Kokkos::HostSpace(), lhs_ref->view() );
-    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
-          ++i )
-        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
-              ++j )
-            for ( int k = owned_space.min( Dim::K );
-                  k < owned_space.max( Dim::K ); ++k )
-                EXPECT_FLOAT_EQ( lhs_host( i, j, k, 0 ),
-                                 lhs_ref_host( i, j, k, 0 ) );
+    ref_solver->solve( *rhs_ref, *lhs_ref );
+
+    // Check the results against a multiple of the reference solution.
+    auto check_solution = [&]( const double scale ) {
+        auto lhs_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), lhs->view() );
+        auto lhs_ref_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), lhs_ref->view() );
+        for ( int i = 0; i < owned_space.extent( Dim::I ); ++i )
+            for ( int j = 0; j < owned_space.extent( Dim::J ); ++j )
+                for ( int k = 0; k < owned_space.extent( Dim::K ); ++k )
+                    EXPECT_FLOAT_EQ(
+                        lhs_host( owned_space.min( Dim::I ) + i,
+                                  owned_space.min( Dim::J ) + j,
+                                  owned_space.min( Dim::K ) + k, 0 ),
+                        scale *
+                            lhs_ref_host( ref_owned_space.min( Dim::I ) + i,
+                                          ref_owned_space.min( Dim::J ) + j,
+                                          ref_owned_space.min( Dim::K ) + k,
+                                          0 ) );
+    };
+    check_solution( 1.0 );
 
     // Setup the problem again. We would need to do this if we changed the
     // matrix entries.
@@ -193,22 +224,111 @@ poissonTest( const std::string& solver_type, const std::string& precond_type,
     solver->solve( *rhs, *lhs );
 
     // Compute another reference solution.
+    ArrayOp::assign( *rhs_ref, 2.0, Own() );
     ArrayOp::assign( *lhs_ref, 0.0, Own() );
-    ref_solver->solve( *rhs, *lhs_ref );
+    ref_solver->solve( *rhs_ref, *lhs_ref );
 
     // Check the results again
-    lhs_host =
-        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
-    lhs_ref_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
-                                                        lhs_ref->view() );
-    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
-          ++i )
-        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
-              ++j )
-            for ( int k = owned_space.min( Dim::K );
-                  k < owned_space.max( Dim::K ); ++k )
-                EXPECT_FLOAT_EQ( lhs_host( i, j, k, 0 ),
-                                 lhs_ref_host( i, j, k, 0 ) );
+    check_solution( 1.0 );
+
+    // Solve for a uniform RHS and a point source together and check each
+    // solution against the solution of its own system.
+    auto point = createArray<double, MemorySpace>( "point", vector_layout );
+    auto point_view = point->view();
+    auto point_global_space =
+        local_mesh->indexSpace( Own(), Cell(), Global() );
+    int off_i = point_global_space.min( Dim::I ) - owned_space.min( Dim::I );
+    int off_j = point_global_space.min( Dim::J ) - owned_space.min( Dim::J );
+    int off_k = point_global_space.min( Dim::K ) - owned_space.min( Dim::K );
+    Kokkos::parallel_for(
+        "fill_point_source",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            point_view( i, j, k, 0 ) =
+                ( 2 == i + off_i && 3 == j + off_j && 1 == k + off_k ) ? 1.0
+                                                                       : 0.0;
+        } );
+    std::array<std::shared_ptr<decltype( rhs )::element_type>, 2> rhs_single =
+        { rhs, point };
+    std::array<std::shared_ptr<decltype( rhs )::element_type>, 2> lhs_single;
+    for ( int n = 0; n < 2; ++n )
+    {
+        lhs_single[n] =
+            createArray<double, MemorySpace>( "lhs_single", vector_layout );
+        ArrayOp::assign( *lhs_single[n], 0.0, Own() );
+        solver->solve( *rhs_single[n], *lhs_single[n] );
+    }
+    auto block_layout = createArrayLayout( local_mesh, 2, Cell() );
+    auto rhs_block =
+        createArray<double, MemorySpace>( "rhs_block", block_layout );
+    auto lhs_block =
+        createArray<double, MemorySpace>( "lhs_block", block_layout );
+    for ( int n = 0; n < 2; ++n )
+        Kokkos::deep_copy( createSubarray( *rhs_block, n, n + 1 )->view(),
+                           rhs_single[n]->view() );
+    ArrayOp::assign( *lhs_block, 0.0, Own() );
+    solver->solveMultiple( *rhs_block, *lhs_block );
+    auto lhs_block_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), lhs_block->view() );
+    for ( int n = 0; n < 2; ++n )
+    {
+        auto lhs_single_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), lhs_single[n]->view() );
+        for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+              ++i )
+            for ( int j = owned_space.min( Dim::J );
+                  j < owned_space.max( Dim::J ); ++j )
+                for ( int k = owned_space.min( Dim::K );
+                      k < owned_space.max( Dim::K ); ++k )
+                    EXPECT_NEAR( lhs_block_host( i, j, k, n ),
+                                 lhs_single_host( i, j, k, 0 ), 1.0e-6 );
+    }
+
+    // Scale the matrix entries in place and update them in the persistent
+    // HYPRE matrix. Scaling the matrix by two halves the solution.
+    Kokkos::parallel_for(
+        "scale_matrix_entries",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            for ( int n = 0; n < 7; ++n )
+                entry_view( i, j, k, n ) *= 2.0;
+        } );
+    solver->updateMatrixValues( *matrix_entries, { 0, 1, 2, 3, 4, 5, 6 } );
+    solver->setup();
+    ArrayOp::assign( *lhs, 0.0, Own() );
+    solver->solve( *rhs, *lhs );
+
+    // Check the results against half of the last reference solution.
+    check_solution( 0.5 );
+
+    // Double the diagonal and clear the off-diagonal entries of the array,
+    // then update only the diagonal. HYPRE must keep the previous
+    // off-diagonal entries, giving twice a Laplacian with a diagonal of 12.
+    Kokkos::parallel_for(
+        "update_diagonal_entries",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            entry_view( i, j, k, 0 ) = 24.0;
+            for ( int n = 1; n < 7; ++n )
+                entry_view( i, j, k, n ) = 0.0;
+        } );
+    solver->updateMatrixValues( *matrix_entries, { 0 } );
+    solver->setup();
+    ArrayOp::assign( *lhs, 0.0, Own() );
+    solver->solve( *rhs, *lhs );
+
+    // Compute the reference solution with a diagonal of 12.
+    Kokkos::parallel_for(
+        "update_ref_diagonal_entries",
+        createExecutionPolicy( ref_owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            matrix_view( i, j, k, 0 ) = 12.0;
+        } );
+    ArrayOp::assign( *lhs_ref, 0.0, Own() );
+    ref_solver->solve( *rhs_ref, *lhs_ref );
+
+    // Check the results against half of the new reference solution.
+    check_solution( 0.5 );
 }
 
 //---------------------------------------------------------------------------//
@@ -264,6 +384,16 @@ TEST( structured_solver, bicgstab_jacobi_test )
     poissonTest( "BiCGSTAB", "Jacobi", TEST_MEMSPACE{} );
 }
 
+TEST( structured_solver, pcg_none_no_halo_test )
+{
+    poissonTest( "PCG", "none", TEST_MEMSPACE{}, 0 );
+}
+
+TEST( structured_solver, pcg_diag_no_halo_test )
+{
+    poissonTest( "PCG", "Diagonal", TEST_MEMSPACE{}, 0 );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -584,6 +584,39 @@ void inRangeTest()
     EXPECT_FALSE( space.inRange( i8 ) );
 }
 
+//---------------------------------------------------------------------------//
+void interiorBoundaryTest( const long width )
+{
+    IndexSpace<3> space( { 9, 2, 1 }, { 12, 16, 5 } );
+    auto interior = interiorIndexSpace( space, width );
+    auto slabs = boundarySlabIndexSpaces( space, width );
+
+    // Every index should be in exactly one of the interior or the slabs and
+    // the interior should be at least the width from the boundary.
+    long total_size = interior.size();
+    for ( int s = 0; s < 6; ++s )
+        total_size += slabs[s].size();
+    EXPECT_EQ( total_size, space.size() );
+    for ( long i = space.min( 0 ); i < space.max( 0 ); ++i )
+        for ( long j = space.min( 1 ); j < space.max( 1 ); ++j )
+            for ( long k = space.min( 2 ); k < space.max( 2 ); ++k )
+            {
+                long ijk[3] = { i, j, k };
+                int count = interior.inRange( ijk ) ? 1 : 0;
+                for ( int s = 0; s < 6; ++s )
+                    if ( slabs[s].inRange( ijk ) )
+                        ++count;
+                EXPECT_EQ( count, 1 );
+
+                if ( interior.inRange( ijk ) )
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        EXPECT_GE( ijk[d], space.min( d ) + width );
+                        EXPECT_LT( ijk[d], space.max( d ) - width );
+                    }
+            }
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -597,6 +630,9 @@ TEST( TEST_CATEGORY, index_space_test )
     rangeAppendTest();
     comparisonTest();
     defaultConstructorTest();
+    interiorBoundaryTest( 0 );
+    interiorBoundaryTest( 1 );
+    interiorBoundaryTest( 2 );
 }
 
 //---------------------------------------------------------------------------//
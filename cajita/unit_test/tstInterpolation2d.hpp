@@ -27,6 +27,7 @@
 
 #include <array>
 #include <cmath>
+#include <stdexcept>
 #include <vector>
 
 using namespace Cajita;
@@ -177,6 +178,74 @@ void interpolationTest()
             for ( int d = 0; d < 2; ++d )
                 EXPECT_FLOAT_EQ( vector_grid_host( i, j, d ) + 1.0, 1.0 );
 
+    // Interpolate a scalar point value to the grid with sorted deposition.
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2g( scalar_p2g, points, num_point, Spline<1>(), *scalar_halo,
+         *scalar_grid_field, SortedP2GTag(), 3 );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            EXPECT_FLOAT_EQ( scalar_grid_host( i, j, 0 ), -1.75 );
+
+    // Interpolate a vector point value to the grid with sorted deposition.
+    ArrayOp::assign( *vector_grid_field, 0.0, Ghost() );
+    p2g( vector_p2g, points, num_point, Spline<1>(), *vector_halo,
+         *vector_grid_field, SortedP2GTag() );
+    Kokkos::deep_copy( vector_grid_host, vector_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int d = 0; d < 2; ++d )
+                EXPECT_FLOAT_EQ( vector_grid_host( i, j, d ), -1.75 );
+
+    // Tiles as narrow as the stencil overlap touch the neighboring tiles of
+    // the other colors.
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2g( scalar_p2g, points, num_point, Spline<1>(), *scalar_halo,
+         *scalar_grid_field, SortedP2GTag(), 1 );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            EXPECT_FLOAT_EQ( scalar_grid_host( i, j, 0 ), -1.75 );
+
+    // Tiles narrower than the stencil overlap would overlap within a color.
+    EXPECT_THROW( p2g( scalar_p2g, points, num_point, Spline<2>(),
+                       *scalar_halo, *scalar_grid_field, SortedP2GTag(), 1 ),
+                  std::runtime_error );
+
+    // Interpolate scalar and vector point values to the grid in one sweep.
+    auto fused_halo = createHalo( NodeHaloPattern<2>(), halo_width,
+                                  *scalar_grid_field, *vector_grid_field );
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    ArrayOp::assign( *vector_grid_field, 0.0, Ghost() );
+    p2g( Cabana::makeParameterPack( scalar_p2g, vector_p2g ), points,
+         num_point, Spline<1>(), *fused_halo, *scalar_grid_field,
+         *vector_grid_field );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    Kokkos::deep_copy( vector_grid_host, vector_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+        {
+            EXPECT_FLOAT_EQ( scalar_grid_host( i, j, 0 ), -1.75 );
+            for ( int d = 0; d < 2; ++d )
+                EXPECT_FLOAT_EQ( vector_grid_host( i, j, d ), -1.75 );
+        }
+
+    // Interpolate a scalar point value to the grid with cached spline data.
+    auto spline_cache = createSplineDataCache( local_mesh, points, num_point,
+                                               Spline<1>(), Node() );
+    EXPECT_EQ( spline_cache.size(), static_cast<std::size_t>( num_point ) );
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2g( scalar_p2g, spline_cache, *scalar_halo, *scalar_grid_field );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            EXPECT_FLOAT_EQ( scalar_grid_host( i, j, 0 ), -1.75 );
+
     // G2P
     // ---
 
@@ -233,6 +302,188 @@ void interpolationTest()
     Kokkos::deep_copy( scalar_point_host, scalar_point_field );
     for ( int p = 0; p < num_point; ++p )
         EXPECT_FLOAT_EQ( scalar_point_host( p ) + 1.0, 1.0 );
+
+    // Interpolate scalar and vector grid values to the points in one sweep.
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    Kokkos::deep_copy( vector_point_field, 0.0 );
+    g2p( *fused_halo, points, num_point, Spline<1>(),
+         Cabana::makeParameterPack( scalar_value_g2p, vector_value_g2p ),
+         *scalar_grid_field, *vector_grid_field );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    Kokkos::deep_copy( vector_point_host, vector_point_field );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -1.75 );
+        for ( int d = 0; d < 2; ++d )
+            EXPECT_FLOAT_EQ( vector_point_host( p, d ), -1.75 );
+    }
+
+    // Interpolate a scalar grid value to the points with cached spline data.
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    g2p( *scalar_grid_field, *scalar_halo, spline_cache, scalar_value_g2p );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -1.75 );
+}
+
+//---------------------------------------------------------------------------//
+// Compare cell-sorted evaluation from scratch tiles against the default G2P
+// for a linear field so that any error in the tile origin, halo offset, or
+// scratch indexing changes the result.
+template <int SplineOrder>
+void sortedG2PTest( const int tile_width )
+{
+    // Create the global mesh.
+    std::array<double, 2> low_corner = { -1.2, 0.1 };
+    std::array<double, 2> high_corner = { -0.2, 2.5 };
+    double cell_size = 0.1;
+    auto global_mesh =
+        createUniformGlobalMesh( low_corner, high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<2> partitioner;
+    std::array<bool, 2> is_dim_periodic = { false, false };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a grid local_grid.
+    int halo_width = 2;
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    auto local_mesh = createLocalMesh<TEST_DEVICE>( *local_grid );
+
+    // Create a point in every cell at an offset from the low corner of the
+    // cell that varies from cell to cell.
+    auto cell_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    int num_point = cell_space.size();
+    Kokkos::View<double* [2], TEST_DEVICE> points(
+        Kokkos::ViewAllocateWithoutInitializing( "points" ), num_point );
+    Kokkos::parallel_for(
+        "fill_points", createExecutionPolicy( cell_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j ) {
+            int pi = i - halo_width;
+            int pj = j - halo_width;
+            int pid = pi + cell_space.extent( Dim::I ) * pj;
+            int idx[2] = { i, j };
+            double x[2];
+            local_mesh.coordinates( Node(), idx, x );
+            for ( int d = 0; d < 2; ++d )
+            {
+                int h = ( 3 * i + 7 * j + d ) % 10;
+                points( pid, d ) = x[d] + cell_size * ( 0.05 + 0.09 * h );
+            }
+        } );
+    auto points_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), points );
+
+    // Create a linear scalar field and a linear vector field on the nodes.
+    auto scalar_layout = createArrayLayout( local_grid, 1, Node() );
+    auto scalar_grid_field =
+        createArray<double, TEST_DEVICE>( "scalar_grid_field", scalar_layout );
+    auto scalar_halo =
+        createHalo( NodeHaloPattern<2>(), halo_width, *scalar_grid_field );
+    auto vector_layout = createArrayLayout( local_grid, 2, Node() );
+    auto vector_grid_field =
+        createArray<double, TEST_DEVICE>( "vector_grid_field", vector_layout );
+    auto vector_halo =
+        createHalo( NodeHaloPattern<2>(), halo_width, *vector_grid_field );
+    auto scalar_view = scalar_grid_field->view();
+    auto vector_view = vector_grid_field->view();
+    auto node_space = local_grid->indexSpace( Ghost(), Node(), Local() );
+    Kokkos::parallel_for(
+        "fill_grid", createExecutionPolicy( node_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j ) {
+            int idx[2] = { i, j };
+            double x[2];
+            local_mesh.coordinates( Node(), idx, x );
+            double f = x[Dim::I] + 2.0 * x[Dim::J];
+            scalar_view( i, j, 0 ) = f;
+            for ( int d = 0; d < 2; ++d )
+                vector_view( i, j, d ) = ( d + 1.0 ) * f;
+        } );
+
+    // Point fields for the default and sorted evaluations.
+    Kokkos::View<double*, TEST_DEVICE> value( "value", num_point );
+    Kokkos::View<double*, TEST_DEVICE> value_sorted( "value_sorted",
+                                                     num_point );
+    Kokkos::View<double* [2], TEST_DEVICE> gradient( "gradient", num_point );
+    Kokkos::View<double* [2], TEST_DEVICE> gradient_sorted( "gradient_sorted",
+                                                            num_point );
+    Kokkos::View<double*, TEST_DEVICE> divergence( "divergence", num_point );
+    Kokkos::View<double*, TEST_DEVICE> divergence_sorted( "divergence_sorted",
+                                                          num_point );
+    Kokkos::View<double* [2][2], TEST_DEVICE> vector_gradient(
+        "vector_gradient", num_point );
+    Kokkos::View<double* [2][2], TEST_DEVICE> vector_gradient_sorted(
+        "vector_gradient_sorted", num_point );
+
+    // Interpolate with the default and the sorted evaluation.
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+         Spline<SplineOrder>(), createScalarValueG2P( value, 1.0 ) );
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+         Spline<SplineOrder>(), createScalarValueG2P( value_sorted, 1.0 ),
+         SortedG2PTag(), tile_width );
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+         Spline<SplineOrder>(), createScalarGradientG2P( gradient, 1.0 ) );
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+         Spline<SplineOrder>(),
+         createScalarGradientG2P( gradient_sorted, 1.0 ), SortedG2PTag(),
+         tile_width );
+    g2p( *vector_grid_field, *vector_halo, points, num_point,
+         Spline<SplineOrder>(), createVectorDivergenceG2P( divergence, 1.0 ) );
+    g2p( *vector_grid_field, *vector_halo, points, num_point,
+         Spline<SplineOrder>(),
+         createVectorDivergenceG2P( divergence_sorted, 1.0 ), SortedG2PTag(),
+         tile_width );
+    g2p( *vector_grid_field, *vector_halo, points, num_point,
+         Spline<SplineOrder>(),
+         createVectorGradientG2P( vector_gradient, 1.0 ) );
+    g2p( *vector_grid_field, *vector_halo, points, num_point,
+         Spline<SplineOrder>(),
+         createVectorGradientG2P( vector_gradient_sorted, 1.0 ),
+         SortedG2PTag(), tile_width );
+
+    // Check the results point by point.
+    auto value_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), value );
+    auto value_sorted_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), value_sorted );
+    auto gradient_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), gradient );
+    auto gradient_sorted_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), gradient_sorted );
+    auto divergence_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), divergence );
+    auto divergence_sorted_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), divergence_sorted );
+    auto vector_gradient_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), vector_gradient );
+    auto vector_gradient_sorted_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), vector_gradient_sorted );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        double f = points_host( p, Dim::I ) + 2.0 * points_host( p, Dim::J );
+        EXPECT_NEAR( value_host( p ), f, 1.0e-10 );
+        EXPECT_NEAR( value_sorted_host( p ), value_host( p ), 1.0e-12 );
+        for ( int d = 0; d < 2; ++d )
+        {
+            EXPECT_NEAR( gradient_host( p, d ), d + 1.0, 1.0e-10 );
+            EXPECT_NEAR( gradient_sorted_host( p, d ), gradient_host( p, d ),
+                         1.0e-12 );
+            for ( int e = 0; e < 2; ++e )
+                EXPECT_NEAR( vector_gradient_sorted_host( p, d, e ),
+                             vector_gradient_host( p, d, e ), 1.0e-12 );
+        }
+        EXPECT_NEAR( divergence_host( p ), 5.0, 1.0e-10 );
+        EXPECT_NEAR( divergence_sorted_host( p ), divergence_host( p ),
+                     1.0e-12 );
+    }
+
+    // A scratch tile larger than the team scratch memory is rejected.
+    EXPECT_THROW( g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+                       Spline<SplineOrder>(),
+                       createScalarValueG2P( value_sorted, 1.0 ),
+                       SortedG2PTag(), 200 ),
+                  std::runtime_error );
 }
 
 //---------------------------------------------------------------------------//
@@ -240,6 +491,15 @@ void interpolationTest()
 //---------------------------------------------------------------------------//
 TEST( interpolation, interpolation_test ) { interpolationTest(); }
 
+TEST( interpolation, sorted_g2p_test )
+{
+    for ( int tile_width : { 3, 4 } )
+    {
+        sortedG2PTest<1>( tile_width );
+        sortedG2PTest<2>( tile_width );
+    }
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -11,6 +11,8 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <Cabana_AoSoA.hpp>
+
 #include <Cajita_Array.hpp>
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
@@ -27,6 +29,7 @@
 
 #include <array>
 #include <cmath>
+#include <stdexcept>
 #include <vector>
 
 using namespace Cajita;
@@ -192,6 +195,106 @@ void interpolationTest()
                     EXPECT_FLOAT_EQ( vector_grid_host( i, j, k, d ) + 1.0,
                                      1.0 );
 
+    // Interpolate a scalar point value to the grid with sorted deposition.
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2g( scalar_p2g, points, num_point, Spline<1>(), *scalar_halo,
+         *scalar_grid_field, SortedP2GTag(), 3 );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( scalar_grid_host( i, j, k, 0 ), -1.75 );
+
+    // Interpolate a vector point value to the grid with sorted deposition.
+    ArrayOp::assign( *vector_grid_field, 0.0, Ghost() );
+    p2g( vector_p2g, points, num_point, Spline<1>(), *vector_halo,
+         *vector_grid_field, SortedP2GTag() );
+    Kokkos::deep_copy( vector_grid_host, vector_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                for ( int d = 0; d < 3; ++d )
+                    EXPECT_FLOAT_EQ( vector_grid_host( i, j, k, d ), -1.75 );
+
+    // Tiles as narrow as the stencil overlap touch the neighboring tiles of
+    // the other colors.
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2g( scalar_p2g, points, num_point, Spline<1>(), *scalar_halo,
+         *scalar_grid_field, SortedP2GTag(), 1 );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( scalar_grid_host( i, j, k, 0 ), -1.75 );
+
+    // Tiles narrower than the stencil overlap would overlap within a color.
+    EXPECT_THROW( p2g( scalar_p2g, points, num_point, Spline<2>(),
+                       *scalar_halo, *scalar_grid_field, SortedP2GTag(), 1 ),
+                  std::runtime_error );
+
+    // Interpolate scalar and vector point values to the grid in one sweep.
+    auto fused_halo = createHalo( NodeHaloPattern<3>(), halo_width,
+                                  *scalar_grid_field, *vector_grid_field );
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    ArrayOp::assign( *vector_grid_field, 0.0, Ghost() );
+    p2g( Cabana::makeParameterPack( scalar_p2g, vector_p2g ), points,
+         num_point, Spline<1>(), *fused_halo, *scalar_grid_field,
+         *vector_grid_field );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    Kokkos::deep_copy( vector_grid_host, vector_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+            {
+                EXPECT_FLOAT_EQ( scalar_grid_host( i, j, k, 0 ), -1.75 );
+                for ( int d = 0; d < 3; ++d )
+                    EXPECT_FLOAT_EQ( vector_grid_host( i, j, k, d ), -1.75 );
+            }
+
+    // Interpolate a scalar point value to the grid with cached spline data.
+    auto spline_cache = createSplineDataCache( local_mesh, points, num_point,
+                                               Spline<1>(), Node() );
+    EXPECT_EQ( spline_cache.size(), static_cast<std::size_t>( num_point ) );
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2g( scalar_p2g, spline_cache, *scalar_halo, *scalar_grid_field );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( scalar_grid_host( i, j, k, 0 ), -1.75 );
+
+    // Interpolate a scalar point value to the grid with batched spline
+    // evaluation over the SoAs of the points.
+    Cabana::AoSoA<Cabana::MemberTypes<double[3]>, TEST_MEMSPACE, 8>
+        point_aosoa( "point_aosoa", num_point );
+    auto point_slice = Cabana::slice<0>( point_aosoa );
+    Kokkos::parallel_for(
+        "fill_point_slice", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, num_point ),
+        KOKKOS_LAMBDA( const int p ) {
+            for ( int d = 0; d < 3; ++d )
+                point_slice( p, d ) = points( p, d );
+        } );
+    ArrayOp::assign( *scalar_grid_field, 0.0, Ghost() );
+    p2g( scalar_p2g, point_slice, num_point, Spline<1>(), *scalar_halo,
+         *scalar_grid_field, BatchedSplineTag() );
+    Kokkos::deep_copy( scalar_grid_host, scalar_grid_field->view() );
+    for ( int i = node_space.min( Dim::I ); i < node_space.max( Dim::I ); ++i )
+        for ( int j = node_space.min( Dim::J ); j < node_space.max( Dim::J );
+              ++j )
+            for ( int k = node_space.min( Dim::K );
+                  k < node_space.max( Dim::K ); ++k )
+                EXPECT_FLOAT_EQ( scalar_grid_host( i, j, k, 0 ), -1.75 );
+
     // G2P
     // ---
 
@@ -248,6 +351,348 @@ void interpolationTest()
     Kokkos::deep_copy( scalar_point_host, scalar_point_field );
     for ( int p = 0; p < num_point; ++p )
         EXPECT_FLOAT_EQ( scalar_point_host( p ) + 1.0, 1.0 );
+
+    // Interpolate scalar and vector grid values to the points in one sweep.
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    Kokkos::deep_copy( vector_point_field, 0.0 );
+    g2p( *fused_halo, points, num_point, Spline<1>(),
+         Cabana::makeParameterPack( scalar_value_g2p, vector_value_g2p ),
+         *scalar_grid_field, *vector_grid_field );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    Kokkos::deep_copy( vector_point_host, vector_point_field );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -1.75 );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_FLOAT_EQ( vector_point_host( p, d ), -1.75 );
+    }
+
+    // Interpolate a scalar grid value to the points with cached spline data.
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    g2p( *scalar_grid_field, *scalar_halo, spline_cache, scalar_value_g2p );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -1.75 );
+
+    // Interpolate a vector grid gradient to the points with batched spline
+    // evaluation over the SoAs of the points.
+    Kokkos::deep_copy( tensor_point_field, 0.0 );
+    g2p( *vector_grid_field, *vector_halo, point_slice, num_point, Spline<1>(),
+         vector_gradient_g2p, BatchedSplineTag() );
+    Kokkos::deep_copy( tensor_point_host, tensor_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 3; ++j )
+                EXPECT_FLOAT_EQ( tensor_point_host( p, i, j ) + 1.0, 1.0 );
+
+    // Interpolate a scalar grid value to the points with batched spline
+    // evaluation.
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    g2p( *scalar_grid_field, *scalar_halo, point_slice, num_point, Spline<1>(),
+         scalar_value_g2p, BatchedSplineTag() );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -1.75 );
+
+    // Interpolate a scalar grid value to the points with cell-sorted
+    // evaluation from scratch tiles.
+    Kokkos::deep_copy( scalar_point_field, 0.0 );
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point, Spline<1>(),
+         scalar_value_g2p, SortedG2PTag(), 3 );
+    Kokkos::deep_copy( scalar_point_host, scalar_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        EXPECT_FLOAT_EQ( scalar_point_host( p ), -1.75 );
+
+    // Interpolate a vector grid gradient to the points with cell-sorted
+    // evaluation.
+    Kokkos::deep_copy( tensor_point_field, 0.0 );
+    g2p( *vector_grid_field, *vector_halo, points, num_point, Spline<1>(),
+         vector_gradient_g2p, SortedG2PTag() );
+    Kokkos::deep_copy( tensor_point_host, tensor_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 3; ++j )
+                EXPECT_FLOAT_EQ( tensor_point_host( p, i, j ) + 1.0, 1.0 );
+}
+
+//---------------------------------------------------------------------------//
+// Compare cell-sorted evaluation from scratch tiles against the default G2P
+// for a linear field so that any error in the tile origin, halo offset, or
+// scratch indexing changes the result.
+template <int SplineOrder>
+void sortedG2PTest( const int tile_width )
+{
+    // Create the global mesh.
+    std::array<double, 3> low_corner = { -1.2, 0.1, 1.1 };
+    std::array<double, 3> high_corner = { -0.3, 1.5, 2.3 };
+    double cell_size = 0.1;
+    auto global_mesh =
+        createUniformGlobalMesh( low_corner, high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a grid local_grid.
+    int halo_width = 2;
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    auto local_mesh = createLocalMesh<TEST_DEVICE>( *local_grid );
+
+    // Create a point in every cell at an offset from the low corner of the
+    // cell that varies from cell to cell.
+    auto cell_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    int num_point = cell_space.size();
+    Kokkos::View<double* [3], TEST_DEVICE> points(
+        Kokkos::ViewAllocateWithoutInitializing( "points" ), num_point );
+    Kokkos::parallel_for(
+        "fill_points", createExecutionPolicy( cell_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int pi = i - halo_width;
+            int pj = j - halo_width;
+            int pk = k - halo_width;
+            int pid = pi + cell_space.extent( Dim::I ) *
+                               ( pj + cell_space.extent( Dim::J ) * pk );
+            int idx[3] = { i, j, k };
+            double x[3];
+            local_mesh.coordinates( Node(), idx, x );
+            for ( int d = 0; d < 3; ++d )
+            {
+                int h = ( 3 * i + 7 * j + 5 * k + d ) % 10;
+                points( pid, d ) = x[d] + cell_size * ( 0.05 + 0.09 * h );
+            }
+        } );
+    auto points_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), points );
+
+    // Create a linear scalar field and a linear vector field on the nodes.
+    auto scalar_layout = createArrayLayout( local_grid, 1, Node() );
+    auto scalar_grid_field =
+        createArray<double, TEST_DEVICE>( "scalar_grid_field", scalar_layout );
+    auto scalar_halo =
+        createHalo( NodeHaloPattern<3>(), halo_width, *scalar_grid_field );
+    auto vector_layout = createArrayLayout( local_grid, 3, Node() );
+    auto vector_grid_field =
+        createArray<double, TEST_DEVICE>( "vector_grid_field", vector_layout );
+    auto vector_halo =
+        createHalo( NodeHaloPattern<3>(), halo_width, *vector_grid_field );
+    auto scalar_view = scalar_grid_field->view();
+    auto vector_view = vector_grid_field->view();
+    auto node_space = local_grid->indexSpace( Ghost(), Node(), Local() );
+    Kokkos::parallel_for(
+        "fill_grid", createExecutionPolicy( node_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int idx[3] = { i, j, k };
+            double x[3];
+            local_mesh.coordinates( Node(), idx, x );
+            double f = x[Dim::I] + 2.0 * x[Dim::J] + 3.0 * x[Dim::K];
+            scalar_view( i, j, k, 0 ) = f;
+            for ( int d = 0; d < 3; ++d )
+                vector_view( i, j, k, d ) = ( d + 1.0 ) * f;
+        } );
+
+    // Point fields for the default and sorted evaluations.
+    Kokkos::View<double*, TEST_DEVICE> value( "value", num_point );
+    Kokkos::View<double*, TEST_DEVICE> value_sorted( "value_sorted",
+                                                     num_point );
+    Kokkos::View<double* [3], TEST_DEVICE> gradient( "gradient", num_point );
+    Kokkos::View<double* [3], TEST_DEVICE> gradient_sorted( "gradient_sorted",
+                                                            num_point );
+    Kokkos::View<double*, TEST_DEVICE> divergence( "divergence", num_point );
+    Kokkos::View<double*, TEST_DEVICE> divergence_sorted( "divergence_sorted",
+                                                          num_point );
+    Kokkos::View<double* [3][3], TEST_DEVICE> vector_gradient(
+        "vector_gradient", num_point );
+    Kokkos::View<double* [3][3], TEST_DEVICE> vector_gradient_sorted(
+        "vector_gradient_sorted", num_point );
+
+    // Interpolate with the default and the sorted evaluation.
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+         Spline<SplineOrder>(), createScalarValueG2P( value, 1.0 ) );
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+         Spline<SplineOrder>(), createScalarValueG2P( value_sorted, 1.0 ),
+         SortedG2PTag(), tile_width );
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+         Spline<SplineOrder>(), createScalarGradientG2P( gradient, 1.0 ) );
+    g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+         Spline<SplineOrder>(),
+         createScalarGradientG2P( gradient_sorted, 1.0 ), SortedG2PTag(),
+         tile_width );
+    g2p( *vector_grid_field, *vector_halo, points, num_point,
+         Spline<SplineOrder>(), createVectorDivergenceG2P( divergence, 1.0 ) );
+    g2p( *vector_grid_field, *vector_halo, points, num_point,
+         Spline<SplineOrder>(),
+         createVectorDivergenceG2P( divergence_sorted, 1.0 ), SortedG2PTag(),
+         tile_width );
+    g2p( *vector_grid_field, *vector_halo, points, num_point,
+         Spline<SplineOrder>(),
+         createVectorGradientG2P( vector_gradient, 1.0 ) );
+    g2p( *vector_grid_field, *vector_halo, points, num_point,
+         Spline<SplineOrder>(),
+         createVectorGradientG2P( vector_gradient_sorted, 1.0 ),
+         SortedG2PTag(), tile_width );
+
+    // Check the results point by point.
+    auto value_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), value );
+    auto value_sorted_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), value_sorted );
+    auto gradient_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), gradient );
+    auto gradient_sorted_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), gradient_sorted );
+    auto divergence_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), divergence );
+    auto divergence_sorted_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), divergence_sorted );
+    auto vector_gradient_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), vector_gradient );
+    auto vector_gradient_sorted_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), vector_gradient_sorted );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        double f = points_host( p, Dim::I ) + 2.0 * points_host( p, Dim::J ) +
+                   3.0 * points_host( p, Dim::K );
+        EXPECT_NEAR( value_host( p ), f, 1.0e-10 );
+        EXPECT_NEAR( value_sorted_host( p ), value_host( p ), 1.0e-12 );
+        for ( int d = 0; d < 3; ++d )
+        {
+            EXPECT_NEAR( gradient_host( p, d ), d + 1.0, 1.0e-10 );
+            EXPECT_NEAR( gradient_sorted_host( p, d ), gradient_host( p, d ),
+                         1.0e-12 );
+            for ( int e = 0; e < 3; ++e )
+                EXPECT_NEAR( vector_gradient_sorted_host( p, d, e ),
+                             vector_gradient_host( p, d, e ), 1.0e-12 );
+        }
+        EXPECT_NEAR( divergence_host( p ), 14.0, 1.0e-10 );
+        EXPECT_NEAR( divergence_sorted_host( p ), divergence_host( p ),
+                     1.0e-12 );
+    }
+
+    // A scratch tile larger than the team scratch memory is rejected.
+    EXPECT_THROW( g2p( *scalar_grid_field, *scalar_halo, points, num_point,
+                       Spline<SplineOrder>(),
+                       createScalarValueG2P( value_sorted, 1.0 ),
+                       SortedG2PTag(), 100 ),
+                  std::runtime_error );
+}
+
+//---------------------------------------------------------------------------//
+void nonUniformInterpolationTest()
+{
+    // Create a global mesh with cells that grow along each dimension.
+    std::array<double, 3> low_corner = { -1.2, 0.1, 1.1 };
+    std::array<int, 3> num_cell = { 12, 18, 14 };
+    std::array<std::vector<double>, 3> edges;
+    for ( int d = 0; d < 3; ++d )
+        for ( int n = 0; n < num_cell[d] + 1; ++n )
+            edges[d].push_back( low_corner[d] + 0.1 * n + 0.005 * n * n );
+    auto global_mesh = createNonUniformGlobalMesh( edges[Dim::I], edges[Dim::J],
+                                                   edges[Dim::K] );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a  grid local_grid.
+    int halo_width = 1;
+    auto local_grid = createLocalGrid( global_grid, halo_width );
+    auto local_mesh = createLocalMesh<TEST_DEVICE>( *local_grid );
+
+    // Create a point in the center of every cell.
+    auto cell_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    int num_point = cell_space.size();
+    Kokkos::View<double* [3], TEST_DEVICE> points(
+        Kokkos::ViewAllocateWithoutInitializing( "points" ), num_point );
+    Kokkos::parallel_for(
+        "fill_points", createExecutionPolicy( cell_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int pi = i - halo_width;
+            int pj = j - halo_width;
+            int pk = k - halo_width;
+            int pid = pi + cell_space.extent( Dim::I ) *
+                               ( pj + cell_space.extent( Dim::J ) * pk );
+            int idx[3] = { i, j, k };
+            double x[3];
+            local_mesh.coordinates( Cell(), idx, x );
+            points( pid, Dim::I ) = x[Dim::I];
+            points( pid, Dim::J ) = x[Dim::J];
+            points( pid, Dim::K ) = x[Dim::K];
+        } );
+    auto points_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), points );
+
+    // Create a scalar field on the nodes that is linear in space.
+    auto layout = createArrayLayout( local_grid, 1, Node() );
+    auto grid_field = createArray<double, TEST_DEVICE>( "grid_field", layout );
+    auto halo = createHalo( NodeHaloPattern<3>(), halo_width, *grid_field );
+    auto grid_view = grid_field->view();
+    auto node_space = local_grid->indexSpace( Ghost(), Node(), Local() );
+    Kokkos::parallel_for(
+        "fill_grid", createExecutionPolicy( node_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int idx[3] = { i, j, k };
+            double x[3];
+            local_mesh.coordinates( Node(), idx, x );
+            grid_view( i, j, k, 0 ) =
+                1.0 + 2.0 * x[Dim::I] - 0.5 * x[Dim::J] + 3.0 * x[Dim::K];
+        } );
+
+    // Linear interpolation of a linear field is exact.
+    Kokkos::View<double*, TEST_DEVICE> scalar_point_field( "scalar_point_field",
+                                                           num_point );
+    auto scalar_value_g2p = createScalarValueG2P( scalar_point_field, 1.0 );
+    g2p( *grid_field, *halo, points, num_point, Spline<1>(), scalar_value_g2p );
+    auto scalar_point_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), scalar_point_field );
+    for ( int p = 0; p < num_point; ++p )
+        EXPECT_NEAR( scalar_point_host( p ),
+                     1.0 + 2.0 * points_host( p, Dim::I ) -
+                         0.5 * points_host( p, Dim::J ) +
+                         3.0 * points_host( p, Dim::K ),
+                     1.0e-10 );
+
+    // So is its gradient.
+    Kokkos::View<double* [3], TEST_DEVICE> vector_point_field(
+        "vector_point_field", num_point );
+    auto scalar_gradient_g2p =
+        createScalarGradientG2P( vector_point_field, 1.0 );
+    g2p( *grid_field, *halo, points, num_point, Spline<1>(),
+         scalar_gradient_g2p );
+    auto vector_point_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), vector_point_field );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        EXPECT_NEAR( vector_point_host( p, Dim::I ), 2.0, 1.0e-10 );
+        EXPECT_NEAR( vector_point_host( p, Dim::J ), -0.5, 1.0e-10 );
+        EXPECT_NEAR( vector_point_host( p, Dim::K ), 3.0, 1.0e-10 );
+    }
+
+    // Interpolating a unit value from every point to the grid conserves the
+    // total.
+    Kokkos::deep_copy( scalar_point_field, 1.0 );
+    ArrayOp::assign( *grid_field, 0.0, Ghost() );
+    auto scalar_p2g = createScalarValueP2G( scalar_point_field, 1.0 );
+    p2g( scalar_p2g, points, num_point, Spline<1>(), *halo, *grid_field );
+    auto grid_host = Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                          grid_field->view() );
+    auto own_node_space = local_grid->indexSpace( Own(), Node(), Local() );
+    double local_total = 0.0;
+    for ( int i = own_node_space.min( Dim::I );
+          i < own_node_space.max( Dim::I ); ++i )
+        for ( int j = own_node_space.min( Dim::J );
+              j < own_node_space.max( Dim::J ); ++j )
+            for ( int k = own_node_space.min( Dim::K );
+                  k < own_node_space.max( Dim::K ); ++k )
+                local_total += grid_host( i, j, k, 0 );
+    double total = 0.0;
+    MPI_Allreduce( &local_total, &total, 1, MPI_DOUBLE, MPI_SUM,
+                   MPI_COMM_WORLD );
+    EXPECT_NEAR( total, num_cell[Dim::I] * num_cell[Dim::J] * num_cell[Dim::K],
+                 1.0e-8 );
 }
 
 //---------------------------------------------------------------------------//
@@ -255,6 +700,20 @@ void interpolationTest()
 //---------------------------------------------------------------------------//
 TEST( interpolation, interpolation_test ) { interpolationTest(); }
 
+TEST( interpolation, sorted_g2p_test )
+{
+    for ( int tile_width : { 3, 4 } )
+    {
+        sortedG2PTest<1>( tile_width );
+        sortedG2PTest<2>( tile_width );
+    }
+}
+
+TEST( interpolation, non_uniform_interpolation_test )
+{
+    nonUniformInterpolationTest();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -9,6 +9,8 @@
  * SPDX-License-Identifier: BSD-3-Clause                                    *
  ****************************************************************************/
 
+#include <Cabana_ParameterPack.hpp>
+
 #include <Cajita_Array.hpp>
 #include <Cajita_GlobalGrid.hpp>
 #include <Cajita_GlobalMesh.hpp>
@@ -22,6 +24,8 @@
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
 using namespace Cajita;
 
 namespace Test
@@ -271,6 +275,215 @@ void parallelLocalGridTest()
     EXPECT_EQ( sum_tag, 2.0 * ghosted_space.size() );
 }
 
+//---------------------------------------------------------------------------//
+void parallelOverlapTest()
+{
+    // Let MPI compute the partitioning for this test.
+    DimBlockPartitioner<3> partitioner;
+
+    // Create the global mesh.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 39, 42, 55 };
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Create the global grid.
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create an array on the nodes.
+    int halo_width = 2;
+    auto node_layout = createArrayLayout( global_grid, halo_width, 1, Node() );
+    auto local_grid = node_layout->localGrid();
+    auto array = createArray<double, TEST_DEVICE>( "overlap", node_layout );
+    auto array_view = array->view();
+
+    // Visit the owned nodes in two phases. Every owned node should be
+    // visited exactly once and the callback should run once.
+    int num_callback = 0;
+    grid_parallel_for(
+        "overlap", TEST_EXECSPACE(), *local_grid, Own(), Node(), 1,
+        [&]() { ++num_callback; },
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            array_view( i, j, k, 0 ) += 1.0;
+        } );
+    EXPECT_EQ( num_callback, 1 );
+
+    auto host_view =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), array_view );
+    auto owned_space = local_grid->indexSpace( Own(), Node(), Local() );
+    auto ghosted_space = local_grid->indexSpace( Ghost(), Node(), Local() );
+    for ( long i = 0; i < ghosted_space.extent( Dim::I ); ++i )
+        for ( long j = 0; j < ghosted_space.extent( Dim::J ); ++j )
+            for ( long k = 0; k < ghosted_space.extent( Dim::K ); ++k )
+            {
+                long ijk[3] = { i, j, k };
+                double expected = owned_space.inRange( ijk ) ? 1.0 : 0.0;
+                EXPECT_DOUBLE_EQ( host_view( i, j, k, 0 ), expected );
+            }
+}
+
+//---------------------------------------------------------------------------//
+void parallelTiledTest()
+{
+    // Let MPI compute the partitioning for this test.
+    DimBlockPartitioner<3> partitioner;
+
+    // Create the global mesh.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 39, 42, 55 };
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Create the global grid.
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a cell and a node array.
+    int halo_width = 1;
+    auto cell_layout = createArrayLayout( global_grid, halo_width, 1, Cell() );
+    auto node_layout = createArrayLayout( global_grid, halo_width, 1, Node() );
+    auto local_grid = cell_layout->localGrid();
+    auto cell_view =
+        createArray<double, TEST_DEVICE>( "cell", cell_layout )->view();
+    auto node_view =
+        createArray<double, TEST_DEVICE>( "node", node_layout )->view();
+
+    // Fill the owned cells and nodes with a different tiling for each.
+    GridTiling<3> tiling( { 2, 3, 5 } );
+    tiling.setTile( Node(), { 4, 4, 4 } );
+    EXPECT_EQ( tiling.tile( Cell() )[Dim::K], 5 );
+    EXPECT_EQ( tiling.tile( Node() )[Dim::K], 4 );
+    grid_parallel_for(
+        "tiled_cell", TEST_EXECSPACE(), *local_grid, Own(), Cell(), tiling,
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            cell_view( i, j, k, 0 ) = 1.0;
+        } );
+
+    // Two functors updating the same node array in one fused kernel are
+    // applied in order.
+    grid_parallel_for(
+        "tiled_node", TEST_EXECSPACE(), *local_grid, Own(), Node(), tiling,
+        Cabana::makeParameterPack(
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                node_view( i, j, k, 0 ) = 1.0;
+            },
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                node_view( i, j, k, 0 ) *= 3.0;
+            } ) );
+
+    auto cell_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), cell_view );
+    auto owned_cells = local_grid->indexSpace( Own(), Cell(), Local() );
+    auto ghosted_cells = local_grid->indexSpace( Ghost(), Cell(), Local() );
+    for ( long i = 0; i < ghosted_cells.extent( Dim::I ); ++i )
+        for ( long j = 0; j < ghosted_cells.extent( Dim::J ); ++j )
+            for ( long k = 0; k < ghosted_cells.extent( Dim::K ); ++k )
+            {
+                long ijk[3] = { i, j, k };
+                double expected = owned_cells.inRange( ijk ) ? 1.0 : 0.0;
+                EXPECT_DOUBLE_EQ( cell_host( i, j, k, 0 ), expected );
+            }
+
+    auto node_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), node_view );
+    auto owned_nodes = local_grid->indexSpace( Own(), Node(), Local() );
+    auto ghosted_nodes = local_grid->indexSpace( Ghost(), Node(), Local() );
+    for ( long i = 0; i < ghosted_nodes.extent( Dim::I ); ++i )
+        for ( long j = 0; j < ghosted_nodes.extent( Dim::J ); ++j )
+            for ( long k = 0; k < ghosted_nodes.extent( Dim::K ); ++k )
+            {
+                long ijk[3] = { i, j, k };
+                double expected = owned_nodes.inRange( ijk ) ? 3.0 : 0.0;
+                EXPECT_DOUBLE_EQ( node_host( i, j, k, 0 ), expected );
+            }
+}
+
+//---------------------------------------------------------------------------//
+void parallelTemporalBlockTest()
+{
+    // Let MPI compute the partitioning for this test.
+    DimBlockPartitioner<3> partitioner;
+
+    // Create the global mesh.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 27, 22, 31 };
+    std::array<bool, 3> is_dim_periodic = { true, true, true };
+    std::array<double, 3> global_low_corner = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = createUniformGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Create the global grid.
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a cell array with one component for each sweep state.
+    int halo_width = 2;
+    int num_step = 2;
+    auto layout =
+        createArrayLayout( global_grid, halo_width, num_step + 1, Cell() );
+    auto local_grid = layout->localGrid();
+    auto array = createArray<double, TEST_DEVICE>( "temporal", layout );
+    auto view = array->view();
+
+    // Initialize the ghosted cells with a linear field. The average of the
+    // face neighbors of a linear field reproduces the field so only stale
+    // or unset inputs change the result.
+    grid_parallel_for(
+        "init", TEST_EXECSPACE(), *local_grid, Ghost(), Cell(),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            view( i, j, k, 0 ) = i + 2.0 * j + 4.0 * k;
+        } );
+
+    // Apply two dependent sweeps per tile.
+    grid_temporal_block_for(
+        "temporal", TEST_EXECSPACE(), *local_grid, Cell(), { 4, 3, 5 }, 1,
+        num_step,
+        KOKKOS_LAMBDA( const int s, const int i, const int j, const int k ) {
+            view( i, j, k, s + 1 ) =
+                ( view( i - 1, j, k, s ) + view( i + 1, j, k, s ) +
+                  view( i, j - 1, k, s ) + view( i, j + 1, k, s ) +
+                  view( i, j, k - 1, s ) + view( i, j, k + 1, s ) ) /
+                6.0;
+        } );
+
+    auto host_view =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), view );
+    auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+    for ( long i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( long j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( long k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_DOUBLE_EQ( host_view( i, j, k, num_step ),
+                                  i + 2.0 * j + 4.0 * k );
+
+    // The sweeps may not depend on entities beyond the halo.
+    EXPECT_THROW( grid_temporal_block_for(
+                      "temporal", TEST_EXECSPACE(), *local_grid, Cell(),
+                      { 4, 3, 5 }, 1, num_step + 1,
+                      KOKKOS_LAMBDA( const int, const int, const int,
+                                     const int ){} ),
+                  std::logic_error );
+}
+
 //---------------------------------------------------------------------------//
 void parallelMultiSpaceTest()
 {
@@ -405,6 +618,18 @@ TEST( TEST_CATEGORY, parallel_local_grid_test ) { parallelLocalGridTest(); }
 
 TEST( TEST_CATEGORY, parallel_multispace_test ) { parallelMultiSpaceTest(); }
 
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, parallel_overlap_test ) { parallelOverlapTest(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, parallel_tiled_test ) { parallelTiledTest(); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, parallel_temporal_block_test )
+{
+    parallelTemporalBlockTest();
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Test
@@ -0,0 +1,183 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cabana_AoSoA.hpp>
+#include <Cabana_DeepCopy.hpp>
+
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_LocalMesh.hpp>
+#include <Cajita_ParticleGridHalo.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace Test
+{
+
+using Cajita::Dim;
+
+//---------------------------------------------------------------------------//
+void haloTest( const bool periodic, const int halo_width )
+{
+    // Let MPI compute the partitioning for this test.
+    int comm_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &comm_size );
+    std::array<int, 3> ranks_per_dim = { 0, 0, 0 };
+    MPI_Dims_create( comm_size, 3, ranks_per_dim.data() );
+    Cajita::ManualBlockPartitioner<3> partitioner( ranks_per_dim );
+
+    // Create the global grid.
+    double cell_size = 0.23;
+    std::array<int, 3> global_num_cell = { 18, 15, 9 };
+    std::array<double, 3> global_low = { 1.2, 3.3, -2.8 };
+    std::array<double, 3> global_high = {
+        global_low[0] + cell_size * global_num_cell[0],
+        global_low[1] + cell_size * global_num_cell[1],
+        global_low[2] + cell_size * global_num_cell[2] };
+    auto global_mesh = Cajita::createUniformGlobalMesh(
+        global_low, global_high, global_num_cell );
+    std::array<bool, 3> is_periodic = { periodic, periodic, periodic };
+    auto global_grid = Cajita::createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                                 is_periodic, partitioner );
+    auto block = Cajita::createLocalGrid( global_grid, halo_width );
+    auto local_mesh = Cajita::createLocalMesh<Kokkos::HostSpace>( *block );
+
+    // Put a particle in the center of every owned cell.
+    auto owned_cell_space =
+        block->indexSpace( Cajita::Own(), Cajita::Cell(), Cajita::Local() );
+    int num_particle = owned_cell_space.size();
+    using MemberTypes = Cabana::MemberTypes<double[3], int>;
+    using ParticleContainer = Cabana::AoSoA<MemberTypes, Kokkos::HostSpace>;
+    ParticleContainer particles( "particles", num_particle );
+    auto coords = Cabana::slice<0>( particles, "coords" );
+    auto ranks = Cabana::slice<1>( particles, "ranks" );
+    std::array<double, 3> local_low;
+    std::array<int, 3> num_own;
+    for ( int d = 0; d < 3; ++d )
+    {
+        local_low[d] = local_mesh.lowCorner( Cajita::Own(), d );
+        num_own[d] = owned_cell_space.extent( d );
+    }
+    int pid = 0;
+    for ( int i = 0; i < num_own[Dim::I]; ++i )
+        for ( int j = 0; j < num_own[Dim::J]; ++j )
+            for ( int k = 0; k < num_own[Dim::K]; ++k, ++pid )
+            {
+                coords( pid, Dim::I ) =
+                    local_low[Dim::I] + ( i + 0.5 ) * cell_size;
+                coords( pid, Dim::J ) =
+                    local_low[Dim::J] + ( j + 0.5 ) * cell_size;
+                coords( pid, Dim::K ) =
+                    local_low[Dim::K] + ( k + 0.5 ) * cell_size;
+                ranks( pid ) = global_grid->blockId();
+            }
+
+    // Build the halo on the device.
+    auto particles_mirror =
+        Cabana::create_mirror_view_and_copy( TEST_DEVICE(), particles );
+    auto coords_mirror = Cabana::slice<0>( particles_mirror, "coords" );
+    auto halo =
+        Cajita::createParticleGridHalo( *block, coords_mirror, halo_width );
+    EXPECT_EQ( halo.numLocal(), static_cast<std::size_t>( num_particle ) );
+
+    // Gather the ghosts.
+    particles_mirror.resize( halo.numLocal() + halo.numGhost() );
+    coords_mirror = Cabana::slice<0>( particles_mirror, "coords" );
+    Cajita::particleGridGather( halo, particles_mirror, coords_mirror );
+    particles = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                     particles_mirror );
+    coords = Cabana::slice<0>( particles, "coords" );
+    ranks = Cabana::slice<1>( particles, "ranks" );
+
+    // Every ghost should be at the center of a unique cell in the halo shell
+    // around the local domain. In the non-periodic case only shell cells
+    // within the global domain get a ghost.
+    std::array<int, 3> num_ghosted;
+    for ( int d = 0; d < 3; ++d )
+        num_ghosted[d] = num_own[d] + 2 * halo_width;
+    std::vector<int> hits( num_ghosted[0] * num_ghosted[1] * num_ghosted[2],
+                           0 );
+    for ( std::size_t g = halo.numLocal(); g < coords.size(); ++g )
+    {
+        int ijk[3];
+        for ( int d = 0; d < 3; ++d )
+        {
+            double x = coords( g, d ) - local_low[d] + halo_width * cell_size;
+            ijk[d] = std::floor( x / cell_size );
+            EXPECT_GE( ijk[d], 0 );
+            EXPECT_LT( ijk[d], num_ghosted[d] );
+            EXPECT_NEAR( x, ( ijk[d] + 0.5 ) * cell_size, 1.0e-10 );
+        }
+        bool owned = true;
+        for ( int d = 0; d < 3; ++d )
+            owned = owned && ijk[d] >= halo_width &&
+                    ijk[d] < num_own[d] + halo_width;
+        EXPECT_FALSE( owned );
+        EXPECT_GE( ranks( g ), 0 );
+        EXPECT_LT( ranks( g ), comm_size );
+        if ( !owned )
+            ++hits[ijk[0] +
+                   num_ghosted[0] * ( ijk[1] + num_ghosted[1] * ijk[2] )];
+    }
+    for ( int i = 0; i < num_ghosted[0]; ++i )
+        for ( int j = 0; j < num_ghosted[1]; ++j )
+            for ( int k = 0; k < num_ghosted[2]; ++k )
+            {
+                bool owned = i >= halo_width && i < num_own[0] + halo_width &&
+                             j >= halo_width && j < num_own[1] + halo_width &&
+                             k >= halo_width && k < num_own[2] + halo_width;
+                if ( owned )
+                    continue;
+                bool in_domain = true;
+                int ijk[3] = { i, j, k };
+                for ( int d = 0; d < 3; ++d )
+                {
+                    double x = local_low[d] +
+                               ( ijk[d] - halo_width + 0.5 ) * cell_size;
+                    in_domain = in_domain && x > global_low[d] &&
+                                x < global_high[d];
+                }
+                int expected = ( periodic || in_domain ) ? 1 : 0;
+                int c = i + num_ghosted[0] * ( j + num_ghosted[1] * k );
+                EXPECT_EQ( hits[c], expected );
+            }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, not_periodic_test )
+{
+    for ( int w = 1; w < 3; ++w )
+        haloTest( false, w );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, periodic_test )
+{
+    for ( int w = 1; w < 3; ++w )
+        haloTest( true, w );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,330 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Array.hpp>
+#include <Cajita_GeometricMultigrid.hpp>
+#include <Cajita_GlobalGrid.hpp>
+#include <Cajita_GlobalMesh.hpp>
+#include <Cajita_IndexSpace.hpp>
+#include <Cajita_LocalGrid.hpp>
+#include <Cajita_MixedPrecisionRefinement.hpp>
+#include <Cajita_Partitioner.hpp>
+#include <Cajita_ReferenceStructuredSolver.hpp>
+#include <Cajita_Types.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace Cajita;
+
+namespace Test
+{
+
+//---------------------------------------------------------------------------//
+// Laplacian applied by a user functor.
+struct LaplacianFunctor
+{
+    template <class VectorType>
+    KOKKOS_INLINE_FUNCTION double operator()( const VectorType& v, const int i,
+                                              const int j, const int k ) const
+    {
+        return 6.0 * v( i, j, k ) - v( i - 1, j, k ) - v( i + 1, j, k ) -
+               v( i, j - 1, k ) - v( i, j + 1, k ) - v( i, j, k - 1 ) -
+               v( i, j, k + 1 );
+    }
+};
+
+//---------------------------------------------------------------------------//
+// 7-point 3d Laplacian stencil and its coefficients.
+std::vector<std::array<int, 3>> laplacianStencil()
+{
+    return { { 0, 0, 0 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 },
+             { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+}
+
+std::vector<double> laplacianCoefficients()
+{
+    return { 6.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0 };
+}
+
+//---------------------------------------------------------------------------//
+// Check the statistics of a converged solve.
+template <class Solver>
+void checkConverged( Solver& solver )
+{
+    EXPECT_GT( solver.getNumIter(), 0 );
+    EXPECT_LE( solver.getFinalRelativeResidualNorm(), 1.0e-11 );
+}
+
+//---------------------------------------------------------------------------//
+// Solve a 3d Poisson problem with the reference solver. The given function
+// solves the problem again as solve(solver,b,x) after the default solve.
+template <class SolveFunction>
+void poissonTest( const SolveFunction& solve_function )
+{
+    // Create the global grid.
+    double cell_size = 0.25;
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    std::array<double, 3> global_low_corner = { -1.0, -2.0, -1.0 };
+    std::array<double, 3> global_high_corner = { 1.0, 1.0, 0.5 };
+    auto global_mesh = createUniformGlobalMesh( global_low_corner,
+                                                global_high_corner, cell_size );
+
+    // Create the global grid.
+    DimBlockPartitioner<3> partitioner;
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+
+    // Create a local grid.
+    auto local_mesh = createLocalGrid( global_grid, 1 );
+    auto owned_space = local_mesh->indexSpace( Own(), Cell(), Local() );
+
+    // Create the RHS.
+    auto vector_layout = createArrayLayout( local_mesh, 1, Cell() );
+    auto rhs = createArray<double, TEST_DEVICE>( "rhs", vector_layout );
+    ArrayOp::assign( *rhs, 1.0, Own() );
+
+    // Create the solver with a 7-point 3d laplacian stencil.
+    auto solver =
+        createReferenceConjugateGradient<double, TEST_DEVICE>( *vector_layout );
+    solver->setMatrixStencil( laplacianStencil() );
+    const auto& matrix_entries = solver->getMatrixValues();
+    auto matrix_view = matrix_entries.view();
+    auto global_space = local_mesh->indexSpace( Own(), Cell(), Global() );
+    int ncell_i = global_grid->globalNumEntity( Cell(), Dim::I );
+    int ncell_j = global_grid->globalNumEntity( Cell(), Dim::J );
+    int ncell_k = global_grid->globalNumEntity( Cell(), Dim::K );
+    Kokkos::parallel_for(
+        "fill_matrix_entries",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            int gi = i + global_space.min( Dim::I ) - owned_space.min( Dim::I );
+            int gj = j + global_space.min( Dim::J ) - owned_space.min( Dim::J );
+            int gk = k + global_space.min( Dim::K ) - owned_space.min( Dim::K );
+            matrix_view( i, j, k, 0 ) = 6.0;
+            matrix_view( i, j, k, 1 ) = ( gi - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 2 ) = ( gi + 1 < ncell_i ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 3 ) = ( gj - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 4 ) = ( gj + 1 < ncell_j ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 5 ) = ( gk - 1 >= 0 ) ? -1.0 : 0.0;
+            matrix_view( i, j, k, 6 ) = ( gk + 1 < ncell_k ) ? -1.0 : 0.0;
+        } );
+
+    // Create a diagonal preconditioner.
+    std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+    solver->setPreconditionerStencil( diag_stencil );
+    const auto& preconditioner_entries = solver->getPreconditionerValues();
+    auto preconditioner_view = preconditioner_entries.view();
+    Kokkos::parallel_for(
+        "fill_preconditioner_entries",
+        createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            preconditioner_view( i, j, k, 0 ) = 1.0 / 6.0;
+        } );
+
+    solver->setTolerance( 1.0e-11 );
+    solver->setPrintLevel( 1 );
+    solver->setup();
+
+    // Compute a reference solution with the default solver.
+    auto lhs_ref = createArray<double, TEST_DEVICE>( "lhs_ref", vector_layout );
+    ArrayOp::assign( *lhs_ref, 0.0, Own() );
+    solver->solve( *rhs, *lhs_ref );
+
+    // Solve again with the test solve.
+    auto lhs = createArray<double, TEST_DEVICE>( "lhs", vector_layout );
+    ArrayOp::assign( *lhs, 0.0, Own() );
+    solve_function( *solver, *rhs, *lhs );
+
+    // Check the results.
+    auto lhs_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), lhs->view() );
+    auto lhs_ref_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), lhs_ref->view() );
+    for ( int i = owned_space.min( Dim::I ); i < owned_space.max( Dim::I );
+          ++i )
+        for ( int j = owned_space.min( Dim::J ); j < owned_space.max( Dim::J );
+              ++j )
+            for ( int k = owned_space.min( Dim::K );
+                  k < owned_space.max( Dim::K ); ++k )
+                EXPECT_NEAR( lhs_host( i, j, k, 0 ),
+                             lhs_ref_host( i, j, k, 0 ), 1.0e-8 );
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, pipelined_cg_test )
+{
+    poissonTest( []( auto& solver, const auto& b, auto& x ) {
+        solver.setPipelined( true );
+        solver.solve( b, x );
+        checkConverged( solver );
+    } );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, matrix_free_cg_test )
+{
+    poissonTest( []( auto& solver, const auto& b, auto& x ) {
+        auto A = createConstantStencilOperator<double, TEST_DEVICE>(
+            laplacianStencil(), laplacianCoefficients() );
+        std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+        std::vector<double> diag_coefficients = { 1.0 / 6.0 };
+        auto M = createConstantStencilOperator<double, TEST_DEVICE>(
+            diag_stencil, diag_coefficients );
+        solver.solve( A, M, b, x );
+        checkConverged( solver );
+    } );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, matrix_free_pipelined_cg_test )
+{
+    poissonTest( []( auto& solver, const auto& b, auto& x ) {
+        auto A = createMatrixFreeOperator( LaplacianFunctor{}, 1 );
+        std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+        std::vector<double> diag_coefficients = { 1.0 / 6.0 };
+        auto M = createConstantStencilOperator<double, TEST_DEVICE>(
+            diag_stencil, diag_coefficients );
+        solver.setPipelined( true );
+        solver.solve( A, M, b, x );
+        checkConverged( solver );
+    } );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, multigrid_cg_test )
+{
+    poissonTest( []( auto& solver, const auto& b, auto& x ) {
+        auto multigrid = createGeometricMultigrid<double, TEST_DEVICE>(
+            *b.layout(), laplacianStencil(), laplacianCoefficients() );
+        solver.setPreconditioner( multigrid );
+        solver.setup();
+        EXPECT_GT( multigrid->numLevels(), 1 );
+        solver.solve( b, x );
+        checkConverged( solver );
+    } );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, mixed_precision_cg_test )
+{
+    poissonTest( []( auto& solver, const auto& b, auto& x ) {
+        // Solve with float inner solves using the same matrix and
+        // preconditioner.
+        auto refinement =
+            createMixedPrecisionRefinement<double, float, TEST_DEVICE>(
+                *b.layout() );
+        refinement->setMatrixStencil( laplacianStencil() );
+        Kokkos::deep_copy( refinement->getMatrixValues().view(),
+                           solver.getMatrixValues().view() );
+        std::vector<std::array<int, 3>> diag_stencil = { { 0, 0, 0 } };
+        refinement->setPreconditionerStencil( diag_stencil );
+        Kokkos::deep_copy( refinement->getPreconditionerValues().view(),
+                           solver.getPreconditionerValues().view() );
+        refinement->setTolerance( 1.0e-11 );
+        refinement->setup();
+        refinement->solve( b, x );
+        checkConverged( *refinement );
+        EXPECT_GT( refinement->getNumIter(), 1 );
+    } );
+}
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, multiple_rhs_cg_test )
+{
+    poissonTest( []( auto& solver, const auto& b, auto& x ) {
+        using array_type = std::remove_reference_t<decltype( x )>;
+
+        // Create a point source. It converges at a different iteration than
+        // the uniform RHS so the first system to converge is frozen while
+        // the other continues.
+        auto local_grid = b.layout()->localGrid();
+        auto owned_space = local_grid->indexSpace( Own(), Cell(), Local() );
+        auto global_space = local_grid->indexSpace( Own(), Cell(), Global() );
+        auto point = createArray<double, TEST_DEVICE>( "point", b.layout() );
+        auto point_view = point->view();
+        Kokkos::parallel_for(
+            "fill_point_source",
+            createExecutionPolicy( owned_space, TEST_EXECSPACE() ),
+            KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+                int gi =
+                    i + global_space.min( Dim::I ) - owned_space.min( Dim::I );
+                int gj =
+                    j + global_space.min( Dim::J ) - owned_space.min( Dim::J );
+                int gk =
+                    k + global_space.min( Dim::K ) - owned_space.min( Dim::K );
+                point_view( i, j, k, 0 ) =
+                    ( 2 == gi && 3 == gj && 1 == gk ) ? 1.0 : 0.0;
+            } );
+
+        // Solve each system on its own.
+        std::array<std::shared_ptr<array_type>, 2> rhs_single = {
+            createArray<double, TEST_DEVICE>( "b", b.layout() ), point };
+        Kokkos::deep_copy( rhs_single[0]->view(), b.view() );
+        std::array<std::shared_ptr<array_type>, 2> lhs_single;
+        std::array<int, 2> num_iter;
+        for ( int n = 0; n < 2; ++n )
+        {
+            lhs_single[n] =
+                createArray<double, TEST_DEVICE>( "lhs_single", b.layout() );
+            ArrayOp::assign( *lhs_single[n], 0.0, Own() );
+            solver.solve( *rhs_single[n], *lhs_single[n] );
+            num_iter[n] = solver.getNumIter();
+        }
+        EXPECT_NE( num_iter[0], num_iter[1] );
+
+        // Solve both systems together.
+        auto layout = createArrayLayout( local_grid, 2, Cell() );
+        auto rhs = createArray<double, TEST_DEVICE>( "rhs", layout );
+        auto lhs = createArray<double, TEST_DEVICE>( "lhs", layout );
+        for ( int n = 0; n < 2; ++n )
+            Kokkos::deep_copy( createSubarray( *rhs, n, n + 1 )->view(),
+                               rhs_single[n]->view() );
+        ArrayOp::assign( *lhs, 0.0, Own() );
+        solver.solveMultiple( *rhs, *lhs );
+        checkConverged( solver );
+        EXPECT_GE( solver.getNumIter(),
+                   std::max( num_iter[0], num_iter[1] ) - 1 );
+
+        // Each solution matches the solution of its own system.
+        auto lhs_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), lhs->view() );
+        for ( int n = 0; n < 2; ++n )
+        {
+            auto lhs_single_host = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), lhs_single[n]->view() );
+            for ( int i = owned_space.min( Dim::I );
+                  i < owned_space.max( Dim::I ); ++i )
+                for ( int j = owned_space.min( Dim::J );
+                      j < owned_space.max( Dim::J ); ++j )
+                    for ( int k = owned_space.min( Dim::K );
+                          k < owned_space.max( Dim::K ); ++k )
+                        EXPECT_NEAR( lhs_host( i, j, k, n ),
+                                     lhs_single_host( i, j, k, 0 ), 1.0e-8 );
+        }
+
+        // Check the first solution against the reference.
+        Kokkos::deep_copy( x.view(), createSubarray( *lhs, 0, 1 )->view() );
+    } );
+}
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,257 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Halo.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_SparseDimPartitioner.hpp>
+#include <Cajita_SparseHalo.hpp>
+#include <Cajita_SparseLocalGrid.hpp>
+
+#include <Cabana_DeepCopy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace Cajita;
+using namespace Cajita::Experimental;
+
+namespace Test
+{
+
+//---------------------------------------------------------------------------//
+// Exchange the tiles of a uniformly partitioned sparse grid. In the gather
+// test only the owned tiles with an even tile index sum are allocated so
+// ghosted tiles with an odd sum are not exchanged. In the scatter test all
+// owned and ghosted tiles are allocated.
+void haloTest( const bool test_gather )
+{
+    constexpr int size_tile_per_dim = 8;
+    constexpr int cell_per_tile_dim = 4;
+    constexpr int cell_per_tile =
+        cell_per_tile_dim * cell_per_tile_dim * cell_per_tile_dim;
+    constexpr int size_per_dim = size_tile_per_dim * cell_per_tile_dim;
+
+    using T = float;
+
+    // Create the global mesh.
+    T cell_size = 0.1f;
+    std::array<int, 3> global_num_cell(
+        { size_per_dim, size_per_dim, size_per_dim } );
+    std::array<T, 3> global_low_corner = { -0.4f, 1.1f, 0.0f };
+    std::array<T, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    auto global_mesh = createSparseGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Uniformly partition the tiles.
+    int workload_num = size_per_dim * size_per_dim * size_per_dim;
+    SparseDimPartitioner<TEST_DEVICE, cell_per_tile_dim> partitioner(
+        MPI_COMM_WORLD, 1.5, workload_num, 200, global_num_cell, 10 );
+    auto ranks_per_dim =
+        partitioner.ranksPerDimension( MPI_COMM_WORLD, global_num_cell );
+    std::array<std::vector<int>, 3> rec_partitions;
+    for ( int d = 0; d < 3; ++d )
+        for ( int r = 0; r <= ranks_per_dim[d]; ++r )
+            rec_partitions[d].push_back( r * size_tile_per_dim /
+                                         ranks_per_dim[d] );
+    partitioner.initializeRecPartition( rec_partitions[0], rec_partitions[1],
+                                        rec_partitions[2] );
+
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    int halo_width = cell_per_tile_dim;
+    auto local_grid =
+        createSparseLocalGrid( global_grid, halo_width, cell_per_tile_dim );
+
+    // Owned tiles and owned tiles extended by the one tile halo.
+    Kokkos::Array<int, 3> own_min;
+    Kokkos::Array<int, 3> own_max;
+    Kokkos::Array<int, 3> ghost_min;
+    Kokkos::Array<int, 3> ghost_max;
+    for ( int d = 0; d < 3; ++d )
+    {
+        own_min[d] = global_grid->globalOffset( d ) / cell_per_tile_dim;
+        own_max[d] =
+            own_min[d] + global_grid->ownedNumCell( d ) / cell_per_tile_dim;
+        ghost_min[d] = std::max( own_min[d] - 1, 0 );
+        ghost_max[d] = std::min( own_max[d] + 1, size_tile_per_dim );
+    }
+
+    // Allocate the tiles.
+    auto sparse_map =
+        createSparseMap<TEST_EXECSPACE>( global_mesh, size_per_dim );
+    Kokkos::parallel_for(
+        "allocate_tiles",
+        Kokkos::MDRangePolicy<TEST_EXECSPACE, Kokkos::Rank<3>>( ghost_min,
+                                                               ghost_max ),
+        KOKKOS_LAMBDA( const int ti, const int tj, const int tk ) {
+            bool owned = ti >= own_min[0] && ti < own_max[0] &&
+                         tj >= own_min[1] && tj < own_max[1] &&
+                         tk >= own_min[2] && tk < own_max[2];
+            bool even = ( 0 == ( ti + tj + tk ) % 2 );
+            if ( !test_gather || !owned || even )
+                sparse_map.insertCell( ti * cell_per_tile_dim,
+                                       tj * cell_per_tile_dim,
+                                       tk * cell_per_tile_dim );
+        } );
+    using DataTypes = Cabana::MemberTypes<double, int[3]>;
+    auto layout =
+        createSparseArrayLayout<DataTypes>( local_grid, sparse_map, Cell() );
+    auto array =
+        createSparseArray<TEST_DEVICE>( std::string( "halo" ), layout );
+    auto& map = array.layout().sparseMap();
+    array.resize( map.sizeCell() );
+
+    // Assign cell data. Gather: owned cells get a function of their global
+    // index and ghosted cells are invalid. Scatter: every cell counts one.
+    Kokkos::View<int* [3], TEST_DEVICE> tile_ijk( "tile_ijk",
+                                                  map.sizeTile() );
+    Kokkos::View<double*, TEST_DEVICE> expected( "expected", array.size() );
+    Kokkos::parallel_for(
+        "assign_cells",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, map.capacity() ),
+        KOKKOS_LAMBDA( const int index ) {
+            if ( map.valid_at( index ) )
+            {
+                auto tid = map.value_at( index );
+                auto tkey = map.key_at( index );
+                int ti, tj, tk;
+                map.key2ijk( tkey, ti, tj, tk );
+                tile_ijk( tid, 0 ) = ti;
+                tile_ijk( tid, 1 ) = tj;
+                tile_ijk( tid, 2 ) = tk;
+                bool owned = ti >= own_min[0] && ti < own_max[0] &&
+                             tj >= own_min[1] && tj < own_max[1] &&
+                             tk >= own_min[2] && tk < own_max[2];
+                bool even = ( 0 == ( ti + tj + tk ) % 2 );
+                for ( int ci = 0; ci < cell_per_tile_dim; ci++ )
+                    for ( int cj = 0; cj < cell_per_tile_dim; cj++ )
+                        for ( int ck = 0; ck < cell_per_tile_dim; ck++ )
+                        {
+                            int cid = map.cell_local_id( ci, cj, ck );
+                            int cell[3] = { ti * cell_per_tile_dim + ci,
+                                            tj * cell_per_tile_dim + cj,
+                                            tk * cell_per_tile_dim + ck };
+                            double f = cell[0] + 100.0 * cell[1] +
+                                       10000.0 * cell[2];
+                            if ( test_gather )
+                            {
+                                array.template get<0>( tid, cid ) =
+                                    owned ? f : -1.0;
+                                for ( int d = 0; d < 3; ++d )
+                                    array.template get<1>( tid, cid, d ) =
+                                        owned ? cell[d] : -1;
+                                expected( tid * cell_per_tile + cid ) =
+                                    ( owned || even ) ? f : -1.0;
+                            }
+                            else
+                            {
+                                array.template get<0>( tid, cid ) = 1.0;
+                                for ( int d = 0; d < 3; ++d )
+                                    array.template get<1>( tid, cid, d ) =
+                                        d + 1;
+                            }
+                        }
+            }
+        } );
+
+    // Exchange.
+    auto halo =
+        createSparseHalo( NodeHaloPattern<3>(), halo_width, local_grid, array );
+    if ( test_gather )
+        halo->gather( TEST_EXECSPACE(), array );
+    else
+        halo->scatter( TEST_EXECSPACE(), ScatterReduce::Sum(), array );
+
+    // Check the results.
+    auto array_host = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                           array.aosoa() );
+    auto scalar_host = Cabana::slice<0>( array_host );
+    auto vector_host = Cabana::slice<1>( array_host );
+    auto tile_ijk_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), tile_ijk );
+    auto expected_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), expected );
+    for ( std::size_t tid = 0; tid < tile_ijk_host.extent( 0 ); ++tid )
+    {
+        int tile[3] = { tile_ijk_host( tid, 0 ), tile_ijk_host( tid, 1 ),
+                        tile_ijk_host( tid, 2 ) };
+        bool owned = true;
+        for ( int d = 0; d < 3; ++d )
+            owned = owned && tile[d] >= own_min[d] && tile[d] < own_max[d];
+
+        // In a scatter every rank whose extended block contains an owned
+        // tile contributes one to it.
+        int num_contrib = 1;
+        if ( !test_gather && owned )
+        {
+            num_contrib = 0;
+            for ( int bi = 0; bi < ranks_per_dim[0]; ++bi )
+                for ( int bj = 0; bj < ranks_per_dim[1]; ++bj )
+                    for ( int bk = 0; bk < ranks_per_dim[2]; ++bk )
+                    {
+                        int b[3] = { bi, bj, bk };
+                        bool in_block = true;
+                        for ( int d = 0; d < 3; ++d )
+                            in_block =
+                                in_block &&
+                                tile[d] >= rec_partitions[d][b[d]] - 1 &&
+                                tile[d] < rec_partitions[d][b[d] + 1] + 1;
+                        if ( in_block )
+                            ++num_contrib;
+                    }
+        }
+
+        for ( int cid = 0; cid < cell_per_tile; ++cid )
+        {
+            int n = tid * cell_per_tile + cid;
+            if ( test_gather )
+            {
+                EXPECT_DOUBLE_EQ( scalar_host( n ), expected_host( n ) );
+                for ( int d = 0; d < 3; ++d )
+                {
+                    if ( expected_host( n ) < 0.0 )
+                        EXPECT_EQ( vector_host( n, d ), -1 );
+                    else
+                        EXPECT_GE( vector_host( n, d ), 0 );
+                }
+            }
+            else
+            {
+                EXPECT_DOUBLE_EQ( scalar_host( n ), num_contrib );
+                for ( int d = 0; d < 3; ++d )
+                    EXPECT_EQ( vector_host( n, d ), num_contrib * ( d + 1 ) );
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sparse_halo_gather_test ) { haloTest( true ); }
+
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sparse_halo_scatter_test ) { haloTest( false ); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
@@ -0,0 +1,205 @@
+/****************************************************************************
+ * Copyright (c) 2018-2022 by the Cabana authors                            *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the Cabana library. Cabana is distributed under a   *
+ * BSD 3-clause license. For the licensing terms see the LICENSE file in    *
+ * the top-level directory.                                                 *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <Cajita_Interpolation.hpp>
+#include <Cajita_SparseArray.hpp>
+#include <Cajita_SparseDimPartitioner.hpp>
+#include <Cajita_SparseInterpolation.hpp>
+#include <Cajita_SparseLocalGrid.hpp>
+#include <Cajita_Splines.hpp>
+
+#include <Cabana_DeepCopy.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+using namespace Cajita;
+using namespace Cajita::Experimental;
+
+namespace Test
+{
+
+//---------------------------------------------------------------------------//
+void sparseInterpolationTest()
+{
+    constexpr int size_tile_per_dim = 8;
+    constexpr int cell_per_tile_dim = 4;
+    constexpr int size_per_dim = size_tile_per_dim * cell_per_tile_dim;
+
+    using T = float;
+
+    // Create the global mesh.
+    T cell_size = 0.1f;
+    std::array<int, 3> global_num_cell(
+        { size_per_dim, size_per_dim, size_per_dim } );
+    std::array<T, 3> global_low_corner = { 0.3f, -1.2f, 2.0f };
+    std::array<T, 3> global_high_corner = {
+        global_low_corner[0] + cell_size * global_num_cell[0],
+        global_low_corner[1] + cell_size * global_num_cell[1],
+        global_low_corner[2] + cell_size * global_num_cell[2] };
+    std::array<bool, 3> is_dim_periodic = { false, false, false };
+    auto global_mesh = createSparseGlobalMesh(
+        global_low_corner, global_high_corner, global_num_cell );
+
+    // Uniformly partition the tiles.
+    int workload_num = size_per_dim * size_per_dim * size_per_dim;
+    SparseDimPartitioner<TEST_DEVICE, cell_per_tile_dim> partitioner(
+        MPI_COMM_WORLD, 1.5, workload_num, 200, global_num_cell, 10 );
+    auto ranks_per_dim =
+        partitioner.ranksPerDimension( MPI_COMM_WORLD, global_num_cell );
+    std::array<std::vector<int>, 3> rec_partitions;
+    for ( int d = 0; d < 3; ++d )
+        for ( int r = 0; r <= ranks_per_dim[d]; ++r )
+            rec_partitions[d].push_back( r * size_tile_per_dim /
+                                         ranks_per_dim[d] );
+    partitioner.initializeRecPartition( rec_partitions[0], rec_partitions[1],
+                                        rec_partitions[2] );
+
+    auto global_grid = createGlobalGrid( MPI_COMM_WORLD, global_mesh,
+                                         is_dim_periodic, partitioner );
+    auto local_grid =
+        createSparseLocalGrid( global_grid, 2, cell_per_tile_dim );
+
+    // Put points in the interior of the owned cells.
+    int num_point = 200;
+    Kokkos::View<T* [3], TEST_DEVICE> points( "points", num_point );
+    auto points_host = Kokkos::create_mirror_view( points );
+    for ( int p = 0; p < num_point; ++p )
+        for ( int d = 0; d < 3; ++d )
+        {
+            int num_cell = global_grid->ownedNumCell( d );
+            T offset = std::fmod( 0.731 * ( p + 1 ) * ( d + 1 ), 1.0 );
+            points_host( p, d ) =
+                global_low_corner[d] +
+                ( global_grid->globalOffset( d ) + 1.5 +
+                  offset * ( num_cell - 3 ) ) *
+                    cell_size;
+        }
+    Kokkos::deep_copy( points, points_host );
+
+    // Create a sparse array over the nodes touched by the points.
+    auto sparse_map =
+        createSparseMap<TEST_EXECSPACE>( global_mesh, size_per_dim );
+    using DataTypes = Cabana::MemberTypes<T, T[3]>;
+    auto layout =
+        createSparseArrayLayout<DataTypes>( local_grid, sparse_map, Node() );
+    auto array = createSparseArray<TEST_DEVICE>(
+        std::string( "sparse_interpolation" ), layout );
+    array.registerSparseGrid( points, num_point );
+
+    auto scalar = Cabana::slice<0>( array.aosoa() );
+    auto vector = Cabana::slice<1>( array.aosoa() );
+    Cabana::deep_copy( scalar, 0.0 );
+    Cabana::deep_copy( vector, 0.0 );
+
+    // Interpolate a scalar and a vector point field to the grid.
+    Kokkos::View<T*, TEST_DEVICE> point_scalar( "point_scalar", num_point );
+    Kokkos::View<T* [3], TEST_DEVICE> point_vector( "point_vector",
+                                                    num_point );
+    Kokkos::deep_copy( point_scalar, 3.5 );
+    auto point_vector_host = Kokkos::create_mirror_view( point_vector );
+    for ( int p = 0; p < num_point; ++p )
+        for ( int d = 0; d < 3; ++d )
+            point_vector_host( p, d ) = d + 1.0;
+    Kokkos::deep_copy( point_vector, point_vector_host );
+
+    auto scalar_p2g = createScalarValueP2G( point_scalar, -0.5f );
+    Experimental::p2g<0>( scalar_p2g, points, num_point, Spline<1>(), array );
+    auto vector_p2g = createVectorValueP2G( point_vector, -0.5f );
+    Experimental::p2g<1>( vector_p2g, points, num_point, Spline<1>(), array );
+
+    // The spline weights are a partition of unity so the total grid value is
+    // the total point value.
+    auto array_host = Cabana::create_mirror_view_and_copy( Kokkos::HostSpace(),
+                                                           array.aosoa() );
+    auto scalar_host = Cabana::slice<0>( array_host );
+    auto vector_host = Cabana::slice<1>( array_host );
+    double scalar_sum = 0.0;
+    double vector_sum[3] = { 0.0, 0.0, 0.0 };
+    for ( std::size_t n = 0; n < array_host.size(); ++n )
+    {
+        scalar_sum += scalar_host( n );
+        for ( int d = 0; d < 3; ++d )
+            vector_sum[d] += vector_host( n, d );
+    }
+    EXPECT_NEAR( scalar_sum, -1.75 * num_point, 1.0e-3 * num_point );
+    for ( int d = 0; d < 3; ++d )
+        EXPECT_NEAR( vector_sum[d], -0.5 * ( d + 1 ) * num_point,
+                     1.0e-3 * num_point );
+
+    // Assign a linear scalar field to the registered nodes.
+    auto& map = array.layout().sparseMap();
+    Kokkos::parallel_for(
+        "assign_linear_field",
+        Kokkos::RangePolicy<TEST_EXECSPACE>( 0, map.capacity() ),
+        KOKKOS_LAMBDA( const int index ) {
+            if ( map.valid_at( index ) )
+            {
+                auto tid = map.value_at( index );
+                auto tkey = map.key_at( index );
+                int ti, tj, tk;
+                map.key2ijk( tkey, ti, tj, tk );
+                for ( int ci = 0; ci < cell_per_tile_dim; ci++ )
+                    for ( int cj = 0; cj < cell_per_tile_dim; cj++ )
+                        for ( int ck = 0; ck < cell_per_tile_dim; ck++ )
+                        {
+                            int cid = map.cell_local_id( ci, cj, ck );
+                            array.template get<0>( tid, cid ) =
+                                ( ti * cell_per_tile_dim + ci ) +
+                                2.0 * ( tj * cell_per_tile_dim + cj ) +
+                                3.0 * ( tk * cell_per_tile_dim + ck );
+                        }
+            }
+        } );
+
+    // Interpolate the field and its gradient back to the points. Linear
+    // splines reproduce a linear field exactly.
+    Kokkos::View<T*, TEST_DEVICE> value( "value", num_point );
+    Kokkos::View<T* [3], TEST_DEVICE> gradient( "gradient", num_point );
+    auto value_g2p = createScalarValueG2P( value, 1.0f );
+    Experimental::g2p<0>( array, points, num_point, Spline<1>(), value_g2p );
+    auto gradient_g2p = createScalarGradientG2P( gradient, 1.0f );
+    Experimental::g2p<0>( array, points, num_point, Spline<1>(),
+                          gradient_g2p );
+
+    auto value_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), value );
+    auto gradient_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), gradient );
+    for ( int p = 0; p < num_point; ++p )
+    {
+        double expected = 0.0;
+        for ( int d = 0; d < 3; ++d )
+            expected += ( d + 1 ) *
+                        ( points_host( p, d ) - global_low_corner[d] ) /
+                        cell_size;
+        EXPECT_NEAR( value_host( p ), expected, 1.0e-3 );
+        for ( int d = 0; d < 3; ++d )
+            EXPECT_NEAR( gradient_host( p, d ), ( d + 1 ) / cell_size,
+                         1.0e-2 );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// RUN TESTS
+//---------------------------------------------------------------------------//
+TEST( TEST_CATEGORY, sparse_interpolation_test ) { sparseInterpolationTest(); }
+
+//---------------------------------------------------------------------------//
+
+} // end namespace Test
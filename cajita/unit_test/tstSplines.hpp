@@ -281,4 +281,150 @@ TEST( cajita_splines, cubic_spline_test )
     EXPECT_FLOAT_EQ( field_grad, grid_deriv( xp ) );
 }
 
+TEST( cajita_splines, quartic_spline_test )
+{
+    // Check partition of unity for the quartic spline.
+    double xp = -1.4;
+    double low_x = -3.43;
+    double dx = 0.27;
+    double rdx = 1.0 / dx;
+    double values[5];
+
+    double x0 = Spline<4>::mapToLogicalGrid( xp, rdx, low_x );
+    Spline<4>::value( x0, values );
+    double sum = 0.0;
+    for ( auto x : values )
+        sum += x;
+    EXPECT_FLOAT_EQ( sum, 1.0 );
+
+    xp = 2.1789;
+    x0 = Spline<4>::mapToLogicalGrid( xp, rdx, low_x );
+    Spline<4>::value( x0, values );
+    sum = 0.0;
+    for ( auto x : values )
+        sum += x;
+    EXPECT_FLOAT_EQ( sum, 1.0 );
+
+    xp = low_x + 5 * dx;
+    x0 = Spline<4>::mapToLogicalGrid( xp, rdx, low_x );
+    Spline<4>::value( x0, values );
+    sum = 0.0;
+    for ( auto x : values )
+        sum += x;
+    EXPECT_FLOAT_EQ( sum, 1.0 );
+
+    // Check the stencil by putting a point in the center of a dual cell (on a
+    // node).
+    int node_id = 4;
+    xp = low_x + ( node_id + 0.25 ) * dx;
+    x0 = Spline<4>::mapToLogicalGrid( xp, rdx, low_x );
+    int offsets[5];
+    Spline<4>::offsets( offsets );
+    int stencil[5];
+    Spline<4>::stencil( x0, stencil );
+    for ( int n = 0; n < 5; ++n )
+    {
+        EXPECT_EQ( int( x0 ) + offsets[n], node_id + n - 2 );
+        EXPECT_EQ( stencil[n], node_id + n - 2 );
+    }
+
+    // Check the interpolation of a function.
+    auto grid_func = [=]( const double x ) { return 4.32 * x - 0.31; };
+    double field[Spline<4>::num_knot];
+    for ( int n = 0; n < 5; ++n )
+        field[n] = grid_func( low_x + stencil[n] * dx );
+    Spline<4>::value( x0, values );
+    double field_xp = 0.0;
+    for ( int n = 0; n < 5; ++n )
+        field_xp += field[n] * values[n];
+    EXPECT_FLOAT_EQ( field_xp, grid_func( xp ) );
+
+    // Check the derivative of a function.
+    Spline<4>::gradient( x0, rdx, values );
+    double field_grad = 0.0;
+    for ( int n = 0; n < 5; ++n )
+        field_grad += field[n] * values[n];
+    auto grid_deriv = [=]( const double ) { return 4.32; };
+    EXPECT_FLOAT_EQ( field_grad, grid_deriv( xp ) );
+}
+
+TEST( cajita_splines, quintic_spline_test )
+{
+    // Check partition of unity for the quintic spline.
+    double xp = -1.4;
+    double low_x = -3.43;
+    double dx = 0.27;
+    double rdx = 1.0 / dx;
+    double values[6];
+
+    double x0 = Spline<5>::mapToLogicalGrid( xp, rdx, low_x );
+    Spline<5>::value( x0, values );
+    double sum = 0.0;
+    for ( auto x : values )
+        sum += x;
+    EXPECT_FLOAT_EQ( sum, 1.0 );
+
+    xp = 2.1789;
+    x0 = Spline<5>::mapToLogicalGrid( xp, rdx, low_x );
+    Spline<5>::value( x0, values );
+    sum = 0.0;
+    for ( auto x : values )
+        sum += x;
+    EXPECT_FLOAT_EQ( sum, 1.0 );
+
+    xp = low_x + 5 * dx;
+    x0 = Spline<5>::mapToLogicalGrid( xp, rdx, low_x );
+    Spline<5>::value( x0, values );
+    sum = 0.0;
+    for ( auto x : values )
+        sum += x;
+    EXPECT_FLOAT_EQ( sum, 1.0 );
+
+    // Check the stencil by putting a point in the center of a primal cell.
+    int cell_id = 4;
+    xp = low_x + ( cell_id + 0.75 ) * dx;
+    x0 = Spline<5>::mapToLogicalGrid( xp, rdx, low_x );
+    int offsets[6];
+    Spline<5>::offsets( offsets );
+    int stencil[6];
+    Spline<5>::stencil( x0, stencil );
+    for ( int n = 0; n < 6; ++n )
+    {
+        EXPECT_EQ( int( x0 ) + offsets[n], cell_id + n - 2 );
+        EXPECT_EQ( stencil[n], cell_id + n - 2 );
+    }
+
+    // Check the interpolation of a function.
+    auto grid_func = [=]( const double x ) { return 4.32 * x - 0.31; };
+    double field[Spline<5>::num_knot];
+    for ( int n = 0; n < 6; ++n )
+        field[n] = grid_func( low_x + stencil[n] * dx );
+    Spline<5>::value( x0, values );
+    double field_xp = 0.0;
+    for ( int n = 0; n < 6; ++n )
+        field_xp += field[n] * values[n];
+    EXPECT_FLOAT_EQ( field_xp, grid_func( xp ) );
+
+    // Check the derivative of a function.
+    Spline<5>::gradient( x0, rdx, values );
+    double field_grad = 0.0;
+    for ( int n = 0; n < 6; ++n )
+        field_grad += field[n] * values[n];
+    auto grid_deriv = [=]( const double ) { return 4.32; };
+    EXPECT_FLOAT_EQ( field_grad, grid_deriv( xp ) );
+}
+
+TEST( cajita_splines, stencil_loop_test )
+{
+    // Check the unrolled stencil loop visits every stencil entry once.
+    using sd_type = SplineData<double, 5, 3, Node>;
+    int count[6][6][6] = {};
+    splineStencilLoop<sd_type>(
+        [&]( const int i, const int j, const int k ) { ++count[i][j][k]; } );
+    for ( int i = 0; i < 6; ++i )
+        for ( int j = 0; j < 6; ++j )
+            for ( int k = 0; k < 6; ++k )
+                EXPECT_EQ( count[i][j][k], 1 );
+}
+
 } // end namespace Test
@@ -17,6 +17,7 @@
 #define CABANA_COMMUNICATIONPLAN_HPP
 
 #include <CabanaCore_config.hpp>
+#include <Cabana_ParameterPack.hpp>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_ScatterView.hpp>
@@ -1056,6 +1057,101 @@ struct CommunicationDataSlice
     //! Slice components.
     std::size_t _num_comp;
 };
+
+/*!
+  \brief Store send/receive buffers for multiple slices communicated together.
+
+  Each element is packed as a single byte record containing the components of
+  every slice such that all slices are sent in one message per neighbor.
+*/
+template <class... SliceTypes>
+struct CommunicationDataSlices
+{
+    //! Number of slices.
+    static constexpr std::size_t num_slice = sizeof...( SliceTypes );
+    static_assert( num_slice > 0, "" );
+
+    //! Particle data type.
+    using particle_data_type = ParameterPack<SliceTypes...>;
+    //! Kokkos memory space.
+    using memory_space =
+        typename PackTypeAtIndex<0, SliceTypes...>::type::memory_space;
+    //! Communication data type.
+    using data_type = char;
+    //! Communication buffer type.
+    using buffer_type =
+        typename Kokkos::View<data_type**, Kokkos::LayoutRight, memory_space>;
+
+    /*!
+      Constructor
+      \param particles The slices to communicate.
+    */
+    CommunicationDataSlices( particle_data_type particles )
+        : _particles( particles )
+    {
+        setSliceComponents();
+
+        _send_buffer = buffer_type(
+            Kokkos::ViewAllocateWithoutInitializing( "send_buffer" ), 0, 0 );
+        _recv_buffer = buffer_type(
+            Kokkos::ViewAllocateWithoutInitializing( "recv_buffer" ), 0, 0 );
+    }
+
+    //! Resize the send buffer.
+    void reallocateSend( const std::size_t num_send )
+    {
+        Kokkos::realloc( _send_buffer, num_send, _record_bytes );
+    }
+    //! Resize the receive buffer.
+    void reallocateReceive( const std::size_t num_recv )
+    {
+        Kokkos::realloc( _recv_buffer, num_recv, _record_bytes );
+    }
+
+    //! Get the number of components and record byte offset of each slice.
+    void setSliceComponents()
+    {
+        _record_bytes = 0;
+        setSliceComponents( std::integral_constant<std::size_t, 0>() );
+    }
+
+    //! \cond Impl
+    void setSliceComponents( std::integral_constant<std::size_t, num_slice> )
+    {
+    }
+
+    template <std::size_t N>
+    void setSliceComponents( std::integral_constant<std::size_t, N> )
+    {
+        using slice_type = typename PackTypeAtIndex<N, SliceTypes...>::type;
+        static_assert( is_slice<slice_type>::value, "" );
+
+        const auto& slice = get<N>( _particles );
+        std::size_t num_comp = 1;
+        for ( std::size_t d = 2; d < slice.rank(); ++d )
+            num_comp *= slice.extent( d );
+
+        _num_comp[N] = num_comp;
+        _byte_offset[N] = _record_bytes;
+        _record_bytes += num_comp * sizeof( typename slice_type::value_type );
+
+        setSliceComponents( std::integral_constant<std::size_t, N + 1>() );
+    }
+    //! \endcond
+
+    //! Send buffer.
+    buffer_type _send_buffer;
+    //! Receive buffer.
+    buffer_type _recv_buffer;
+    //! Particle slices.
+    particle_data_type _particles;
+    //! Components of each slice.
+    Kokkos::Array<std::size_t, num_slice> _num_comp;
+    //! Byte offset of each slice in an element record.
+    Kokkos::Array<std::size_t, num_slice> _byte_offset;
+    //! Total bytes of an element record.
+    std::size_t _record_bytes;
+};
 //---------------------------------------------------------------------------//
 
 /*!
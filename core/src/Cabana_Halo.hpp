@@ -18,13 +18,17 @@
 
 #include <Cabana_AoSoA.hpp>
 #include <Cabana_CommunicationPlan.hpp>
+#include <Cabana_ParameterPack.hpp>
 #include <Cabana_Slice.hpp>
+#include <Cabana_Sort.hpp>
 
 #include <Kokkos_Core.hpp>
 
 #include <mpi.h>
 
 #include <exception>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Cabana
@@ -220,6 +224,40 @@ bool haloCheckValidSize(
     return ( particles.size() == halo.numLocal() + halo.numGhost() );
 }
 
+//! \cond Impl
+template <class Halo, class... SliceTypes, std::size_t... Indices>
+bool haloCheckValidSize( const Halo& halo,
+                         const ParameterPack<SliceTypes...>& slices,
+                         std::index_sequence<Indices...> )
+{
+    bool valid[] = { true,
+                     haloCheckValidSize( halo, get<Indices>( slices ) )... };
+    for ( const bool v : valid )
+        if ( !v )
+            return false;
+    return true;
+}
+//! \endcond
+
+/*!
+  \brief Ensure the size of every slice matches the total halo (local and
+  ghost) size.
+
+  \param halo The halo that will be used for the gather. Used to query import
+  and export sizes.
+
+  \param slices The slices to be communicated together. Used to query the
+  total sizes.
+*/
+template <class Halo, class... SliceTypes>
+bool haloCheckValidSize(
+    const Halo& halo, const ParameterPack<SliceTypes...>& slices,
+    typename std::enable_if<( is_halo<Halo>::value ), int>::type* = 0 )
+{
+    return haloCheckValidSize(
+        halo, slices, std::make_index_sequence<sizeof...( SliceTypes )>() );
+}
+
 template <class HaloType, class AoSoAType, class SFINAE = void>
 class Gather;
 
@@ -595,12 +633,300 @@ class Gather<HaloType, SliceType,
     using base_type::_send_policy;
 };
 
+//---------------------------------------------------------------------------//
+namespace Impl
+{
+//! \cond Impl
+// Pack the components of a slice element into a byte record. Pack by bytes to
+// avoid casting across alignment boundaries.
+template <class SliceType>
+KOKKOS_INLINE_FUNCTION void
+packSliceElement( const SliceType& slice, const std::size_t slice_idx,
+                  const std::size_t num_comp, char* record )
+{
+    using value_type = typename SliceType::value_type;
+    auto s = SliceType::index_type::s( slice_idx );
+    auto a = SliceType::index_type::a( slice_idx );
+    std::size_t slice_offset = s * slice.stride( 0 ) + a;
+    for ( std::size_t n = 0; n < num_comp; ++n )
+    {
+        const char* elem_ptr = reinterpret_cast<const char*>(
+            slice.data() + slice_offset + n * SliceType::vector_length );
+        for ( std::size_t b = 0; b < sizeof( value_type ); ++b )
+            record[n * sizeof( value_type ) + b] = *( elem_ptr + b );
+    }
+}
+
+// Unpack the components of a slice element from a byte record. Unpack by
+// bytes to avoid casting across alignment boundaries.
+template <class SliceType>
+KOKKOS_INLINE_FUNCTION void
+unpackSliceElement( const SliceType& slice, const std::size_t slice_idx,
+                    const std::size_t num_comp, const char* record )
+{
+    using value_type = typename SliceType::value_type;
+    auto s = SliceType::index_type::s( slice_idx );
+    auto a = SliceType::index_type::a( slice_idx );
+    std::size_t slice_offset = s * slice.stride( 0 ) + a;
+    for ( std::size_t n = 0; n < num_comp; ++n )
+    {
+        char* elem_ptr = reinterpret_cast<char*>(
+            slice.data() + slice_offset + n * SliceType::vector_length );
+        for ( std::size_t b = 0; b < sizeof( value_type ); ++b )
+            *( elem_ptr + b ) = record[n * sizeof( value_type ) + b];
+    }
+}
+
+// Pack an element of every slice into a byte record.
+template <class... SliceTypes>
+KOKKOS_INLINE_FUNCTION void
+packSlices( const ParameterPack<SliceTypes...>& slices,
+            const std::size_t slice_idx,
+            const Kokkos::Array<std::size_t, sizeof...( SliceTypes )>& num_comp,
+            const Kokkos::Array<std::size_t, sizeof...( SliceTypes )>& offset,
+            char* record, std::integral_constant<std::size_t, 0> )
+{
+    packSliceElement( get<0>( slices ), slice_idx, num_comp[0],
+                      record + offset[0] );
+}
+
+template <std::size_t N, class... SliceTypes>
+KOKKOS_INLINE_FUNCTION void
+packSlices( const ParameterPack<SliceTypes...>& slices,
+            const std::size_t slice_idx,
+            const Kokkos::Array<std::size_t, sizeof...( SliceTypes )>& num_comp,
+            const Kokkos::Array<std::size_t, sizeof...( SliceTypes )>& offset,
+            char* record, std::integral_constant<std::size_t, N> )
+{
+    packSliceElement( get<N>( slices ), slice_idx, num_comp[N],
+                      record + offset[N] );
+    packSlices( slices, slice_idx, num_comp, offset, record,
+                std::integral_constant<std::size_t, N - 1>() );
+}
+
+// Unpack an element of every slice from a byte record.
+template <class... SliceTypes>
+KOKKOS_INLINE_FUNCTION void unpackSlices(
+    const ParameterPack<SliceTypes...>& slices, const std::size_t slice_idx,
+    const Kokkos::Array<std::size_t, sizeof...( SliceTypes )>& num_comp,
+    const Kokkos::Array<std::size_t, sizeof...( SliceTypes )>& offset,
+    const char* record, std::integral_constant<std::size_t, 0> )
+{
+    unpackSliceElement( get<0>( slices ), slice_idx, num_comp[0],
+                        record + offset[0] );
+}
+
+template <std::size_t N, class... SliceTypes>
+KOKKOS_INLINE_FUNCTION void unpackSlices(
+    const ParameterPack<SliceTypes...>& slices, const std::size_t slice_idx,
+    const Kokkos::Array<std::size_t, sizeof...( SliceTypes )>& num_comp,
+    const Kokkos::Array<std::size_t, sizeof...( SliceTypes )>& offset,
+    const char* record, std::integral_constant<std::size_t, N> )
+{
+    unpackSliceElement( get<N>( slices ), slice_idx, num_comp[N],
+                        record + offset[N] );
+    unpackSlices( slices, slice_idx, num_comp, offset, record,
+                  std::integral_constant<std::size_t, N - 1>() );
+}
+//! \endcond
+} // end namespace Impl
+
+/*!
+  \brief Synchronously gather data from the local decomposition to the ghosts
+  using the halo forward communication plan. Multiple slice version. This is a
+  uniquely-owned to multiply-owned communication.
+
+  All slices are packed into a single buffer such that one message is sent to
+  each neighbor regardless of the number of slices, rather than one message
+  per slice per neighbor when gathering the slices individually.
+*/
+template <class HaloType, class... SliceTypes>
+class Gather<HaloType, ParameterPack<SliceTypes...>>
+    : public CommunicationData<HaloType, CommunicationDataSlices<SliceTypes...>>
+{
+  public:
+    static_assert( is_halo<HaloType>::value, "" );
+
+    //! Base type.
+    using base_type =
+        CommunicationData<HaloType, CommunicationDataSlices<SliceTypes...>>;
+    //! Communication plan type (Halo)
+    using plan_type = typename base_type::plan_type;
+    //! Kokkos execution space.
+    using execution_space = typename base_type::execution_space;
+    //! Kokkos memory space.
+    using memory_space = typename base_type::memory_space;
+    //! Communication data type.
+    using data_type = typename base_type::data_type;
+    //! Communication buffer type.
+    using buffer_type = typename base_type::buffer_type;
+    //! Slice parameter pack type.
+    using particle_data_type = ParameterPack<SliceTypes...>;
+
+    /*!
+      \param halo The Halo to be used for the gather.
+
+      \param slices The slices on which to perform the gather, created with
+      makeParameterPack(). Each slice should have a size equivalent to
+      halo.numGhost() + halo.numLocal(). The locally owned elements are
+      expected to appear first (i.e. in the first halo.numLocal() elements) and
+      the ghosted elements are expected to appear second (i.e. in the next
+      halo.numGhost() elements()).
+
+      \param overallocation An optional factor to keep extra space in the
+      buffers to avoid frequent resizing.
+    */
+    Gather( HaloType halo, particle_data_type slices,
+            const double overallocation = 1.0 )
+        : base_type( halo, slices, overallocation )
+    {
+        reserve( _halo, slices );
+    }
+
+    //! Total gather send size for this rank.
+    auto totalSend() { return _halo.totalNumExport(); }
+    //! Total gather receive size for this rank.
+    auto totalReceive() { return _halo.totalNumImport(); }
+
+    /*!
+      \brief Perform the gather operation.
+    */
+    void apply() override
+    {
+        Kokkos::Profiling::pushRegion( "Cabana::gather" );
+
+        // Get the buffers and slices (local copies for lambdas below).
+        auto send_buffer = this->getSendBuffer();
+        auto recv_buffer = this->getReceiveBuffer();
+        auto slices = this->getData();
+
+        // Get the components and record offsets of each slice.
+        auto num_comp = _comm_data._num_comp;
+        auto offset = _comm_data._byte_offset;
+        using last_slice =
+            std::integral_constant<std::size_t, sizeof...( SliceTypes ) - 1>;
+
+        // Get the steering vector for the sends.
+        auto steering = _halo.getExportSteering();
+
+        // Gather from the local data into a record-contiguous send buffer.
+        auto gather_send_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+        {
+            Impl::packSlices( slices, steering( i ), num_comp, offset,
+                              &send_buffer( i, 0 ), last_slice() );
+        };
+        Kokkos::parallel_for( "Cabana::gather::gather_send_buffer",
+                              _send_policy, gather_send_buffer_func );
+        Kokkos::fence();
+
+        // The halo has it's own communication space so choose any mpi tag.
+        const int mpi_tag = 2345;
+
+        // Post non-blocking receives.
+        int num_n = _halo.numNeighbor();
+        std::vector<MPI_Request> requests( num_n );
+        std::pair<std::size_t, std::size_t> recv_range = { 0, 0 };
+        for ( int n = 0; n < num_n; ++n )
+        {
+            recv_range.second = recv_range.first + _halo.numImport( n );
+
+            auto recv_subview =
+                Kokkos::subview( recv_buffer, recv_range, Kokkos::ALL );
+
+            MPI_Irecv( recv_subview.data(),
+                       recv_subview.size() * sizeof( data_type ), MPI_BYTE,
+                       _halo.neighborRank( n ), mpi_tag, _halo.comm(),
+                       &( requests[n] ) );
+
+            recv_range.first = recv_range.second;
+        }
+
+        // Do blocking sends.
+        std::pair<std::size_t, std::size_t> send_range = { 0, 0 };
+        for ( int n = 0; n < num_n; ++n )
+        {
+            send_range.second = send_range.first + _halo.numExport( n );
+
+            auto send_subview =
+                Kokkos::subview( send_buffer, send_range, Kokkos::ALL );
+
+            MPI_Send( send_subview.data(),
+                      send_subview.size() * sizeof( data_type ), MPI_BYTE,
+                      _halo.neighborRank( n ), mpi_tag, _halo.comm() );
+
+            send_range.first = send_range.second;
+        }
+
+        // Wait on non-blocking receives.
+        std::vector<MPI_Status> status( num_n );
+        const int ec =
+            MPI_Waitall( requests.size(), requests.data(), status.data() );
+        if ( MPI_SUCCESS != ec )
+            throw std::logic_error( "Failed MPI Communication" );
+
+        // Extract the receive buffer into the ghosted elements.
+        std::size_t num_local = _halo.numLocal();
+        auto extract_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+        {
+            Impl::unpackSlices( slices, i + num_local, num_comp, offset,
+                                &recv_buffer( i, 0 ), last_slice() );
+        };
+        Kokkos::parallel_for( "Cabana::gather::extract_recv_buffer",
+                              _recv_policy, extract_recv_buffer_func );
+        Kokkos::fence();
+
+        // Barrier before completing to ensure synchronization.
+        MPI_Barrier( _halo.comm() );
+
+        Kokkos::Profiling::popRegion();
+    }
+
+    /*!
+      \brief Reserve new buffers as needed and update the halo and slice data.
+
+      \param halo The Halo to be used for the gather.
+      \param slices The slices on which to perform the gather.
+      \param overallocation An optional factor to keep extra space in the
+      buffers to avoid frequent resizing.
+    */
+    void reserve( const HaloType& halo, const particle_data_type& slices,
+                  const double overallocation )
+    {
+        if ( !haloCheckValidSize( halo, slices ) )
+            throw std::runtime_error( "Slice is the wrong size for gather!" );
+
+        this->reserveImpl( halo, slices, totalSend(), totalReceive(),
+                           overallocation );
+    }
+    /*!
+      \brief Reserve new buffers as needed and update the halo and slice data.
+
+      \param halo The Halo to be used for the gather.
+      \param slices The slices on which to perform the gather.
+    */
+    void reserve( const HaloType& halo, const particle_data_type& slices )
+    {
+        if ( !haloCheckValidSize( halo, slices ) )
+            throw std::runtime_error( "Slice is the wrong size for gather!" );
+
+        this->reserveImpl( halo, slices, totalSend(), totalReceive() );
+    }
+
+  private:
+    plan_type _halo = base_type::_comm_plan;
+    using base_type::_comm_data;
+    using base_type::_recv_policy;
+    using base_type::_send_policy;
+};
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Create the gather.
 
   \param halo The halo to use for the gather.
-  \param data The data on which to perform the gather. The slice should have a
+  \param data The data on which to perform the gather: an AoSoA, a slice, or
+  a parameter pack of slices (created with makeParameterPack()) to be gathered
+  together in a single message per neighbor. The slice should have a
   size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
   elements are expected to appear first (i.e. in the first halo.numLocal()
   elements) and the ghosted elements are expected to appear second (i.e. in the
@@ -640,10 +966,158 @@ void gather( const HaloType& halo, ParticleDataType& data )
     gather.apply();
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously gather data from the local decomposition to the
+  ghosts using the halo forward communication plan. Multiple slice version.
+  All slices are sent together in a single message per neighbor. This is a
+  uniquely-owned to multiply-owned communication.
+
+  \note This routine allocates send and receive buffers internally. This is
+  often not performant due to frequent buffer reallocations - consider creating
+  and reusing Gather instead by passing makeParameterPack( slices... ) to
+  createGather().
+
+  \param halo The halo to use for the gather.
+
+  \param slices The slices on which to perform the gather. Each slice should
+  have a size equivalent to halo.numGhost() + halo.numLocal(). The locally
+  owned elements are expected to appear first (i.e. in the first
+  halo.numLocal() elements) and the ghosted elements are expected to appear
+  second (i.e. in the next halo.numGhost() elements()).
+*/
+template <class HaloType, class... SliceTypes>
+std::enable_if_t<( sizeof...( SliceTypes ) > 1 ), void>
+gather( const HaloType& halo, SliceTypes&... slices )
+{
+    auto gather = createGather( halo, makeParameterPack( slices... ) );
+    gather.apply();
+}
+
 /**********
  * SCATTER *
  **********/
 
+//---------------------------------------------------------------------------//
+// Scatter reduction.
+//---------------------------------------------------------------------------//
+namespace ScatterReduce
+{
+
+//! Sum ghost contributions into the locally owned value.
+struct Sum
+{
+};
+
+//! Assign the locally owned value to be the minimum of it and the ghost
+//! contributions.
+struct Min
+{
+};
+
+//! Assign the locally owned value to be the maximum of it and the ghost
+//! contributions.
+struct Max
+{
+};
+
+//! Replace the locally owned value with a ghost contribution. Note that if
+//! multiple ghosts scatter back to the same element then the value assigned
+//! will be from one of the ghosts but it is undetermined from which ghost that
+//! value will come.
+struct Replace
+{
+};
+
+} // end namespace ScatterReduce
+
+//---------------------------------------------------------------------------//
+// Scatter unpack algorithm tags.
+//---------------------------------------------------------------------------//
+//! Reduce each received ghost contribution directly into the locally owned
+//! value with atomic operations.
+struct ScatterAtomic
+{
+};
+
+//! Sort the received ghost contributions by their locally owned destination
+//! and reduce each segment of contributions without atomic operations. This
+//! avoids atomic contention on elements that are ghosted on many ranks.
+struct ScatterSegmented
+{
+};
+
+namespace Impl
+{
+//! \cond Impl
+// Reduce a value into a result. Sum reduction.
+template <class T>
+KOKKOS_INLINE_FUNCTION void scatterReduceOp( ScatterReduce::Sum, const T& val,
+                                             T& result )
+{
+    result += val;
+}
+
+// Reduce a value into a result. Min reduction.
+template <class T>
+KOKKOS_INLINE_FUNCTION void scatterReduceOp( ScatterReduce::Min, const T& val,
+                                             T& result )
+{
+    if ( val < result )
+        result = val;
+}
+
+// Reduce a value into a result. Max reduction.
+template <class T>
+KOKKOS_INLINE_FUNCTION void scatterReduceOp( ScatterReduce::Max, const T& val,
+                                             T& result )
+{
+    if ( val > result )
+        result = val;
+}
+
+// Reduce a value into a result. Replace reduction.
+template <class T>
+KOKKOS_INLINE_FUNCTION void scatterReduceOp( ScatterReduce::Replace,
+                                             const T& val, T& result )
+{
+    result = val;
+}
+
+// Atomically reduce a value into a result. Sum reduction.
+template <class T>
+KOKKOS_INLINE_FUNCTION void scatterAtomicOp( ScatterReduce::Sum, const T& val,
+                                             T* result )
+{
+    Kokkos::atomic_add( result, val );
+}
+
+// Atomically reduce a value into a result. Min reduction.
+template <class T>
+KOKKOS_INLINE_FUNCTION void scatterAtomicOp( ScatterReduce::Min, const T& val,
+                                             T* result )
+{
+    Kokkos::atomic_fetch_min( result, val );
+}
+
+// Atomically reduce a value into a result. Max reduction.
+template <class T>
+KOKKOS_INLINE_FUNCTION void scatterAtomicOp( ScatterReduce::Max, const T& val,
+                                             T* result )
+{
+    Kokkos::atomic_fetch_max( result, val );
+}
+
+// Atomically reduce a value into a result. Replace reduction.
+template <class T>
+KOKKOS_INLINE_FUNCTION void scatterAtomicOp( ScatterReduce::Replace,
+                                             const T& val, T* result )
+{
+    Kokkos::atomic_exchange( result, val );
+}
+//! \endcond
+} // end namespace Impl
+
 //---------------------------------------------------------------------------//
 /*!
   \brief Synchronously scatter data from the ghosts to the local decomposition
@@ -652,9 +1126,10 @@ void gather( const HaloType& halo, ParticleDataType& data )
 
   In a scatter operation results from ghosted values on other processors are
   scattered back to the owning processor of the ghost and the value associated
-  with the ghost is summed into the locally owned value the ghost represents.
-  If a locally owned element is ghosted on multiple ranks, then multiple
-  contributions will be made to the sum, one for each rank.
+  with the ghost is reduced into the locally owned value the ghost represents.
+  By default the values are summed. If a locally owned element is ghosted on
+  multiple ranks, then multiple contributions will be made to the reduction,
+  one for each rank.
 */
 template <class HaloType, class SliceType>
 class Scatter
@@ -676,6 +1151,11 @@ class Scatter
     using data_type = typename base_type::data_type;
     //! Communication buffer type.
     using buffer_type = typename base_type::buffer_type;
+    //! Steering vector type.
+    using steering_type =
+        decltype( std::declval<plan_type>().getExportSteering() );
+    //! Binning data type of the received contributions.
+    using bin_data_type = BinningData<typename steering_type::device_type>;
 
     /*!
       \param halo The Halo to be used for the gather.
@@ -701,9 +1181,36 @@ class Scatter
     auto totalReceive() { return _halo.totalNumExport(); }
 
     /*!
-      \brief Perform the scatter operation.
+      \brief Perform the scatter operation, summing the ghost contributions.
     */
-    void apply() override
+    void apply() override { apply( ScatterReduce::Sum() ); }
+
+    /*!
+      \brief Perform the scatter operation with the given type of reduce
+      operation. Contributions are reduced with atomic operations.
+
+      \param reduce_op The reduction to apply (ScatterReduce::Sum,
+      ScatterReduce::Min, ScatterReduce::Max, or ScatterReduce::Replace).
+    */
+    template <class ReduceOp>
+    void apply( const ReduceOp& reduce_op )
+    {
+        apply( reduce_op, ScatterAtomic() );
+    }
+
+    /*!
+      \brief Perform the scatter operation with the given type of reduce
+      operation and unpack algorithm.
+
+      \param reduce_op The reduction to apply (ScatterReduce::Sum,
+      ScatterReduce::Min, ScatterReduce::Max, or ScatterReduce::Replace).
+
+      \param algorithm_tag The algorithm used to reduce the received ghost
+      contributions into the locally owned values (ScatterAtomic or
+      ScatterSegmented).
+    */
+    template <class ReduceOp, class AlgorithmTag>
+    void apply( const ReduceOp& reduce_op, const AlgorithmTag& algorithm_tag )
     {
         Kokkos::Profiling::pushRegion( "Cabana::scatter" );
 
@@ -782,23 +1289,9 @@ class Scatter
         if ( MPI_SUCCESS != ec )
             throw std::logic_error( "Failed MPI Communication" );
 
-        // Get the steering vector for the sends.
-        auto steering = _halo.getExportSteering();
-
-        // Scatter the ghosts in the receive buffer into the local values.
-        auto scatter_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
-        {
-            auto s = SliceType::index_type::s( steering( i ) );
-            auto a = SliceType::index_type::a( steering( i ) );
-            std::size_t slice_offset = s * slice.stride( 0 ) + a;
-            for ( std::size_t n = 0; n < num_comp; ++n )
-                Kokkos::atomic_add(
-                    &slice_data( slice_offset + SliceType::vector_length * n ),
-                    recv_buffer( i, n ) );
-        };
-        Kokkos::parallel_for( "Cabana::scatter::scatter_recv_buffer",
-                              _recv_policy, scatter_recv_buffer_func );
-        Kokkos::fence();
+        // Reduce the ghosts in the receive buffer into the local values.
+        scatterRecvBuffer( reduce_op, algorithm_tag, recv_buffer, slice,
+                           slice_data, num_comp );
 
         // Barrier before completing to ensure synchronization.
         MPI_Barrier( _halo.comm() );
@@ -822,6 +1315,7 @@ class Scatter
 
         this->reserveImpl( halo, slice, totalSend(), totalReceive(),
                            overallocation );
+        _num_segment = -1;
     }
     /*!
       \brief Reserve new buffers as needed and update the halo and slice data.
@@ -835,12 +1329,138 @@ class Scatter
             throw std::runtime_error( "AoSoA is the wrong size for scatter!" );
 
         this->reserveImpl( halo, slice, totalSend(), totalReceive() );
+        _num_segment = -1;
+    }
+
+    //! \cond Impl
+    // Reduce the received contributions directly into the local values with
+    // atomic operations.
+    template <class ReduceOp, class SliceDataView>
+    void scatterRecvBuffer( const ReduceOp& reduce_op, ScatterAtomic,
+                            const buffer_type& recv_buffer,
+                            const SliceType& slice,
+                            const SliceDataView& slice_data,
+                            const std::size_t num_comp )
+    {
+        // Get the steering vector for the sends.
+        auto steering = _halo.getExportSteering();
+
+        // Scatter the ghosts in the receive buffer into the local values.
+        auto scatter_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t i )
+        {
+            auto s = SliceType::index_type::s( steering( i ) );
+            auto a = SliceType::index_type::a( steering( i ) );
+            std::size_t slice_offset = s * slice.stride( 0 ) + a;
+            for ( std::size_t n = 0; n < num_comp; ++n )
+                Impl::scatterAtomicOp(
+                    reduce_op, recv_buffer( i, n ),
+                    &slice_data( slice_offset + SliceType::vector_length * n ) );
+        };
+        Kokkos::parallel_for( "Cabana::scatter::scatter_recv_buffer",
+                              _recv_policy, scatter_recv_buffer_func );
+        Kokkos::fence();
     }
 
+    // Reduce the received contributions to each local value as a segment
+    // without atomic operations. Each local element is updated by one thread.
+    template <class ReduceOp, class SliceDataView>
+    void scatterRecvBuffer( const ReduceOp& reduce_op, ScatterSegmented,
+                            const buffer_type& recv_buffer,
+                            const SliceType& slice,
+                            const SliceDataView& slice_data,
+                            const std::size_t num_comp )
+    {
+        // The segments only depend on the halo so build them once.
+        if ( _num_segment < 0 )
+            buildSegments();
+
+        // Get the steering vector for the sends and the segments.
+        auto steering = _halo.getExportSteering();
+        auto bin_data = _segment_bins;
+        auto segment_offsets = _segment_offsets;
+
+        // Reduce each segment of ghosts in the receive buffer into the
+        // local value they share.
+        auto scatter_recv_buffer_func = KOKKOS_LAMBDA( const std::size_t seg )
+        {
+            auto begin = segment_offsets( seg );
+            auto end = segment_offsets( seg + 1 );
+            auto local_id = steering( bin_data.permutation( begin ) );
+            auto s = SliceType::index_type::s( local_id );
+            auto a = SliceType::index_type::a( local_id );
+            std::size_t slice_offset = s * slice.stride( 0 ) + a;
+            for ( std::size_t n = 0; n < num_comp; ++n )
+            {
+                data_type result =
+                    recv_buffer( bin_data.permutation( begin ), n );
+                for ( std::size_t j = begin + 1; j < end; ++j )
+                    Impl::scatterReduceOp(
+                        reduce_op, recv_buffer( bin_data.permutation( j ), n ),
+                        result );
+                Impl::scatterReduceOp(
+                    reduce_op, result,
+                    slice_data( slice_offset + SliceType::vector_length * n ) );
+            }
+        };
+        Kokkos::parallel_for(
+            "Cabana::scatter::scatter_recv_buffer_segmented",
+            Kokkos::RangePolicy<execution_space>( 0, _num_segment ),
+            scatter_recv_buffer_func );
+        Kokkos::fence();
+    }
+
+    // Sort the received contributions by their local destination and find
+    // the contiguous segment of contributions for each destination.
+    void buildSegments()
+    {
+        std::size_t num_recv = totalReceive();
+        std::size_t num_local = _halo.numLocal();
+        _segment_offsets = Kokkos::View<std::size_t*, memory_space>(
+            Kokkos::ViewAllocateWithoutInitializing( "segment_offsets" ),
+            num_recv + 1 );
+
+        std::size_t num_segment = 0;
+        if ( num_recv > 0 )
+        {
+            // Bin the contributions with a single bin for each local element.
+            auto steering = _halo.getExportSteering();
+            Kokkos::BinOp1D<steering_type> comp( num_local, 0, num_local );
+            _segment_bins = binByKeyWithComparator( steering, comp );
+
+            // Compact the non-empty bins into segments.
+            auto bin_data = _segment_bins;
+            auto segment_offsets = _segment_offsets;
+            Kokkos::parallel_scan(
+                "Cabana::scatter::build_segments",
+                Kokkos::RangePolicy<execution_space>( 0, num_local ),
+                KOKKOS_LAMBDA( const std::size_t b, std::size_t& update,
+                               const bool final_pass ) {
+                    if ( bin_data.binSize( b ) > 0 )
+                    {
+                        if ( final_pass )
+                            segment_offsets( update ) = bin_data.binOffset( b );
+                        ++update;
+                    }
+                },
+                num_segment );
+        }
+        Kokkos::deep_copy( Kokkos::subview( _segment_offsets, num_segment ),
+                           num_recv );
+        _num_segment = num_segment;
+    }
+    //! \endcond
+
   private:
     plan_type _halo = base_type::_comm_plan;
     using base_type::_recv_policy;
     using base_type::_send_policy;
+
+    // Received contributions binned by local destination.
+    bin_data_type _segment_bins;
+    // Offsets of the contributions to each local destination.
+    Kokkos::View<std::size_t*, memory_space> _segment_offsets;
+    // Number of local destinations (negative if the segments must be rebuilt).
+    long _num_segment = -1;
 };
 
 /*!
@@ -893,6 +1513,44 @@ void scatter( const HaloType& halo, SliceType& slice,
     scatter.apply();
 }
 
+//---------------------------------------------------------------------------//
+/*!
+  \brief Synchronously scatter data from the ghosts to the local decomposition
+  of a slice using the halo reverse communication plan and the given type of
+  reduce operation. This is a multiply-owned to uniquely owned communication.
+
+  \note This routine allocates send and receive buffers internally. This is
+  often not performant due to frequent buffer reallocations - consider creating
+  and reusing Scatter instead.
+
+  \param halo The halo to use for the scatter.
+
+  \param slice The Slice on which to perform the scatter. The Slice should have
+  a size equivalent to halo.numGhost() + halo.numLocal(). The locally owned
+  elements are expected to appear first (i.e. in the first halo.numLocal()
+  elements) and the ghosted elements are expected to appear second (i.e. in
+  the next halo.numGhost() elements()).
+
+  \param reduce_op The reduction to apply (ScatterReduce::Sum,
+  ScatterReduce::Min, ScatterReduce::Max, or ScatterReduce::Replace).
+
+  \param algorithm_tag The algorithm used to reduce the received ghost
+  contributions into the locally owned values (ScatterAtomic or
+  ScatterSegmented).
+*/
+template <class HaloType, class SliceType, class ReduceOp,
+          class AlgorithmTag = ScatterAtomic>
+void scatter( const HaloType& halo, SliceType& slice,
+              const ReduceOp& reduce_op,
+              const AlgorithmTag& algorithm_tag = AlgorithmTag(),
+              typename std::enable_if<( is_halo<HaloType>::value &&
+                                        is_slice<SliceType>::value ),
+                                      int>::type* = 0 )
+{
+    auto scatter = createScatter( halo, slice );
+    scatter.apply( reduce_op, algorithm_tag );
+}
+
 //---------------------------------------------------------------------------//
 
 } // end namespace Cabana
@@ -75,6 +75,14 @@ template <std::size_t... Indices, typename... Types>
 struct ParameterPackImpl<std::index_sequence<Indices...>, Types...>
     : ParameterPackElement<Indices, Types>...
 {
+    ParameterPackImpl() = default;
+
+    template <class... Args,
+              class = typename std::enable_if<( sizeof...( Args ) > 0 )>::type>
+    ParameterPackImpl( const Args&... args )
+        : ParameterPackElement<Indices, Types>{ args }...
+    {
+    }
 };
 //! \endcond
 
@@ -84,6 +92,22 @@ template <typename... Types>
 struct ParameterPack
     : ParameterPackImpl<std::make_index_sequence<sizeof...( Types )>, Types...>
 {
+    //! Default constructor.
+    ParameterPack() = default;
+
+    /*!
+      \brief Copy-initialize each element from the given values so the
+      elements need not be default constructible.
+      \param args The values of the elements in order.
+    */
+    template <class... Args,
+              class = typename std::enable_if<( sizeof...( Args ) > 0 )>::type>
+    explicit ParameterPack( const Args&... args )
+        : ParameterPackImpl<std::make_index_sequence<sizeof...( Types )>,
+                            Types...>( args... )
+    {
+    }
+
     //! Packed type.
     template <std::size_t N>
     using value_type = typename PackTypeAtIndex<N, Types...>::type;
@@ -184,13 +208,12 @@ void fillParameterPack( ParameterPack_t& )
 }
 
 //---------------------------------------------------------------------------//
-//! Create a parameter pack.
+//! Create a parameter pack. The elements are copy-initialized so they need
+//! not be default constructible.
 template <typename... Types>
 ParameterPack<Types...> makeParameterPack( const Types&... ts )
 {
-    ParameterPack<Types...> pp;
-    fillParameterPack( pp, ts... );
-    return pp;
+    return ParameterPack<Types...>( ts... );
 }
 
 //---------------------------------------------------------------------------//
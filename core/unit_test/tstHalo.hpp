@@ -582,6 +582,239 @@ void testHaloBuffers( TestTag tag, const bool use_topology )
     checkSizeAndCapacity( scatter_dbl, num_send, num_recv, overalloc );
 }
 
+//---------------------------------------------------------------------------//
+// Gather test with multiple slices communicated together.
+template <class TestTag>
+void testHaloMultiSlice( TestTag tag, const bool use_topology )
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Make a communication plan.
+    int num_local = tag.num_local;
+    auto halo = createHalo( tag, use_topology, my_size, num_local );
+
+    // Create particle data.
+    HaloData halo_data( *halo );
+    auto data = halo_data.createData( my_rank, num_local );
+
+    // Gather by AoSoA and scatter back the results.
+    Cabana::gather( *halo, data );
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    Cabana::scatter( *halo, slice_int );
+    Cabana::scatter( *halo, slice_dbl );
+
+    // Gather both slices at once.
+    Cabana::gather( *halo, slice_int, slice_dbl );
+    auto data_host = halo_data.copyToHost();
+    checkGatherSlice( tag, data_host, my_size, my_rank, num_local );
+
+    // Reset, then gather both slices at once with persistent buffers.
+    data = halo_data.createData( my_rank, num_local );
+    Cabana::gather( *halo, data );
+    Cabana::scatter( *halo, slice_int );
+    Cabana::scatter( *halo, slice_dbl );
+
+    double overalloc = 3.0;
+    auto gather = createGather(
+        *halo, Cabana::makeParameterPack( slice_int, slice_dbl ), overalloc );
+    checkSizeAndCapacity( gather, tag.num_send, tag.num_recv, overalloc );
+    gather.apply();
+    Cabana::deep_copy( data_host, data );
+    checkGatherSlice( tag, data_host, my_size, my_rank, num_local );
+
+    // The single buffer holds the bytes of both slices for each element.
+    EXPECT_EQ( gather.getSendBuffer().extent( 1 ),
+               sizeof( int ) + 2 * sizeof( double ) );
+
+    gather.shrinkToFit();
+    checkSizeAndCapacity( gather, tag.num_send, tag.num_recv, 1.0 );
+}
+
+//---------------------------------------------------------------------------//
+// Scatter test with segmented (atomic-free) sum reduction.
+template <class TestTag>
+void testHaloScatterSegmented( TestTag tag, const bool use_topology )
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Make a communication plan.
+    int num_local = tag.num_local;
+    auto halo = createHalo( tag, use_topology, my_size, num_local );
+
+    // Create particle data.
+    HaloData halo_data( *halo );
+    auto data = halo_data.createData( my_rank, num_local );
+
+    // Gather by AoSoA.
+    Cabana::gather( *halo, data );
+
+    // Scatter back the results without atomics.
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    auto scatter_int = createScatter( *halo, slice_int );
+    scatter_int.apply( Cabana::ScatterReduce::Sum(),
+                       Cabana::ScatterSegmented() );
+    Cabana::scatter( *halo, slice_dbl, Cabana::ScatterReduce::Sum(),
+                     Cabana::ScatterSegmented() );
+    auto data_host = halo_data.copyToHost();
+    checkScatter( tag, data_host, my_size, my_rank, num_local );
+}
+
+// Ghost value assigned on each rank before a min/max scatter such that the
+// ghost contributions always win the reduction.
+int scatterReduceValue( Cabana::ScatterReduce::Min, const int rank )
+{
+    return -( rank + 1 );
+}
+
+int scatterReduceValue( Cabana::ScatterReduce::Max, const int rank )
+{
+    return 1000 + rank;
+}
+
+int scatterReduceValue( Cabana::ScatterReduce::Replace, const int rank )
+{
+    return 500 + rank;
+}
+
+template <class ReduceOp, class AoSoAType>
+void checkScatterReduce( UniqueTestTag, ReduceOp reduce_op,
+                         AoSoAType data_host, const int my_size,
+                         const int my_rank )
+{
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+
+    // Elements that were not ghosted are unchanged while every ghosted
+    // element was replaced by the value from the rank that ghosted it.
+    for ( int i = 0; i < my_size; ++i )
+    {
+        EXPECT_EQ( slice_int_host( 2 * i ), my_rank + 1 );
+        EXPECT_DOUBLE_EQ( slice_dbl_host( 2 * i, 0 ), my_rank + 1 );
+        EXPECT_DOUBLE_EQ( slice_dbl_host( 2 * i, 1 ), my_rank + 1.5 );
+
+        int value = scatterReduceValue( reduce_op, i );
+        EXPECT_EQ( slice_int_host( 2 * i + 1 ), value );
+        EXPECT_DOUBLE_EQ( slice_dbl_host( 2 * i + 1, 0 ), value );
+        EXPECT_DOUBLE_EQ( slice_dbl_host( 2 * i + 1, 1 ), value );
+    }
+}
+
+template <class ReduceOp, class AoSoAType>
+void checkScatterReduce( AllTestTag, ReduceOp reduce_op, AoSoAType data_host,
+                         const int my_size, const int )
+{
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+
+    // Every rank ghosted the single element so the last rank wins.
+    int value = scatterReduceValue( reduce_op, my_size - 1 );
+    EXPECT_EQ( slice_int_host( 0 ), value );
+    EXPECT_DOUBLE_EQ( slice_dbl_host( 0, 0 ), value );
+    EXPECT_DOUBLE_EQ( slice_dbl_host( 0, 1 ), value );
+}
+
+template <class AoSoAType>
+void checkScatterReduce( AllTestTag, Cabana::ScatterReduce::Replace reduce_op,
+                         AoSoAType data_host, const int my_size, const int )
+{
+    auto slice_int_host = Cabana::slice<0>( data_host );
+    auto slice_dbl_host = Cabana::slice<1>( data_host );
+
+    // Every rank ghosted the single element so the value must have come from
+    // one of the ghosts but which one is undetermined.
+    int min_value = scatterReduceValue( reduce_op, 0 );
+    int max_value = scatterReduceValue( reduce_op, my_size - 1 );
+    EXPECT_GE( slice_int_host( 0 ), min_value );
+    EXPECT_LE( slice_int_host( 0 ), max_value );
+    for ( int d = 0; d < 2; ++d )
+    {
+        double value = slice_dbl_host( 0, d );
+        EXPECT_GE( value, min_value );
+        EXPECT_LE( value, max_value );
+        EXPECT_DOUBLE_EQ( value, static_cast<int>( value ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Scatter test with min/max/replace reductions.
+template <class TestTag, class ReduceOp, class AlgorithmTag>
+void testHaloScatterReduce( TestTag tag, const bool use_topology,
+                            ReduceOp reduce_op, AlgorithmTag algorithm_tag )
+{
+    // Get my rank.
+    int my_rank = -1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &my_rank );
+
+    // Get my size.
+    int my_size = -1;
+    MPI_Comm_size( MPI_COMM_WORLD, &my_size );
+
+    // Make a communication plan.
+    int num_local = tag.num_local;
+    auto halo = createHalo( tag, use_topology, my_size, num_local );
+
+    // Create particle data.
+    HaloData halo_data( *halo );
+    auto data = halo_data.createData( my_rank, num_local );
+
+    // Gather by AoSoA.
+    Cabana::gather( *halo, data );
+
+    // Assign a rank-dependent value to the ghosts.
+    auto slice_int = Cabana::slice<0>( data );
+    auto slice_dbl = Cabana::slice<1>( data );
+    int ghost_value = scatterReduceValue( reduce_op, my_rank );
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<TEST_EXECSPACE>( num_local, num_local + my_size ),
+        KOKKOS_LAMBDA( const int i ) {
+            slice_int( i ) = ghost_value;
+            slice_dbl( i, 0 ) = ghost_value;
+            slice_dbl( i, 1 ) = ghost_value;
+        } );
+    Kokkos::fence();
+
+    // Scatter back the results.
+    auto scatter_int = createScatter( *halo, slice_int );
+    scatter_int.apply( reduce_op, algorithm_tag );
+    Cabana::scatter( *halo, slice_dbl, reduce_op, algorithm_tag );
+    auto data_host = halo_data.copyToHost();
+    checkScatterReduce( tag, reduce_op, data_host, my_size, my_rank );
+}
+
+template <class TestTag>
+void testHaloScatterReduce( TestTag tag, const bool use_topology )
+{
+    testHaloScatterSegmented( tag, use_topology );
+    testHaloScatterReduce( tag, use_topology, Cabana::ScatterReduce::Min(),
+                           Cabana::ScatterAtomic() );
+    testHaloScatterReduce( tag, use_topology, Cabana::ScatterReduce::Max(),
+                           Cabana::ScatterAtomic() );
+    testHaloScatterReduce( tag, use_topology, Cabana::ScatterReduce::Min(),
+                           Cabana::ScatterSegmented() );
+    testHaloScatterReduce( tag, use_topology, Cabana::ScatterReduce::Max(),
+                           Cabana::ScatterSegmented() );
+    testHaloScatterReduce( tag, use_topology,
+                           Cabana::ScatterReduce::Replace(),
+                           Cabana::ScatterAtomic() );
+    testHaloScatterReduce( tag, use_topology,
+                           Cabana::ScatterReduce::Replace(),
+                           Cabana::ScatterSegmented() );
+}
+
 //---------------------------------------------------------------------------//
 // RUN TESTS
 //---------------------------------------------------------------------------//
@@ -590,12 +823,16 @@ TEST( TEST_CATEGORY, halo_test_unique )
 {
     testHalo( UniqueTestTag{}, true );
     testHaloBuffers( UniqueTestTag{}, true );
+    testHaloMultiSlice( UniqueTestTag{}, true );
+    testHaloScatterReduce( UniqueTestTag{}, true );
 }
 
 TEST( TEST_CATEGORY, halo_test_unique_no_topo )
 {
     testHalo( UniqueTestTag{}, false );
     testHaloBuffers( UniqueTestTag{}, false );
+    testHaloMultiSlice( UniqueTestTag{}, false );
+    testHaloScatterReduce( UniqueTestTag{}, false );
 }
 
 // tests with collisions (each ghost is duplicated on all ranks)
@@ -603,12 +840,16 @@ TEST( TEST_CATEGORY, halo_test_all )
 {
     testHalo( AllTestTag{}, true );
     testHaloBuffers( AllTestTag{}, false );
+    testHaloMultiSlice( AllTestTag{}, true );
+    testHaloScatterReduce( AllTestTag{}, true );
 }
 
 TEST( TEST_CATEGORY, halo_test_all_no_topo )
 {
     testHalo( AllTestTag{}, false );
     testHaloBuffers( AllTestTag{}, false );
+    testHaloMultiSlice( AllTestTag{}, false );
+    testHaloScatterReduce( AllTestTag{}, false );
 }
 
 //---------------------------------------------------------------------------//
@@ -49,6 +49,38 @@ void captureTest()
     EXPECT_EQ( int_host( 0, 0 ), 12 );
 }
 
+//---------------------------------------------------------------------------//
+struct NoDefaultFunctor
+{
+    Kokkos::View<double[1], TEST_MEMSPACE> _view;
+    double _value;
+
+    NoDefaultFunctor( const Kokkos::View<double[1], TEST_MEMSPACE>& view,
+                      const double value )
+        : _view( view )
+        , _value( value )
+    {
+    }
+
+    KOKKOS_INLINE_FUNCTION void operator()() const { _view( 0 ) = _value; }
+};
+
+void noDefaultTest()
+{
+    Kokkos::View<double[1], TEST_MEMSPACE> dbl_view( "dbl_view" );
+
+    // Types without a default constructor can be packed.
+    auto pack = Cabana::makeParameterPack( NoDefaultFunctor( dbl_view, 2.5 ) );
+
+    Kokkos::parallel_for(
+        "apply_pack", Kokkos::RangePolicy<TEST_EXECSPACE>( 0, 1 ),
+        KOKKOS_LAMBDA( const int ) { Cabana::get<0>( pack )(); } );
+
+    auto dbl_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), dbl_view );
+    EXPECT_DOUBLE_EQ( dbl_host( 0 ), 2.5 );
+}
+
 //---------------------------------------------------------------------------//
 void emptyTest() { std::ignore = Cabana::makeParameterPack(); }
 
@@ -57,6 +89,8 @@ void emptyTest() { std::ignore = Cabana::makeParameterPack(); }
 //---------------------------------------------------------------------------//
 TEST( TEST_CATEGORY, parameter_pack_capture ) { captureTest(); }
 
+TEST( TEST_CATEGORY, parameter_pack_no_default ) { noDefaultTest(); }
+
 TEST( TEST_CATEGORY, parameter_pack_empty ) { emptyTest(); }
 
 //---------------------------------------------------------------------------//